@@ -23,11 +23,14 @@
 #ifndef _TS_Command_ReloadConfiguration_
 #define _TS_Command_ReloadConfiguration_
 
+#include <algorithm>
+
 #include <spdlog/spdlog.h>
 
 #include <cRIO/Task.h>
 
 #include "Settings/Controller.h"
+#include "Tasks/Controller.h"
 
 namespace LSST {
 namespace M1M3 {
@@ -38,7 +41,14 @@ class ReloadConfiguration : public cRIO::Task {
 public:
     cRIO::task_return_t run() override {
         SPDLOG_INFO("Reloading configuration.");
-        Settings::Controller::instance().load("");
+        try {
+            auto changed = Settings::Controller::instance().reload();
+            if (std::find(changed.begin(), changed.end(), "MixingValve") != changed.end()) {
+                Tasks::Controller::instance().update_mixing_valve_PID();
+            }
+        } catch (std::runtime_error &er) {
+            SPDLOG_ERROR("Cannot reload configuration: {}", er.what());
+        }
         return Task::DONT_RESCHEDULE;
     }
 };
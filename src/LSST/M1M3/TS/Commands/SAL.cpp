@@ -20,6 +20,8 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <future>
+
 #include <spdlog/spdlog.h>
 
 #include <IFPGA.h>
@@ -33,8 +35,11 @@
 #include "Events/FcuTargets.h"
 #include "Events/SummaryState.h"
 #include "Events/ThermalInfo.h"
+#include "LatencyProbe.h"
 #include "MPU/FlowMeter.h"
+#include "PhaseTimer.h"
 #include "Settings/Controller.h"
+#include "Settings/FcuIdentityCache.h"
 #include "Settings/GlycolPump.h"
 #include "Settings/FlowMeter.h"
 #include "Settings/Setpoint.h"
@@ -49,19 +54,64 @@ using namespace LSST::M1M3::TS;
 using namespace LSST::M1M3::TS::Commands;
 using namespace MTM1M3TS;
 
-void changeAllILCsMode(uint16_t mode) {
+/**
+ * Communicates with FCU's ILCs on start - changes their mode to disabled and
+ * reads their ServerIDs (or only status for ILCs with cached identity). Runs
+ * in parallel with the EGW pump power up.
+ */
+static void start_ILCs(std::shared_ptr<PhaseTimer> timer) {
+    PhaseTimer::Phase phase(*timer, "FCU ILCs");
+
+    auto ilc_lock = TSApplication::lock_ilc();
+
+    TSApplication::instance().changeAllILCsMode({ILC::Mode::Disabled});
+
     TSApplication::ilc()->clear();
-    TSApplication::instance().callFunctionOnAllIlcs(
-            [mode](uint8_t address) -> void { TSApplication::ilc()->changeILCMode(address, mode); });
+    TSApplication::instance().callFunctionOnAllIlcs([](uint8_t address) -> void {
+        LSST::M1M3::TS::Settings::FcuIdentityCache::instance().request_identity(
+                *TSApplication::ilc(), address, ILC::Mode::Disabled);
+    });
+
+    IFPGA::get().ilcCommands(*TSApplication::ilc(), 1000);
+
+    LSST::M1M3::TS::Settings::FcuIdentityCache::instance().apply();
 
+    Events::ThermalInfo::instance().log();
+    Events::FcuTargets::instance().send();
+}
+
+/**
+ * Finish start transition - called after EGW pump was powered up.
+ */
+static void start_finished(SAL_start *command, std::shared_ptr<PhaseTimer> timer,
+                           std::shared_future<void> ilcs) {
     try {
-        IFPGA::get().ilcCommands(*TSApplication::ilc(), 1000);
+        ilcs.get();
     } catch (std::exception &ex) {
-        SPDLOG_WARN(ex.what());
+        command->ackFailed(fmt::format("Cannot communicate with FCU's ILCs on startup: {}", ex.what()));
     }
+
+    Events::SummaryState::set_state(MTM1M3TS_shared_SummaryStates_DisabledState);
+    Events::EngineeringMode::instance().set_enabled(false);
+    Events::EngineeringMode::instance().send();
+
+    {
+        PhaseTimer::Phase phase(*timer, "saved setpoints");
+        LSST::M1M3::TS::Settings::Setpoint::instance().apply_saved_setpoints();
+    }
+
+    Events::AppliedSetpoints::instance().send();
+
+    command->ackComplete();
+    SPDLOG_INFO("Started");
+    timer->report();
 }
 
 bool SAL_start::validate() {
+    if (Tasks::Controller::instance().coolant_pump_power_up_pending()) {
+        ackFailed("EGW pump power up is in progress, cannot start. Use exitControl to cancel it.");
+        return false;
+    }
     if (params.configurationOverride.empty()) {
         params.configurationOverride = "Default";
     }
@@ -74,56 +124,71 @@ bool SAL_start::validate() {
 
 void SAL_start::execute() {
     SPDLOG_INFO("Starting, settings={}", params.configurationOverride);
-    Settings::Controller::instance().load(params.configurationOverride);
+    auto timer = std::make_shared<PhaseTimer>("Start");
+
+    {
+        PhaseTimer::Phase phase(*timer, "settings");
+        Settings::Controller::instance().load(params.configurationOverride);
+    }
 
     Events::ErrorCode::instance().clear("CSC started");
 
     Telemetry::FinerControl::instance().set_target(0);
     IFPGA::get().setMixingValvePosition(0);
 
-    try {
-        changeAllILCsMode(ILC::Mode::Disabled);
-
-        TSApplication::ilc()->clear();
-        TSApplication::instance().callFunctionOnAllIlcs(
-                [](uint8_t address) -> void { TSApplication::ilc()->reportServerID(address); });
-
-        IFPGA::get().ilcCommands(*TSApplication::ilc(), 1000);
-
-        Events::ThermalInfo::instance().log();
-        Events::FcuTargets::instance().send();
-    } catch (std::exception &ex) {
-        ackFailed(fmt::format("Cannot communicate with FCU's ILCs on startup: {}", ex.what()));
+    // reused FPGA bitfile is verified before the pump can be powered up, as a reset switches it off
+    {
+        PhaseTimer::Phase phase(*timer, "FPGA bus");
+        auto ilc_lock = TSApplication::lock_ilc();
+        IFPGA::get().verify_reused([]() {
+            TSApplication::ilc()->clear();
+            TSApplication::instance().callFunctionOnAllIlcs(
+                    [](uint8_t address) -> void { TSApplication::ilc()->reportServerStatus(address); });
+            IFPGA::get().ilcCommands(*TSApplication::ilc(), 1000);
+        });
     }
 
+    // ILCs communication is independent of the serial devices and the pump
+    std::shared_future<void> ilcs = std::async(std::launch::async, start_ILCs, timer).share();
+
     if (Settings::FlowMeter::instance().enabled) {
+        PhaseTimer::Phase phase(*timer, "flow meter");
         TSPublisher::instance().startFlowMeterThread();
     } else {
         SPDLOG_WARN("Skipping flow meter telemetry - the flow meter wasn't enabled in the M1M3TS config.");
     }
 
-    if (Settings::GlycolPump::instance().enabled) {
-        IFPGA::get().setCoolantPumpPower(true);
-        SPDLOG_INFO("Glycol pump turned on.");
-        TSPublisher::instance().startPumpThread();
-    } else {
+    if (Settings::GlycolPump::instance().enabled == false) {
         SPDLOG_WARN("Not starting glycol pump - the glycol pump wasn't enabled in M1M3TS config.");
+        start_finished(this, timer, ilcs);
+        return;
     }
 
-    Events::SummaryState::set_state(MTM1M3TS_shared_SummaryStates_DisabledState);
-    Events::EngineeringMode::instance().set_enabled(false);
-    Events::EngineeringMode::instance().send();
-
-    Settings::Setpoint::instance().apply_saved_setpoints();
-
-    Events::AppliedSetpoints::instance().send();
-
-    ackComplete();
-    SPDLOG_INFO("Started");
+    // finish start transition once the pump is powered - this might take up
+    // to GlycolPump.CommunicationRecoverPowerOff seconds
+    auto command = std::make_shared<SAL_start>(*this);
+    timer->start("EGW pump power up");
+    try {
+        double timeout = Tasks::Controller::instance().power_up_coolant_pump(
+                std::chrono::milliseconds(0),
+                [command, timer, ilcs]() {
+                    timer->stop("EGW pump power up");
+                    start_finished(command.get(), timer, ilcs);
+                },
+                [command, timer, ilcs](const std::string &reason) {
+                    ilcs.wait();
+                    command->ackFailed(fmt::format("Cannot power up EGW pump: {}", reason));
+                    timer->report();
+                });
+        ackInProgress("Waiting for EGW pump power up", timeout + 1);
+    } catch (std::exception &ex) {
+        ilcs.wait();
+        ackFailed(ex.what());
+    }
 }
 
 void SAL_enable::execute() {
-    changeAllILCsMode(ILC::Mode::Enabled);
+    TSApplication::instance().changeAllILCsMode({ILC::Mode::Enabled});
     IFPGA::get().setFCUPower(true);
 
     if (Settings::GlycolPump::instance().enabled) {
@@ -140,6 +205,14 @@ void SAL_enable::execute() {
                     glycol, heaters, target_temp);
         applied_setpoints.set_applied_setpoints(glycol, heaters);
         applied_setpoints.send();
+    } else {
+        auto checkpoint = Settings::Setpoint::instance().apply_checkpoint();
+        if (checkpoint != nullptr) {
+            // warm restart - bumplessly resume control loops from the checkpointed state
+            Tasks::Controller::instance().set_setpoints(applied_setpoints.get_applied_glycol_setpoint(),
+                                                        applied_setpoints.get_applied_heaters_setpoint(),
+                                                        checkpoint);
+        }
     }
 
     Events::SummaryState::set_state(MTM1M3TS_shared_SummaryStates_EnabledState);
@@ -159,7 +232,7 @@ void SAL_disable::execute() {
                 er.what());
     }
 
-    changeAllILCsMode(ILC::Mode::Disabled);
+    TSApplication::instance().changeAllILCsMode({ILC::Mode::Disabled});
 
     try {
         IFPGA::get().setMixingValvePosition(0);
@@ -177,12 +250,12 @@ void SAL_disable::execute() {
 }
 
 void SAL_standby::execute() {
+    Tasks::Controller::instance().cancel_coolant_pump_power_up();
     TSPublisher::instance().stopFlowMeterThread();
     TSPublisher::instance().stopPumpThread();
     IFPGA::get().setCoolantPumpPower(false);
 
-    changeAllILCsMode(ILC::Mode::ClearFaults);
-    changeAllILCsMode(ILC::Mode::Standby);
+    TSApplication::instance().changeAllILCsMode({ILC::Mode::ClearFaults, ILC::Mode::Standby});
 
     Events::SummaryState::set_state(MTM1M3TS_shared_SummaryStates_StandbyState);
     ackComplete();
@@ -190,6 +263,8 @@ void SAL_standby::execute() {
 }
 
 void SAL_exitControl::execute() {
+    // start can be waiting for the pump power up in standby state
+    Tasks::Controller::instance().cancel_coolant_pump_power_up();
     LSST::cRIO::ControllerThread::setExitRequested();
     ackComplete();
 }
@@ -230,6 +305,7 @@ bool SAL_heaterFanDemand::validate() {
 }
 
 void SAL_heaterFanDemand::execute() {
+    LatencyProbe::Scope trace(getCommandID());
     try {
         Events::FcuTargets::instance().set_FCU_heaters_fans(params.heaterPWM, params.fanRPM);
         ackComplete();
@@ -253,6 +329,7 @@ bool SAL_setMixingValve::validate() {
 }
 
 void SAL_setMixingValve::execute() {
+    LatencyProbe::Scope trace(getCommandID());
     Telemetry::FinerControl::instance().set_target(params.mixingValveTarget);
     ackComplete();
     SPDLOG_INFO("Changed mixing valve to {:0.01f}%", params.mixingValveTarget);
@@ -261,15 +338,28 @@ void SAL_setMixingValve::execute() {
 bool SAL_coolantPumpPower::validate() { return Events::EngineeringMode::instance().is_enabled(); }
 
 void SAL_coolantPumpPower::execute() {
-    IFPGA::get().setCoolantPumpPower(params.power);
     if (params.power) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(5000));
-        TSPublisher::instance().startPumpThread();
-    } else {
-        TSPublisher::instance().stopPumpThread();
+        auto command = std::make_shared<SAL_coolantPumpPower>(*this);
+        try {
+            double timeout = Tasks::Controller::instance().power_up_coolant_pump(
+                    std::chrono::milliseconds(5000),
+                    [command]() {
+                        command->ackComplete();
+                        SPDLOG_INFO("Glycol coolant pump powered on");
+                    },
+                    [command](const std::string &reason) { command->ackFailed(reason); });
+            ackInProgress("Waiting for EGW pump power up", timeout + 1);
+        } catch (std::exception &ex) {
+            ackFailed(ex.what());
+        }
+        return;
     }
+
+    Tasks::Controller::instance().cancel_coolant_pump_power_up();
+    TSPublisher::instance().stopPumpThread();
+    IFPGA::get().setCoolantPumpPower(false);
     ackComplete();
-    SPDLOG_INFO("Glycol coolant pump powered {}", params.power ? "on" : "off");
+    SPDLOG_INFO("Glycol coolant pump powered off");
 }
 
 bool SAL_coolantPumpStart::validate() {
@@ -358,5 +448,6 @@ bool SAL_applySetpoints::validate() {
 }
 
 void SAL_applySetpoints::execute() {
+    LatencyProbe::Scope trace(getCommandID());
     Tasks::Controller::instance().set_setpoints(params.glycolSetpoint, params.heatersSetpoint);
 }
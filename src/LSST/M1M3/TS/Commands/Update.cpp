@@ -33,8 +33,10 @@
 #include "Events/ThermalInfo.h"
 #include "Events/ThermalWarning.h"
 
+#include "Settings/FcuIdentityCache.h"
 #include "Settings/Heaters.h"
 
+#include "Telemetry/DataAge.h"
 #include "Telemetry/MixingValve.h"
 #include "Telemetry/ThermalData.h"
 
@@ -55,6 +57,8 @@ LSST::cRIO::task_return_t Update::run() {
     Events::EnabledILC::instance().send();
     Events::ThermalWarning::instance().send();
 
+    Telemetry::DataAge::instance().report();
+
     SPDLOG_TRACE("Commands::Update leaving execute");
 
     return Task::DONT_RESCHEDULE;
@@ -74,6 +78,7 @@ void Update::_sendMixingValve() {
     }
 
     try {
+        auto ilc_lock = TSApplication::lock_ilc();
         Telemetry::MixingValve::instance().sendPosition(IFPGA::get().getMixingValvePosition());
 
     } catch (std::exception &e) {
@@ -83,7 +88,7 @@ void Update::_sendMixingValve() {
 
 void Update::_sendFCU() {
     /// State of the state machine handling bus recovery from power failure
-    static enum { OK, FAILED, RESET_ERROR, STANDBY, SERVER_ID, DISABLED, ENABLED } _bus_state = OK;
+    static enum { OK, FAILED, STANDBY, SERVER_ID, ENABLED } _bus_state = OK;
 
     static auto next_update = std::chrono::steady_clock::now() - 20ms;
 
@@ -99,11 +104,15 @@ void Update::_sendFCU() {
         next_update += default_period;
     }
 
+    auto ilc_lock = TSApplication::lock_ilc();
+
     try {
         Events::ThermalInfo::instance().reset();
         Telemetry::ThermalData::instance().reset();
         app.ilc()->clear();
 
+        bool sequenced = false;
+
         switch (_bus_state) {
             case OK:
                 if (Events::SummaryState::instance().active()) {
@@ -113,24 +122,17 @@ void Update::_sendFCU() {
                 app.callFunctionOnAllIlcs([&app](int address) { app.ilc()->reportServerStatus(address); });
                 break;
             case FAILED:
-                app.callFunctionOnAllIlcs([&app](uint8_t address) {
-                    app.ilc()->changeILCMode(address, ILC::Mode::ClearFaults);
-                });
-                break;
-            case RESET_ERROR:
-                app.callFunctionOnAllIlcs(
-                        [&app](uint8_t address) { app.ilc()->changeILCMode(address, ILC::Mode::Standby); });
+                // no retries - recovery shall not block the bus, it is repeated on the next cycle
+                sequenced = app.changeAllILCsMode({ILC::Mode::ClearFaults, ILC::Mode::Standby}, 800, 0);
                 break;
             case STANDBY:
-                app.callFunctionOnAllIlcs([&app](uint8_t address) { app.ilc()->reportServerID(address); });
+                app.callFunctionOnAllIlcs([&app](uint8_t address) {
+                    Settings::FcuIdentityCache::instance().request_identity(*app.ilc(), address,
+                                                                            ILC::Mode::Standby);
+                });
                 break;
             case SERVER_ID:
-                app.callFunctionOnAllIlcs(
-                        [&app](uint8_t address) { app.ilc()->changeILCMode(address, ILC::Mode::Disabled); });
-                break;
-            case DISABLED:
-                app.callFunctionOnAllIlcs(
-                        [&app](uint8_t address) { app.ilc()->changeILCMode(address, ILC::Mode::Enabled); });
+                sequenced = app.changeAllILCsMode({ILC::Mode::Disabled, ILC::Mode::Enabled}, 800, 0);
                 break;
             case ENABLED:
                 app.callFunctionOnAllIlcs(
@@ -142,7 +144,10 @@ void Update::_sendFCU() {
                 break;
         }
 
-        IFPGA::get().ilcCommands(*app.ilc(), 800);
+        // mode sequences run their own bus transactions
+        if (_bus_state != FAILED && _bus_state != SERVER_ID) {
+            IFPGA::get().ilcCommands(*app.ilc(), 800);
+        }
 
         auto _old_state = _bus_state;
 
@@ -153,21 +158,20 @@ void Update::_sendFCU() {
                 }
                 break;
             case FAILED:
-                _bus_state = RESET_ERROR;
-                Settings::Heaters::instance().reset_FCU_PIDs();
-                break;
-            case RESET_ERROR:
-                _bus_state = STANDBY;
+                if (sequenced) {
+                    _bus_state = STANDBY;
+                    Settings::Heaters::instance().reset_FCU_PIDs();
+                }
                 break;
             case STANDBY:
+                Settings::FcuIdentityCache::instance().apply();
                 Events::ThermalInfo::instance().log();
                 _bus_state = SERVER_ID;
                 break;
             case SERVER_ID:
-                _bus_state = DISABLED;
-                break;
-            case DISABLED:
-                _bus_state = ENABLED;
+                if (sequenced) {
+                    _bus_state = ENABLED;
+                }
                 break;
             case ENABLED:
                 _bus_state = OK;
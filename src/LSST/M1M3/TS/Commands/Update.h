@@ -43,8 +43,6 @@ public:
 private:
     void _sendMixingValve();
     void _sendFCU();
-
-    std::chrono::steady_clock::time_point _next_update;
 };
 
 }  // namespace Commands
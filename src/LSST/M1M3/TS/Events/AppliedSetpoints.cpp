@@ -31,12 +31,14 @@ using namespace LSST::M1M3::TS::Events;
 AppliedSetpoints::AppliedSetpoints(token) { reset(); }
 
 void AppliedSetpoints::reset() {
+    std::lock_guard<std::mutex> lg(_lock);
     glycolSetpoint = NAN;
     heatersSetpoint = NAN;
     _updated = true;
 }
 
 void AppliedSetpoints::send() {
+    std::lock_guard<std::mutex> lg(_lock);
     if (_updated == false) {
         return;
     }
@@ -48,10 +50,15 @@ void AppliedSetpoints::send() {
     _updated = false;
 }
 
-bool AppliedSetpoints::is_valid() { return !(isnan(glycolSetpoint) || isnan(heatersSetpoint)); }
+bool AppliedSetpoints::is_valid() {
+    std::lock_guard<std::mutex> lg(_lock);
+    return !(isnan(glycolSetpoint) || isnan(heatersSetpoint));
+}
 
 std::pair<bool, bool> AppliedSetpoints::set_applied_setpoints(float new_glycol_setpoint,
                                                               float new_heaters_setpoint) {
+    std::lock_guard<std::mutex> lg(_lock);
+
     std::pair<bool, bool> ret(false, false);
 
     const auto &mixing_settings = Settings::MixingValve::instance();
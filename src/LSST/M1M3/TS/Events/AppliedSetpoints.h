@@ -23,6 +23,8 @@
 #ifndef _TS_Event_AppliedSetpoints_
 #define _TS_Event_AppliedSetpoints_
 
+#include <mutex>
+
 #include <SAL_MTM1M3TS.h>
 #include <cRIO/Singleton.h>
 
@@ -56,11 +58,19 @@ public:
      */
     std::pair<bool, bool> set_applied_setpoints(float new_glycol_setpoint, float new_heaters_setpoint);
 
-    float get_applied_glycol_setpoint() { return glycolSetpoint; }
+    float get_applied_glycol_setpoint() {
+        std::lock_guard<std::mutex> lg(_lock);
+        return glycolSetpoint;
+    }
 
-    float get_applied_heaters_setpoint() { return heatersSetpoint; }
+    float get_applied_heaters_setpoint() {
+        std::lock_guard<std::mutex> lg(_lock);
+        return heatersSetpoint;
+    }
 
 private:
+    // setpoints are set from the controller thread and glycol temperature (MPU) thread
+    std::mutex _lock;
     bool _updated;
 };
 
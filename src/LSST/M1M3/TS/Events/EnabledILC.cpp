@@ -34,6 +34,7 @@ using namespace LSST::M1M3::TS::Events;
 EnabledILC::EnabledILC(token) : _updated(true) { reset(); }
 
 void EnabledILC::reset() {
+    std::lock_guard<std::mutex> lg(_lock);
     for (size_t i = 0; i < cRIO::NUM_TS_ILC; i++) {
         enabled[i] = true;
         autoDisabled[i] = false;
@@ -43,26 +44,29 @@ void EnabledILC::reset() {
 }
 
 void EnabledILC::setEnabled(uint8_t ilc, bool newState) {
-    if (newState != enabled[ilc]) {
-        _updated = true;
-        enabled[ilc] = newState;
-    }
+    std::lock_guard<std::mutex> lg(_lock);
+    _set_enabled(ilc, newState);
 }
 
-bool EnabledILC::isEnabled(uint8_t ilc) { return enabled[ilc]; }
+bool EnabledILC::isEnabled(uint8_t ilc) {
+    std::lock_guard<std::mutex> lg(_lock);
+    return enabled[ilc];
+}
 
 void EnabledILC::communicationProblem(uint8_t ilc) {
+    std::lock_guard<std::mutex> lg(_lock);
     errorCount[ilc]++;
     if (Settings::Thermal::instance().autoDisable) {
         if (errorCount[ilc] > Settings::Thermal::instance().failuresToDisable) {
             autoDisabled[ilc] = true;
-            setEnabled(ilc, false);
+            _set_enabled(ilc, false);
         }
     }
     _updated = true;
 }
 
 void EnabledILC::send() {
+    std::lock_guard<std::mutex> lg(_lock);
     if (_updated == false) {
         return;
     }
@@ -73,3 +77,10 @@ void EnabledILC::send() {
     }
     _updated = false;
 }
+
+void EnabledILC::_set_enabled(uint8_t ilc, bool newState) {
+    if (newState != enabled[ilc]) {
+        _updated = true;
+        enabled[ilc] = newState;
+    }
+}
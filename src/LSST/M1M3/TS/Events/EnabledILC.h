@@ -23,6 +23,8 @@
 #ifndef _TS_Event_EnabledILCILC_
 #define _TS_Event_EnabledILCILC_
 
+#include <mutex>
+
 #include <SAL_MTM1M3TS.h>
 
 #include <cRIO/Singleton.h>
@@ -65,7 +67,11 @@ public:
     bool autoDisabled[LSST::cRIO::NUM_TS_ILC];
 
 private:
+    // protects enabled, error counts and updated flag - the ILC bus can be used from MPU threads
+    std::mutex _lock;
     bool _updated;
+
+    void _set_enabled(uint8_t ilc, bool newState);
 };
 
 }  // namespace Events
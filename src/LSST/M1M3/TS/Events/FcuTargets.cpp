@@ -28,6 +28,8 @@
 
 #include "Events/FcuTargets.h"
 #include "IFPGA.h"
+#include "LatencyProbe.h"
+#include "LiveState.h"
 #include "TSApplication.h"
 #include "TSPublisher.h"
 
@@ -42,6 +44,7 @@ FcuTargets::FcuTargets(token) {
 }
 
 void FcuTargets::send() {
+    auto ilc_lock = TSApplication::lock_ilc();
     if (_updated == false) {
         return;
     }
@@ -50,23 +53,42 @@ void FcuTargets::send() {
         SPDLOG_WARN("Cannot publish fcuTargets: {}", ret);
         return;
     }
+    LatencyProbe::instance().mark(LatencyProbe::PUBLISHED);
     _updated = false;
 }
 
-void FcuTargets::set_FCU_heaters_fans(std::vector<int> _heater_PWM, std::vector<int> _fan_RPM) {
+void FcuTargets::set_FCU_heaters_fans(const std::vector<int> &heater_PWM, const std::vector<int> &fan_RPM) {
+    if (heater_PWM.size() != cRIO::NUM_TS_ILC || fan_RPM.size() != cRIO::NUM_TS_ILC) {
+        throw std::runtime_error(fmt::format("Expected {} heaters and fans demands, received {} and {}.",
+                                             cRIO::NUM_TS_ILC, heater_PWM.size(), fan_RPM.size()));
+    }
+    set_FCU_heaters_fans(heater_PWM.data(), fan_RPM.data());
+}
+
+void FcuTargets::set_FCU_heaters_fans(const int heater_PWM[cRIO::NUM_TS_ILC],
+                                      const int fan_RPM[cRIO::NUM_TS_ILC]) {
     auto &app = TSApplication::instance();
+    auto ilc_lock = TSApplication::lock_ilc();
+
+    int heaters[cRIO::NUM_TS_ILC];
+    int fans[cRIO::NUM_TS_ILC];
+
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        heaters[i] = heater_PWM[i];
+        fans[i] = fan_RPM[i];
+    }
 
     app.ilc()->clear();
 
     app.callFunctionOnAllIlcs([&](uint8_t address) -> void {
         auto i = address - 1;
-        int heater = _heater_PWM[i];
+        int heater = heaters[i];
         if (heater < 0 || heater > 255) {
-            _heater_PWM[i] = heater = heaterPWM[i];
+            heaters[i] = heater = heaterPWM[i] * 255.0 / 100.0;
         }
-        int fan = _fan_RPM[i];
+        int fan = fans[i];
         if (fan < 0 || fan > 255) {
-            _fan_RPM[i] = fan = fanRPM[i];
+            fans[i] = fan = fanRPM[i] / 10;
         }
 
         TSApplication::ilc()->setThermalDemand(address, heater, fan);
@@ -74,35 +96,38 @@ void FcuTargets::set_FCU_heaters_fans(std::vector<int> _heater_PWM, std::vector<
 
     IFPGA::get().ilcCommands(*TSApplication::ilc(), 1000);
 
-    std::vector<float> target_heater_PWM(cRIO::NUM_TS_ILC);
-    std::vector<int> target_fan_RPM(cRIO::NUM_TS_ILC);
+    float target_heater_PWM[cRIO::NUM_TS_ILC];
+    int target_fan_RPM[cRIO::NUM_TS_ILC];
 
     // converts 0-255 values to human readable values
     for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
-        target_heater_PWM[i] = 100.0 * (_heater_PWM[i] / 255.0);
-        target_fan_RPM[i] = _fan_RPM[i] * 10;
+        target_heater_PWM[i] = 100.0 * (heaters[i] / 255.0);
+        target_fan_RPM[i] = fans[i] * 10;
     }
 
     _set_fcu_targets(target_heater_PWM, target_fan_RPM);
 
-    const auto [h_min, h_max] = std::minmax_element(begin(target_heater_PWM), end(target_heater_PWM));
-    const auto [f_min, f_max] = std::minmax_element(begin(target_fan_RPM), end(target_fan_RPM));
+    const auto [h_min, h_max] =
+            std::minmax_element(target_heater_PWM, target_heater_PWM + cRIO::NUM_TS_ILC);
+    const auto [f_min, f_max] = std::minmax_element(target_fan_RPM, target_fan_RPM + cRIO::NUM_TS_ILC);
 
     SPDLOG_DEBUG("Changed targets: heaters {:.1f} % to {:.1f} %, fans {:d} to {:d}.", *h_min, *h_max, *f_min,
                  *f_max);
 }
 
 void FcuTargets::recover() {
-    std::vector<int> heater(0, cRIO::NUM_TS_ILC);
-    std::vector<int> fan(0, cRIO::NUM_TS_ILC);
+    int heater[cRIO::NUM_TS_ILC];
+    int fan[cRIO::NUM_TS_ILC];
     for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        heater[i] = 0;
         fan[i] = fanRPM[i] / 10;
     }
 
     set_FCU_heaters_fans(heater, fan);
 }
 
-void FcuTargets::_set_fcu_targets(std::vector<float> new_heater_pwm, std::vector<int> new_fan_rpm) {
+void FcuTargets::_set_fcu_targets(const float new_heater_pwm[cRIO::NUM_TS_ILC],
+                                  const int new_fan_rpm[cRIO::NUM_TS_ILC]) {
     for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
         if (heaterPWM[i] != new_heater_pwm[i]) {
             heaterPWM[i] = new_heater_pwm[i];
@@ -113,5 +138,6 @@ void FcuTargets::_set_fcu_targets(std::vector<float> new_heater_pwm, std::vector
             _updated = true;
         }
     }
+    LiveState::instance().update(*this);
     send();
 }
@@ -23,8 +23,11 @@
 #ifndef _TS_Event_FcuTargets_
 #define _TS_Event_FcuTargets_
 
+#include <vector>
+
 #include <SAL_MTM1M3TS.h>
 #include <cRIO/Singleton.h>
+#include <cRIO/ThermalILC.h>
 
 namespace LSST {
 namespace M1M3 {
@@ -40,17 +43,42 @@ public:
      */
     void send();
 
-    void set_FCU_heaters_fans(std::vector<int> heater_PWM, std::vector<int> fan_RPM);
+    /**
+     * Sets FCU heaters and fans demands. Out of range (0-255) values are
+     * replaced with the current demand. Doesn't allocate memory.
+     *
+     * @param heater_PWM heaters PWM demand (0-255), NUM_TS_ILC values
+     * @param fan_RPM fans RPM demand (0-255, in 10 RPM), NUM_TS_ILC values
+     */
+    void set_FCU_heaters_fans(const int heater_PWM[cRIO::NUM_TS_ILC], const int fan_RPM[cRIO::NUM_TS_ILC]);
+
+    /**
+     * Sets FCU heaters and fans demands.
+     *
+     * @param heater_PWM heaters PWM demand (0-255)
+     * @param fan_RPM fans RPM demand (0-255, in 10 RPM)
+     *
+     * @throw std::runtime_error if vectors don't contain NUM_TS_ILC values
+     */
+    void set_FCU_heaters_fans(const std::vector<int> &heater_PWM, const std::vector<int> &fan_RPM);
 
     void recover();
 
-    auto get_heaterPWM() { return heaterPWM; }
-    auto get_fanRPM() { return fanRPM; }
+    /**
+     * Current heaters PWM targets. Caller must hold TSApplication::lock_ilc().
+     */
+    const auto &get_heaterPWM() const { return heaterPWM; }
+
+    /**
+     * Current fans RPM targets. Caller must hold TSApplication::lock_ilc().
+     */
+    const auto &get_fanRPM() const { return fanRPM; }
 
 private:
     bool _updated;
 
-    void _set_fcu_targets(std::vector<float> new_heater_pwm, std::vector<int> new_fan_rpm);
+    void _set_fcu_targets(const float new_heater_pwm[cRIO::NUM_TS_ILC],
+                          const int new_fan_rpm[cRIO::NUM_TS_ILC]);
 };
 
 }  // namespace Events
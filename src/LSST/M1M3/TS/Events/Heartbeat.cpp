@@ -22,6 +22,7 @@
 
 #include <Events/Heartbeat.h>
 #include <IFPGA.h>
+#include <PublishQueue.h>
 #include <TSPublisher.h>
 #include <cRIO/ThermalILC.h>
 
@@ -44,11 +45,7 @@ void Heartbeat::tryToggle() {
 
     IFPGA::get().setHeartbeat(heartbeat);
 
-    salReturn ret = TSPublisher::SAL()->putSample_logevent_heartbeat(this);
-    if (ret != SAL__OK) {
-        SPDLOG_WARN("Cannot send heartbeat: {}", ret);
-        return;
-    }
+    PublishQueue::instance().enqueue<MTM1M3TS_logevent_heartbeatC>(*this);
 
     _nextUpdate = now + HEARTBEAT_PERIOD;
 }
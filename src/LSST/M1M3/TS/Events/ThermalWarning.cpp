@@ -20,8 +20,6 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <algorithm>
-
 #include <cRIO/ThermalILC.h>
 #include <ILC/ILCBusList.h>
 
@@ -30,83 +28,87 @@
 
 using namespace LSST::M1M3::TS::Events;
 
-ThermalWarning::ThermalWarning(token) {
-    anyMajorFault = false;
-    anyMinorFault = false;
-    anyFaultOverride = false;
-    anyRefResistorError = false;
-    anyRTDError = false;
-    anyBreakerHeater1Error = false;
-    anyBreakerFan2Error = false;
+typedef std::vector<bool> MTM1M3TS_logevent_thermalWarningC::*values_t;
+typedef bool MTM1M3TS_logevent_thermalWarningC::*any_t;
+
+/**
+ * SAL fields of the flags, in ThermalWarning::Flag order.
+ */
+static const struct {
+    values_t values;
+    any_t any;
+} flag_fields[ThermalWarning::FLAGS] = {
+        {&ThermalWarning::majorFault, &ThermalWarning::anyMajorFault},
+        {&ThermalWarning::minorFault, &ThermalWarning::anyMinorFault},
+        {&ThermalWarning::faultOverride, &ThermalWarning::anyFaultOverride},
+        {&ThermalWarning::refResistorError, &ThermalWarning::anyRefResistorError},
+        {&ThermalWarning::rtdError, &ThermalWarning::anyRTDError},
+        {&ThermalWarning::breakerHeater1Error, &ThermalWarning::anyBreakerHeater1Error},
+        {&ThermalWarning::breakerFan2Error, &ThermalWarning::anyBreakerFan2Error},
+        {&ThermalWarning::uniqueIdCRCError, &ThermalWarning::anyUniqueIdCRCError},
+        {&ThermalWarning::applicationTypeMismatch, &ThermalWarning::anyApplicationTypeMismatch},
+        {&ThermalWarning::applicationCRCMismatch, &ThermalWarning::anyApplicationCRCMismatch},
+        {&ThermalWarning::oneWireMissing, &ThermalWarning::anyOneWireMissing},
+        {&ThermalWarning::oneWire1Mismatch, &ThermalWarning::anyOneWire1Mismatch},
+        {&ThermalWarning::oneWire2Mismatch, &ThermalWarning::anyOneWire2Mismatch},
+        {&ThermalWarning::watchdogReset, &ThermalWarning::anyWatchdogReset},
+        {&ThermalWarning::brownOut, &ThermalWarning::anyBrownOut},
+        {&ThermalWarning::eventTrapReset, &ThermalWarning::anyEventTrapReset},
+        {&ThermalWarning::ssrPowerFault, &ThermalWarning::anySSRPowerFault},
+        {&ThermalWarning::auxPowerFault, &ThermalWarning::anyAuxPowerFault},
+};
+
+static_assert(LSST::cRIO::NUM_TS_ILC <= 128, "FlagMask supports up to 128 FCUs");
 
-    anyUniqueIdCRCError = false;
-    anyApplicationTypeMismatch = false;
-    anyApplicationCRCMismatch = false;
-    anyOneWireMissing = false;
-    anyOneWire1Mismatch = false;
-    anyOneWire2Mismatch = false;
-    anyWatchdogReset = false;
-    anyBrownOut = false;
-    anyEventTrapReset = false;
-    anySSRPowerFault = false;
-    anyAuxPowerFault = false;
+ThermalWarning::ThermalWarning(token) {
+    for (int f = 0; f < FLAGS; f++) {
+        this->*flag_fields[f].any = false;
+    }
+    _updated = false;
 }
 
 void ThermalWarning::update(uint8_t _address, uint8_t mode, uint16_t status, uint16_t faults) {
     int index = _address - 1;
-    auto update_field = [index, this](std::vector<bool> &values, bool new_value) {
-        if (values[index] != new_value) {
-            values[index] = new_value;
-            _updated = true;
-        }
+
+    const bool flags[FLAGS] = {
+            (status & ILC::Status::MajorFault) != 0,
+            (status & ILC::Status::MinorFault) != 0,
+            (status & ILC::Status::FaultOverride) != 0,
+            (status & cRIO::ThermalILCStatus::RefResistor) != 0,
+            (status & cRIO::ThermalILCStatus::RTDError) != 0,
+            (status & cRIO::ThermalILCStatus::HeaterBreaker) != 0,
+            (status & cRIO::ThermalILCStatus::FanBreaker) != 0,
+
+            (faults & ILC::Fault::UniqueIdCRC) != 0,
+            (faults & ILC::Fault::AppType) != 0,
+            (faults & ILC::Fault::AppCRC) != 0,
+            (faults & ILC::Fault::NoTEDS) != 0,
+            (faults & ILC::Fault::TEDS1) != 0,
+            (faults & ILC::Fault::TEDS2) != 0,
+            (faults & ILC::Fault::WatchdogReset) != 0,
+            (faults & ILC::Fault::BrownOut) != 0,
+            (faults & ILC::Fault::EventTrap) != 0,
+            (faults & ILC::Fault::SSR) != 0,
+            (faults & ILC::Fault::AUX) != 0,
     };
-    update_field(majorFault, status & ILC::Status::MajorFault);
-    update_field(minorFault, status & ILC::Status::MinorFault);
-    update_field(faultOverride, status & ILC::Status::FaultOverride);
-    update_field(refResistorError, status & cRIO::ThermalILCStatus::RefResistor);
-    update_field(rtdError, status & cRIO::ThermalILCStatus::RTDError);
-    update_field(breakerHeater1Error, status & cRIO::ThermalILCStatus::HeaterBreaker);
-    update_field(breakerFan2Error, status & cRIO::ThermalILCStatus::FanBreaker);
 
-    update_field(uniqueIdCRCError, faults & ILC::Fault::UniqueIdCRC);
-    update_field(applicationTypeMismatch, faults & ILC::Fault::AppType);
-    update_field(applicationCRCMismatch, faults & ILC::Fault::AppCRC);
-    update_field(oneWireMissing, faults & ILC::Fault::NoTEDS);
-    update_field(oneWire1Mismatch, faults & ILC::Fault::TEDS1);
-    update_field(oneWire2Mismatch, faults & ILC::Fault::TEDS2);
-    update_field(watchdogReset, faults & ILC::Fault::WatchdogReset);
-    update_field(brownOut, faults & ILC::Fault::BrownOut);
-    update_field(eventTrapReset, faults & ILC::Fault::EventTrap);
-    update_field(ssrPowerFault, faults & ILC::Fault::SSR);
-    update_field(auxPowerFault, faults & ILC::Fault::AUX);
+    for (int f = 0; f < FLAGS; f++) {
+        if (_masks[f].set(index, flags[f])) {
+            (this->*flag_fields[f].values)[index] = flags[f];
+            _updated = true;
+        }
+    }
 }
 
 void ThermalWarning::send() {
-    if (_updated) {
-        auto check_any = [](const std::vector<bool> &values) -> bool {
-            return std::find(values.begin(), values.end(), true) != values.end();
-        };
-
-        anyMajorFault = check_any(majorFault);
-        anyMinorFault = check_any(minorFault);
-        anyFaultOverride = check_any(faultOverride);
-        anyRefResistorError = check_any(refResistorError);
-        anyRTDError = check_any(rtdError);
-        anyBreakerHeater1Error = check_any(breakerHeater1Error);
-        anyBreakerFan2Error = check_any(breakerFan2Error);
-
-        anyUniqueIdCRCError = check_any(uniqueIdCRCError);
-        anyApplicationTypeMismatch = check_any(applicationTypeMismatch);
-        anyApplicationCRCMismatch = check_any(applicationCRCMismatch);
-        anyOneWireMissing = check_any(oneWireMissing);
-        anyOneWire1Mismatch = check_any(oneWire1Mismatch);
-        anyOneWire2Mismatch = check_any(oneWire2Mismatch);
-        anyWatchdogReset = check_any(watchdogReset);
-        anyBrownOut = check_any(brownOut);
-        anyEventTrapReset = check_any(eventTrapReset);
-        anySSRPowerFault = check_any(ssrPowerFault);
-        anyAuxPowerFault = check_any(auxPowerFault);
+    if (_updated == false) {
+        return;
+    }
 
-        TSPublisher::instance().logThermalWarning(this);
+    for (int f = 0; f < FLAGS; f++) {
+        this->*flag_fields[f].any = _masks[f].any();
     }
+
+    TSPublisher::instance().logThermalWarning(this);
+    _updated = false;
 }
@@ -23,6 +23,8 @@
 #ifndef _TS_Events_ThermalWarning_
 #define _TS_Events_ThermalWarning_
 
+#include <cstdint>
+
 #include <SAL_MTM1M3TS.h>
 
 #include <cRIO/Singleton.h>
@@ -34,16 +36,97 @@ namespace M1M3 {
 namespace TS {
 namespace Events {
 
+/**
+ * Per-FCU bit mask of a single warning flag. Supports up to 128 FCUs.
+ */
+class FlagMask {
+public:
+    FlagMask() : changes(0), _bits{0, 0} {}
+
+    /**
+     * Sets bit value.
+     *
+     * @param index FCU index (0 based)
+     * @param value new value
+     *
+     * @return true if value changed
+     */
+    bool set(int index, bool value) {
+        uint64_t bit = 1ULL << (index & 63);
+        uint64_t &word = _bits[index >> 6];
+        if (((word & bit) != 0) == value) {
+            return false;
+        }
+        word ^= bit;
+        changes++;
+        return true;
+    }
+
+    bool test(int index) const { return _bits[index >> 6] & (1ULL << (index & 63)); }
+
+    /**
+     * Returns number of FCUs with the flag set.
+     */
+    int count() const { return __builtin_popcountll(_bits[0]) + __builtin_popcountll(_bits[1]); }
+
+    bool any() const { return (_bits[0] | _bits[1]) != 0; }
+
+    /**
+     * Number of flag changes since the CSC start.
+     */
+    uint64_t changes;
+
+private:
+    uint64_t _bits[2];
+};
+
 class ThermalWarning : public MTM1M3TS_logevent_thermalWarningC, public cRIO::Singleton<ThermalWarning> {
 public:
     ThermalWarning(token);
 
+    /**
+     * Warning flags, in order of SAL fields.
+     */
+    enum Flag {
+        MAJOR_FAULT = 0,
+        MINOR_FAULT,
+        FAULT_OVERRIDE,
+        REF_RESISTOR_ERROR,
+        RTD_ERROR,
+        BREAKER_HEATER1_ERROR,
+        BREAKER_FAN2_ERROR,
+        UNIQUE_ID_CRC_ERROR,
+        APPLICATION_TYPE_MISMATCH,
+        APPLICATION_CRC_MISMATCH,
+        ONE_WIRE_MISSING,
+        ONE_WIRE1_MISMATCH,
+        ONE_WIRE2_MISMATCH,
+        WATCHDOG_RESET,
+        BROWN_OUT,
+        EVENT_TRAP_RESET,
+        SSR_POWER_FAULT,
+        AUX_POWER_FAULT,
+        FLAGS
+    };
+
     void update(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults);
 
+    /**
+     * Sends the event if any flag changed since the last send.
+     */
     void send();
 
+    /**
+     * Returns bit mask of a flag.
+     *
+     * @param flag warning flag
+     */
+    const FlagMask &get_mask(Flag flag) const { return _masks[flag]; }
+
 private:
     bool _updated;
+
+    FlagMask _masks[FLAGS];
 };
 
 }  // namespace Events
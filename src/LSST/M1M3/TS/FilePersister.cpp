@@ -0,0 +1,182 @@
+/*
+ * Background, atomic writer of persisted state files.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "FilePersister.h"
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+constexpr std::chrono::milliseconds FilePersister::COALESCE_DELAY;
+
+FilePersister::FilePersister(token) {
+    _writing = false;
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+void FilePersister::persist(const std::string &path, serializer_t serializer) {
+    if (isRunning() == false) {
+        bool written = write_atomically(path, serializer());
+        std::lock_guard<std::mutex> lg(_queue_mutex);
+        _statistics.requested++;
+        if (written) {
+            _statistics.written++;
+        } else {
+            _statistics.failed++;
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(_queue_mutex);
+        _statistics.requested++;
+        if (_pending.empty()) {
+            _first_pending = std::chrono::steady_clock::now();
+        }
+        auto ret = _pending.insert_or_assign(path, std::move(serializer));
+        if (ret.second == false) {
+            _statistics.coalesced++;
+        }
+    }
+    _queue_condition.notify_all();
+}
+
+bool FilePersister::flush(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> ql(_queue_mutex);
+    _first_pending = std::chrono::steady_clock::time_point();
+    _queue_condition.notify_all();
+    return _queue_condition.wait_for(ql, timeout, [this] { return _pending.empty() && _writing == false; });
+}
+
+bool FilePersister::write_atomically(const std::string &path, const std::string &content) {
+    auto tmp_path = path + ".tmp";
+
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        int err = errno;
+        SPDLOG_ERROR("Cannot open {} - {}", tmp_path, strerror(err));
+        return false;
+    }
+
+    const char *buf = content.c_str();
+    size_t remaining = content.length();
+    while (remaining > 0) {
+        auto written = write(fd, buf, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            int err = errno;
+            close(fd);
+            SPDLOG_ERROR("Cannot write {} - {}", tmp_path, strerror(err));
+            unlink(tmp_path.c_str());
+            return false;
+        }
+        buf += written;
+        remaining -= written;
+    }
+
+    int synced = fsync(fd);
+    if (close(fd) != 0 || synced != 0) {
+        int err = errno;
+        SPDLOG_ERROR("Cannot sync {} - {}", tmp_path, strerror(err));
+        unlink(tmp_path.c_str());
+        return false;
+    }
+
+    if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+        int err = errno;
+        SPDLOG_ERROR("Cannot rename {} to {} - {}", tmp_path, path, strerror(err));
+        unlink(tmp_path.c_str());
+        return false;
+    }
+
+    // sync directory, so the rename survives power loss
+    std::string dir_buf = path;
+    int dir_fd = open(dirname(dir_buf.data()), O_RDONLY | O_DIRECTORY);
+    if (dir_fd >= 0) {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+
+    return true;
+}
+
+FilePersister::Statistics FilePersister::get_statistics() {
+    std::lock_guard<std::mutex> lg(_queue_mutex);
+    return _statistics;
+}
+
+void FilePersister::run(std::unique_lock<std::mutex> &lock) {
+    // callers notify _queue_condition, the thread lock is held only by stop
+    lock.unlock();
+
+    SPDLOG_INFO("Running file persister.");
+
+    std::unique_lock<std::mutex> ql(_queue_mutex);
+    while (keepRunning) {
+        if (_pending.empty()) {
+            _queue_condition.wait_for(ql, 100ms);
+            continue;
+        }
+        // hold requests for a while, so rapid changes are coalesced
+        auto due = _first_pending + COALESCE_DELAY;
+        if (std::chrono::steady_clock::now() < due) {
+            _queue_condition.wait_until(ql, due);
+            continue;
+        }
+        _write_pending(ql);
+    }
+
+    // write files requested before the stop request
+    _write_pending(ql);
+    SPDLOG_INFO("File persister stopped.");
+
+    ql.unlock();
+    lock.lock();
+}
+
+void FilePersister::_write_pending(std::unique_lock<std::mutex> &queue_lock) {
+    while (_pending.empty() == false) {
+        auto request = _pending.extract(_pending.begin());
+        _writing = true;
+
+        queue_lock.unlock();
+        bool written = write_atomically(request.key(), request.mapped()());
+        queue_lock.lock();
+
+        _writing = false;
+        if (written) {
+            _statistics.written++;
+        } else {
+            _statistics.failed++;
+        }
+    }
+    _queue_condition.notify_all();
+}
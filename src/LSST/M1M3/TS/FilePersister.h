@@ -0,0 +1,120 @@
+/*
+ * Background, atomic writer of persisted state files.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_FilePersister_
+#define _TS_FilePersister_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/Thread.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Writes persisted state files (saved setpoints, controller checkpoint) from
+ * a background thread, so the controller thread doesn't block on flash I/O.
+ * Callers pass a serializer holding a copy of the data, the serializer is
+ * called on the persister thread. Requests for a file which wasn't yet
+ * written replace the pending request, so rapid changes are coalesced into a
+ * single write. Files are written into a temporary file, synced and renamed
+ * over the original, so a crash never leaves a truncated file behind. If the
+ * thread isn't running, files are written immediately.
+ */
+class FilePersister final : public cRIO::Thread, public cRIO::Singleton<FilePersister> {
+public:
+    FilePersister(token);
+
+    typedef std::function<std::string()> serializer_t;
+
+    /**
+     * Time requests are held before being written, so rapid changes are
+     * coalesced.
+     */
+    static constexpr std::chrono::milliseconds COALESCE_DELAY = std::chrono::milliseconds(200);
+
+    /**
+     * Schedules file write.
+     *
+     * @param path file path
+     * @param serializer returns file content. Shall hold copy of the data, as it is called from the
+     * persister thread
+     */
+    void persist(const std::string &path, serializer_t serializer);
+
+    /**
+     * Waits until all pending files are written.
+     *
+     * @param timeout maximal time to wait
+     *
+     * @return true if all files were written, false on timeout
+     */
+    bool flush(std::chrono::milliseconds timeout);
+
+    /**
+     * Writes content into a temporary file, syncs it and renames it to the
+     * path. Errors are logged.
+     *
+     * @param path file path
+     * @param content file content
+     *
+     * @return true on success
+     */
+    static bool write_atomically(const std::string &path, const std::string &content);
+
+    struct Statistics {
+        uint64_t requested;
+        uint64_t coalesced;
+        uint64_t written;
+        uint64_t failed;
+    };
+
+    Statistics get_statistics();
+
+protected:
+    void run(std::unique_lock<std::mutex> &lock) override;
+
+private:
+    void _write_pending(std::unique_lock<std::mutex> &queue_lock);
+
+    std::mutex _queue_mutex;
+    std::condition_variable _queue_condition;
+    std::map<std::string, serializer_t> _pending;
+    std::chrono::steady_clock::time_point _first_pending;
+    bool _writing;
+
+    Statistics _statistics;
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // ! _TS_FilePersister_
@@ -20,8 +20,10 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdexcept>
 #include <string.h>
-#include <thread>
+
+#include <spdlog/spdlog.h>
 
 #include <cRIO/ThermalILC.h>
 
@@ -36,6 +38,7 @@
 #include "Events/SummaryState.h"
 #include "Settings/GlycolPump.h"
 #include "Telemetry/FinerControl.h"
+#include "TSApplication.h"
 
 using namespace std::chrono_literals;
 using namespace LSST::M1M3::TS;
@@ -87,9 +90,11 @@ void IFPGA::setFCUPower(bool on) {
 
 void IFPGA::setCoolantPumpPower(bool on) {
     if (on) {
-        if (_next_egw_powerup > std::chrono::steady_clock::now()) {
-            SPDLOG_INFO("Waiting for EGW pump power down.");
-            std::this_thread::sleep_until(_next_egw_powerup);
+        auto now = std::chrono::steady_clock::now();
+        if (_next_egw_powerup > now) {
+            throw std::runtime_error(fmt::format(
+                    "Cannot power up EGW pump - it was powered down recently, wait {:.1f} seconds.",
+                    std::chrono::duration<float>(_next_egw_powerup - now).count()));
         }
     } else {
         _next_egw_powerup =
@@ -110,6 +115,9 @@ void IFPGA::setHeartbeat(bool heartbeat) {
 }
 
 void IFPGA::panic() {
+    // can be called from MPU threads, while the controller thread uses the bus
+    auto ilc_lock = TSApplication::lock_ilc();
+
     Telemetry::FinerControl::instance().set_target(NAN);
     setMixingValvePosition(0);
 
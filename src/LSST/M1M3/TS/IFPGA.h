@@ -24,6 +24,7 @@
 #define __TS_IFPGA__
 
 #include <chrono>
+#include <functional>
 #include <memory>
 
 #include <NiFpga.h>
@@ -79,11 +80,41 @@ public:
 
     virtual float chassisTemperature() = 0;
 
+    /**
+     * Verifies bus communication through FPGA bitfile, which was found
+     * running and reused on open(). The FPGA is reset if the first bus
+     * transaction fails. No-op if the FPGA was reset on open or was already
+     * verified.
+     *
+     * @param transaction first bus transaction, shall throw on failure
+     *
+     * @return true if FPGA was reset and the transaction shall be retried
+     */
+    virtual bool verify_reused(std::function<void(void)> transaction) { return false; }
+
     uint32_t getSlot4DIs();
 
     void setFCUPower(bool on);
+
+    /**
+     * Switch EGW coolant pump power. The pump cannot be powered up until
+     * GlycolPump.CommunicationRecoverPowerOff seconds passed since it was
+     * powered down. This call never blocks - callers shall schedule power up
+     * after getCoolantPumpPowerUpTime() (see Tasks::CoolantPumpPowerUp).
+     *
+     * @param on true to power on the pump, false to power it off
+     *
+     * @throw std::runtime_error if power up is requested too early
+     */
     void setCoolantPumpPower(bool on);
 
+    /**
+     * Returns time point after which the coolant pump can be powered on.
+     *
+     * @return earliest coolant pump power up time
+     */
+    std::chrono::steady_clock::time_point getCoolantPumpPowerUpTime() const { return _next_egw_powerup; }
+
     void setHeartbeat(bool heartbeat);
 
     /**
@@ -0,0 +1,124 @@
+/*
+ * Sequences ILC mode transitions.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <fmt/ranges.h>
+#include <spdlog/spdlog.h>
+
+#include "ILCModeSequencer.h"
+
+using namespace LSST::M1M3::TS;
+
+ILCModeSequencer::ILCModeSequencer(cRIO::ThermalILC &ilc, std::function<void(void)> execute, int retries)
+        : _ilc(ilc), _execute(execute), _retries(retries), _transactions(0) {
+    for (auto &r : _reported) {
+        r = -1;
+    }
+}
+
+void ILCModeSequencer::mode_changed(uint8_t address, uint16_t mode) { _reported[address] = mode; }
+
+bool ILCModeSequencer::run(const std::vector<uint8_t> &addresses, const std::vector<uint16_t> &modes) {
+    std::vector<uint8_t> pending = addresses;
+
+    _failed.clear();
+    _transactions = 0;
+
+    for (auto mode : modes) {
+        std::vector<uint8_t> step = pending;
+        std::vector<uint8_t> step_failed;
+
+        for (auto address : step) {
+            _slot_failures[address] = 0;
+        }
+
+        while (step.empty() == false) {
+            _ilc.clear();
+            for (auto address : step) {
+                _reported[address] = -1;
+                _ilc.changeILCMode(address, mode);
+            }
+
+            bool interrupted = false;
+            try {
+                _transactions++;
+                _execute();
+            } catch (std::exception &ex) {
+                interrupted = true;
+                SPDLOG_WARN("Changing {} ILCs to mode {}: {}", step.size(), mode, ex.what());
+            }
+
+            // responses are processed in the request order - the first
+            // address without response failed in its slot, responses of the
+            // following addresses weren't processed
+            std::vector<uint8_t> unverified;
+            std::vector<uint8_t> retry;
+            bool slot_failed = false;
+            for (auto address : step) {
+                if (_mode_reached(address, mode)) {
+                    continue;
+                }
+                if (interrupted && slot_failed && _reported[address] == -1) {
+                    unverified.push_back(address);
+                    continue;
+                }
+                if (_reported[address] == -1) {
+                    slot_failed = true;
+                }
+                _slot_failures[address]++;
+                if (_slot_failures[address] > _retries) {
+                    step_failed.push_back(address);
+                } else {
+                    retry.push_back(address);
+                }
+            }
+
+            // addresses failing in their slot go last, so they cannot interrupt the unverified ones again
+            unverified.insert(unverified.end(), retry.begin(), retry.end());
+            step = unverified;
+        }
+
+        if (step_failed.empty() == false) {
+            SPDLOG_WARN("ILCs {} didn't change to mode {}.", fmt::join(step_failed, ", "), mode);
+            for (auto address : step_failed) {
+                _failed.push_back(address);
+                pending.erase(std::find(pending.begin(), pending.end(), address));
+            }
+        }
+    }
+
+    _ilc.clear();
+
+    SPDLOG_DEBUG("Changed mode of {} ILCs through {} modes in {} transactions.", pending.size(), modes.size(),
+                 _transactions);
+
+    return _failed.empty();
+}
+
+bool ILCModeSequencer::_mode_reached(uint8_t address, uint16_t mode) {
+    // ILC leaves ClearFaults to Standby
+    if (mode == ILC::Mode::ClearFaults) {
+        return _reported[address] == ILC::Mode::ClearFaults || _reported[address] == ILC::Mode::Standby;
+    }
+    return _reported[address] == mode;
+}
@@ -0,0 +1,105 @@
+/*
+ * Sequences ILC mode transitions.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_ILCModeSequencer_
+#define _TS_ILCModeSequencer_
+
+#include <functional>
+#include <vector>
+
+#include <cRIO/ThermalILC.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Changes mode of multiple ILCs through a sequence of modes. Each step of
+ * the sequence is a single bus transaction with mode change requests for
+ * all addresses. Modes returned in the responses are verified, and only
+ * addresses which didn't respond or returned an unexpected mode are retried.
+ * A transaction failing on a missing or invalid response doesn't process the
+ * following responses - only the address in the failed slot counts as
+ * failed, the following addresses are retried first in the next transaction
+ * without using their retries. Addresses failing a step are excluded from
+ * the following steps.
+ *
+ * Responses must be passed to mode_changed, as the ILC bus list processing
+ * the responses isn't owned by the sequencer.
+ */
+class ILCModeSequencer {
+public:
+    /**
+     * Constructs the sequencer.
+     *
+     * @param ilc ILC bus list used to queue the mode change requests
+     * @param execute executes the queued bus transaction
+     * @param retries number of retries for addresses failing in their own slot
+     */
+    ILCModeSequencer(cRIO::ThermalILC &ilc, std::function<void(void)> execute, int retries = 2);
+
+    /**
+     * Records mode returned by the ILC.
+     *
+     * @param address ILC address
+     * @param mode new ILC mode
+     */
+    void mode_changed(uint8_t address, uint16_t mode);
+
+    /**
+     * Runs the mode sequence.
+     *
+     * @param addresses ILC addresses
+     * @param modes sequence of the modes
+     *
+     * @return true if all ILCs went through all the modes
+     */
+    bool run(const std::vector<uint8_t> &addresses, const std::vector<uint16_t> &modes);
+
+    /**
+     * Returns addresses which failed the last run.
+     */
+    const std::vector<uint8_t> &failed() const { return _failed; }
+
+    /**
+     * Returns number of bus transactions executed by the last run.
+     */
+    int transactions() const { return _transactions; }
+
+private:
+    bool _mode_reached(uint8_t address, uint16_t mode);
+
+    cRIO::ThermalILC &_ilc;
+    std::function<void(void)> _execute;
+    int _retries;
+
+    int _reported[256];
+    int _slot_failures[256];
+    std::vector<uint8_t> _failed;
+    int _transactions;
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_ILCModeSequencer_
@@ -0,0 +1,92 @@
+/*
+ * Command to telemetry latency tracing.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "LatencyProbe.h"
+
+using namespace LSST::M1M3::TS;
+
+thread_local int32_t LatencyProbe::_current = 0;
+
+LatencyProbe::LatencyProbe(token) : _armed(false), _trace(0), _discarded(0) {
+    for (auto &m : _marks) {
+        m.store(0, std::memory_order_relaxed);
+    }
+}
+
+const char *LatencyProbe::stage_name(Stage stage) {
+    switch (stage) {
+        case COMMAND_ACCEPTED:
+            return "accepted";
+        case DEQUEUED:
+            return "dequeued";
+        case FIFO_WRITE:
+            return "FIFO write";
+        case RESPONSE:
+            return "response";
+        case PUBLISHED:
+            return "published";
+        default:
+            return "unknown";
+    }
+}
+
+void LatencyProbe::arm(int32_t trace) {
+    for (auto &m : _marks) {
+        m.store(0, std::memory_order_relaxed);
+    }
+    _trace.store(trace, std::memory_order_relaxed);
+    _discarded.store(0, std::memory_order_relaxed);
+    _armed.store(true, std::memory_order_release);
+}
+
+bool LatencyProbe::wait(Stage stage, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(_wait_mutex);
+    return _wait_condition.wait_for(lock, timeout,
+                                    [this, stage] { return _marks[stage].load(std::memory_order_acquire) != 0; });
+}
+
+float LatencyProbe::since_accepted(Stage stage) const {
+    int64_t accepted = _marks[COMMAND_ACCEPTED].load(std::memory_order_acquire);
+    int64_t at = _marks[stage].load(std::memory_order_acquire);
+    if (accepted == 0 || at == 0) {
+        return NAN;
+    }
+    return (at - accepted) / 1000.0f;
+}
+
+void LatencyProbe::_mark(Stage stage, int32_t trace) {
+    if (trace != _trace.load(std::memory_order_relaxed)) {
+        _discarded.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+    int64_t expected = 0;
+    if (_marks[stage].compare_exchange_strong(expected, now, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lg(_wait_mutex);
+        _wait_condition.notify_all();
+    }
+}
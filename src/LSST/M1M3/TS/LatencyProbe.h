@@ -0,0 +1,159 @@
+/*
+ * Command to telemetry latency tracing.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_LatencyProbe_
+#define _TS_LatencyProbe_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include <cRIO/Singleton.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Timestamps stages of a single command as it travels through the CSC -
+ * from SAL command acceptance, through the controller thread, FPGA FIFO and
+ * bus, to the telemetry (or event) publishing. Marks are tagged with the
+ * traced command ID - explicitly, or implicitly by the Scope of the command
+ * execution on the current thread. Only the first occurrence of each stage
+ * of the armed command is recorded, marks of other commands and untraced
+ * tasks (control loops, telemetry polling) are counted as discarded. When not
+ * armed, mark() costs a single relaxed atomic load, so the probes can stay in
+ * the production code.
+ */
+class LatencyProbe final : public cRIO::Singleton<LatencyProbe> {
+public:
+    LatencyProbe(token);
+
+    enum Stage {
+        COMMAND_ACCEPTED,  /// command received from SAL, enqueued to the controller thread
+        DEQUEUED,          /// command execution started in the controller thread
+        FIFO_WRITE,        /// command written to the FPGA FIFO
+        RESPONSE,          /// response read from the FPGA FIFO
+        PUBLISHED,         /// telemetry or event published
+        STAGES
+    };
+
+    static const char *stage_name(Stage stage);
+
+    /**
+     * Tags marks done on the current thread during its lifetime with the
+     * command ID. Marks DEQUEUED stage.
+     */
+    class Scope {
+    public:
+        Scope(int32_t trace) : _previous(_current) {
+            _current = trace;
+            instance().mark(DEQUEUED);
+        }
+        ~Scope() { _current = _previous; }
+
+    private:
+        int32_t _previous;
+    };
+
+    /**
+     * Returns trace (command ID) of the current thread, 0 if the thread
+     * doesn't execute traced command.
+     */
+    static int32_t current() { return _current; }
+
+    /**
+     * Clears recorded timestamps and starts recording.
+     *
+     * @param trace traced command ID, shall not be 0
+     */
+    void arm(int32_t trace);
+
+    /**
+     * Stops recording.
+     */
+    void disarm() { _armed.store(false, std::memory_order_relaxed); }
+
+    /**
+     * Records stage timestamp, if armed for the current thread trace and the
+     * stage wasn't yet recorded.
+     */
+    void mark(Stage stage) {
+        if (_armed.load(std::memory_order_relaxed)) {
+            _mark(stage, _current);
+        }
+    }
+
+    /**
+     * Records stage timestamp, if armed for the trace and the stage wasn't
+     * yet recorded.
+     */
+    void mark(Stage stage, int32_t trace) {
+        if (_armed.load(std::memory_order_relaxed)) {
+            _mark(stage, trace);
+        }
+    }
+
+    /**
+     * Waits for stage to be recorded.
+     *
+     * @param stage stage to wait for
+     * @param timeout maximal wait time
+     *
+     * @return true if the stage was recorded
+     */
+    bool wait(Stage stage, std::chrono::milliseconds timeout);
+
+    /**
+     * Returns time of the stage since COMMAND_ACCEPTED.
+     *
+     * @return time in microseconds, NAN if stage or COMMAND_ACCEPTED wasn't recorded
+     */
+    float since_accepted(Stage stage) const;
+
+    /**
+     * Returns number of marks of other traces received since arm().
+     */
+    uint64_t discarded() const { return _discarded.load(std::memory_order_relaxed); }
+
+private:
+    void _mark(Stage stage, int32_t trace);
+
+    static thread_local int32_t _current;
+
+    std::atomic<bool> _armed;
+    std::atomic<int32_t> _trace;
+    std::atomic<uint64_t> _discarded;
+    // steady clock nanoseconds, 0 when not recorded
+    std::atomic<int64_t> _marks[STAGES];
+
+    std::mutex _wait_mutex;
+    std::condition_variable _wait_condition;
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_LatencyProbe_
@@ -0,0 +1,204 @@
+/*
+ * Live CSC state exported in a shared memory segment.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "LiveState.h"
+#include "Telemetry/TelemetryHistory.h"
+
+using namespace LSST::M1M3::TS;
+
+LiveState::LiveState(token) : _segment(nullptr) {}
+
+LiveState::~LiveState() { close(); }
+
+void LiveState::open(const std::string &name) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Cannot create live state segment {}: {}", name, strerror(errno)));
+    }
+    if (ftruncate(fd, sizeof(LiveStateSegment)) != 0) {
+        int err = errno;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error(fmt::format("Cannot size live state segment {}: {}", name, strerror(err)));
+    }
+    void *addr = mmap(nullptr, sizeof(LiveStateSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        int err = errno;
+        shm_unlink(name.c_str());
+        throw std::runtime_error(fmt::format("Cannot map live state segment {}: {}", name, strerror(err)));
+    }
+
+    auto segment = new (addr) LiveStateSegment();
+    segment->version = LiveStateSegment::VERSION;
+    segment->size = sizeof(LiveStateSegment);
+    segment->pid = getpid();
+    segment->started = Telemetry::TelemetryHistory::now();
+    // readers validate magic, so it has to be the last store
+    segment->magic.store(LiveStateSegment::MAGIC, std::memory_order_release);
+
+    _name = name;
+    _segment = segment;
+
+    SPDLOG_INFO("Exporting live state in {} ({} bytes)", _name, sizeof(LiveStateSegment));
+}
+
+void LiveState::close() {
+    if (_segment == nullptr) {
+        return;
+    }
+    auto segment = _segment;
+    _segment = nullptr;
+    segment->magic.store(0, std::memory_order_release);
+    munmap(segment, sizeof(LiveStateSegment));
+    shm_unlink(_name.c_str());
+}
+
+void LiveState::update(const MTM1M3TS_thermalDataC &data) {
+    if (_segment == nullptr) {
+        return;
+    }
+    LiveThermalData live;
+    live.timestamp = Telemetry::TelemetryHistory::now();
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        live.status[i] = (data.ilcFault[i] ? 0x01 : 0) | (data.heaterDisabled[i] ? 0x02 : 0) |
+                         (data.heaterBreaker[i] ? 0x04 : 0) | (data.fanBreaker[i] ? 0x08 : 0);
+        live.differentialTemperature[i] = data.differentialTemperature[i];
+        live.fanRPM[i] = data.fanRPM[i];
+        live.absoluteTemperature[i] = data.absoluteTemperature[i];
+    }
+    _segment->thermalData.store(live);
+}
+
+void LiveState::update(const MTM1M3TS_logevent_fcuTargetsC &data) {
+    if (_segment == nullptr) {
+        return;
+    }
+    LiveFcuTargets live;
+    live.timestamp = Telemetry::TelemetryHistory::now();
+    std::copy_n(data.heaterPWM.begin(), cRIO::NUM_TS_ILC, live.heaterPWM);
+    std::copy_n(data.fanRPM.begin(), cRIO::NUM_TS_ILC, live.fanRPM);
+    _segment->fcuTargets.store(live);
+}
+
+void LiveState::update(const MTM1M3TS_glycolLoopTemperatureC &data) {
+    if (_segment == nullptr) {
+        return;
+    }
+    LiveGlycolLoopTemperature live;
+    live.timestamp = Telemetry::TelemetryHistory::now();
+    live.aboveMirrorTemperature = data.aboveMirrorTemperature;
+    live.insideCellTemperature1 = data.insideCellTemperature1;
+    live.insideCellTemperature2 = data.insideCellTemperature2;
+    live.insideCellTemperature3 = data.insideCellTemperature3;
+    live.telescopeCoolantSupplyTemperature = data.telescopeCoolantSupplyTemperature;
+    live.telescopeCoolantReturnTemperature = data.telescopeCoolantReturnTemperature;
+    live.mirrorCoolantSupplyTemperature = data.mirrorCoolantSupplyTemperature;
+    live.mirrorCoolantReturnTemperature = data.mirrorCoolantReturnTemperature;
+    _segment->glycolLoopTemperature.store(live);
+}
+
+void LiveState::update(const MTM1M3TS_mixingValveC &data) {
+    if (_segment == nullptr) {
+        return;
+    }
+    LiveMixingValve live;
+    live.timestamp = Telemetry::TelemetryHistory::now();
+    live.rawValvePosition = data.rawValvePosition;
+    live.valvePosition = data.valvePosition;
+    _segment->mixingValve.store(live);
+}
+
+void LiveState::update(const MTM1M3TS_flowMeterC &data) {
+    if (_segment == nullptr) {
+        return;
+    }
+    LiveFlowMeter live;
+    live.timestamp = Telemetry::TelemetryHistory::now();
+    live.signalStrength = data.signalStrength;
+    live.flowRate = data.flowRate;
+    live.netTotalizer = data.netTotalizer;
+    live.positiveTotalizer = data.positiveTotalizer;
+    live.negativeTotalizer = data.negativeTotalizer;
+    _segment->flowMeter.store(live);
+}
+
+void LiveState::update(const MTM1M3TS_glycolPumpC &data) {
+    if (_segment == nullptr) {
+        return;
+    }
+    LiveGlycolPump live;
+    live.timestamp = Telemetry::TelemetryHistory::now();
+    live.commandedFrequency = data.commandedFrequency;
+    live.targetFrequency = data.targetFrequency;
+    live.outputFrequency = data.outputFrequency;
+    live.speedFeedback = data.speedFeedback;
+    live.outputCurrent = data.outputCurrent;
+    live.busVoltage = data.busVoltage;
+    live.outputVoltage = data.outputVoltage;
+    _segment->glycolPump.store(live);
+}
+
+LiveStateReader::LiveStateReader(const std::string &name) : _segment(nullptr) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Cannot open live state segment {}: {}", name, strerror(errno)));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(LiveStateSegment))) {
+        ::close(fd);
+        throw std::runtime_error(fmt::format("Live state segment {} is too small", name));
+    }
+    void *addr = mmap(nullptr, sizeof(LiveStateSegment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Cannot map live state segment {}: {}", name, strerror(errno)));
+    }
+
+    auto segment = static_cast<const LiveStateSegment *>(addr);
+    if (segment->magic.load(std::memory_order_acquire) != LiveStateSegment::MAGIC ||
+        segment->version != LiveStateSegment::VERSION || segment->size != sizeof(LiveStateSegment)) {
+        munmap(addr, sizeof(LiveStateSegment));
+        throw std::runtime_error(
+                fmt::format("Live state segment {} is not valid or has incompatible version", name));
+    }
+    _segment = segment;
+}
+
+LiveStateReader::~LiveStateReader() {
+    munmap(const_cast<LiveStateSegment *>(_segment), sizeof(LiveStateSegment));
+}
@@ -0,0 +1,182 @@
+/*
+ * Live CSC state exported in a shared memory segment.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_LiveState_
+#define _TS_LiveState_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <SAL_MTM1M3TS.h>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/ThermalILC.h>
+
+#include "SeqLock.h"
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * FCU telemetry. Status bits as in thermalData (ilcFault, heaterDisabled,
+ * heaterBreaker, fanBreaker).
+ */
+struct LiveThermalData {
+    double timestamp;
+    uint8_t status[cRIO::NUM_TS_ILC];
+    float differentialTemperature[cRIO::NUM_TS_ILC];
+    int32_t fanRPM[cRIO::NUM_TS_ILC];
+    float absoluteTemperature[cRIO::NUM_TS_ILC];
+};
+
+struct LiveFcuTargets {
+    double timestamp;
+    float heaterPWM[cRIO::NUM_TS_ILC];
+    int32_t fanRPM[cRIO::NUM_TS_ILC];
+};
+
+struct LiveGlycolLoopTemperature {
+    double timestamp;
+    float aboveMirrorTemperature;
+    float insideCellTemperature1;
+    float insideCellTemperature2;
+    float insideCellTemperature3;
+    float telescopeCoolantSupplyTemperature;
+    float telescopeCoolantReturnTemperature;
+    float mirrorCoolantSupplyTemperature;
+    float mirrorCoolantReturnTemperature;
+};
+
+struct LiveMixingValve {
+    double timestamp;
+    float rawValvePosition;
+    float valvePosition;
+};
+
+struct LiveFlowMeter {
+    double timestamp;
+    float signalStrength;
+    float flowRate;
+    float netTotalizer;
+    float positiveTotalizer;
+    float negativeTotalizer;
+};
+
+struct LiveGlycolPump {
+    double timestamp;
+    float commandedFrequency;
+    float targetFrequency;
+    float outputFrequency;
+    float speedFeedback;
+    float outputCurrent;
+    float busVoltage;
+    float outputVoltage;
+};
+
+/**
+ * Shared memory segment layout. Every block is protected by its own sequence
+ * lock and written by a single thread - the thread producing the telemetry.
+ * Readers check magic, version and size before accessing blocks.
+ */
+struct LiveStateSegment {
+    static constexpr uint32_t MAGIC = 0x4D335453;  // M3TS
+    static constexpr uint32_t VERSION = 1;
+
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t size;
+    int32_t pid;
+    double started;
+
+    SeqLock<LiveThermalData> thermalData;
+    SeqLock<LiveFcuTargets> fcuTargets;
+    SeqLock<LiveGlycolLoopTemperature> glycolLoopTemperature;
+    SeqLock<LiveMixingValve> mixingValve;
+    SeqLock<LiveFlowMeter> flowMeter;
+    SeqLock<LiveGlycolPump> glycolPump;
+};
+
+/**
+ * Exports the current CSC state into a POSIX shared memory segment, so local
+ * diagnostic tools (m1m3tscli live-state) can read it without bus traffic
+ * and DDS. Updates before open are ignored.
+ */
+class LiveState final : public cRIO::Singleton<LiveState> {
+public:
+    LiveState(token);
+    ~LiveState();
+
+    /**
+     * Default shared memory segment name.
+     */
+    static constexpr const char *SEGMENT = "/M1M3TS_live_state";
+
+    /**
+     * Creates and maps the segment.
+     *
+     * @param name segment name
+     *
+     * @throw std::runtime_error on error
+     */
+    void open(const std::string &name = SEGMENT);
+
+    /**
+     * Unmaps and removes the segment.
+     */
+    void close();
+
+    void update(const MTM1M3TS_thermalDataC &data);
+    void update(const MTM1M3TS_logevent_fcuTargetsC &data);
+    void update(const MTM1M3TS_glycolLoopTemperatureC &data);
+    void update(const MTM1M3TS_mixingValveC &data);
+    void update(const MTM1M3TS_flowMeterC &data);
+    void update(const MTM1M3TS_glycolPumpC &data);
+
+private:
+    std::string _name;
+    LiveStateSegment *_segment;
+};
+
+/**
+ * Read only access to the live state segment.
+ */
+class LiveStateReader {
+public:
+    /**
+     * @throw std::runtime_error if segment doesn't exist or isn't compatible
+     */
+    LiveStateReader(const std::string &name = LiveState::SEGMENT);
+    ~LiveStateReader();
+
+    const LiveStateSegment *operator->() const { return _segment; }
+
+private:
+    const LiveStateSegment *_segment;
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_LiveState_
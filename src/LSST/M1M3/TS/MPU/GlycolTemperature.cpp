@@ -21,7 +21,7 @@
  */
 
 #include <chrono>
-#include <sstream>
+#include <cstring>
 
 #include <spdlog/spdlog.h>
 
@@ -34,7 +34,7 @@ using namespace std::chrono_literals;
 
 GlycolTemperature::GlycolTemperature(std::shared_ptr<Transports::Transport> transport)
         : MPU(0), Thread(), _transport(transport) {
-    for (int i = 0; i < 8; i++) {
+    for (size_t i = 0; i < GlycolTemperatureParser::CHANNELS; i++) {
         _temperatures[i] = NAN;
     }
 }
@@ -64,54 +64,32 @@ void GlycolTemperature::run(std::unique_lock<std::mutex>& lock) {
             continue;
         }
 
-        if (new_data.size() > 0) {
-            SPDLOG_TRACE("Received temperature data: {}, so far: {}", new_data.size(), _data_buffer.size());
-            _data_buffer += std::string(new_data.begin(), new_data.end());
-        }
-
-        auto new_line = _data_buffer.find('\r');
+        bool parsed = false;
 
-        if (new_line != std::string::npos && new_line + 1 < _data_buffer.size()) {
-            {
-                last_data = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> guard(_temperature_mutex);
 
-                std::lock_guard<std::mutex> guard(_temperature_mutex);
+            if (new_data.size() > 0) {
+                SPDLOG_TRACE("Received temperature data: {}, so far: {}", new_data.size(), _parser.size());
+                if (_parser.push(new_data.data(), new_data.size()) > 0) {
+                    SPDLOG_WARN("Glycol temperature buffer overflow, resynchronizing.");
+                }
+            }
 
-                _last_processed = _data_buffer.substr(0, new_line + 1);
-                std::stringstream ss(_last_processed);
+            auto partial = _parser.partial;
 
-                int i;
-                for (i = 0; i < 8; i++) {
-                    _temperatures[i] = NAN;
-                }
+            // process all complete lines, keep only the latest values
+            while (_parser.next(_temperatures)) {
+                parsed = true;
+            }
 
-                i = 0;
-                while (ss.good()) {
-                    char c;
-                    int num;
-                    char eq;
-                    float v;
-                    ss >> c >> num >> eq >> v;
-
-                    // SPDLOG_TRACE("c:{} num:{} eq:{} v:{}", c, num, eq, v);
-
-                    if (ss.good() && c == 'C' && eq == '=' && num == i + 1) {
-                        _temperatures[i] = v < 900 ? v : NAN;
-                        ss >> c;
-                    } else {
-                        break;
-                    }
-
-                    if ((!ss.good() && i < 7 && c != ',') || (i == 7 && !ss.eof())) {
-                        SPDLOG_WARN("Cannot parse {} at position {}", _last_processed.substr(0, new_line),
-                                    static_cast<int>(ss.tellg()));
-                        break;
-                    }
-
-                    i++;
-                }
-                _data_buffer = _data_buffer.substr(new_line + 2);
+            if (_parser.partial != partial) {
+                SPDLOG_WARN("Cannot parse all channels from {}", _parser.last_line());
             }
+        }
+
+        if (parsed) {
+            last_data = std::chrono::steady_clock::now();
 
             // updates must be called without hold of the _temperature_mutex
             updated();
@@ -119,7 +97,7 @@ void GlycolTemperature::run(std::unique_lock<std::mutex>& lock) {
         } else {
             if (std::chrono::steady_clock::now() > last_data + 4s) {
                 if (proc_error_count == 0) {
-                    SPDLOG_WARN("Empty glycol temp buffer: {}", _data_buffer);
+                    SPDLOG_WARN("Empty glycol temp buffer, {} bytes pending.", _parser.size());
                 }
                 proc_error_count++;
             }
@@ -132,10 +110,15 @@ void GlycolTemperature::run(std::unique_lock<std::mutex>& lock) {
 
 std::vector<float> GlycolTemperature::getTemperatures() {
     std::lock_guard<std::mutex> guard(_temperature_mutex);
-    return std::vector<float>(_temperatures, _temperatures + 8);
+    return std::vector<float>(_temperatures, _temperatures + GlycolTemperatureParser::CHANNELS);
+}
+
+void GlycolTemperature::getTemperatures(float temperatures[GlycolTemperatureParser::CHANNELS]) {
+    std::lock_guard<std::mutex> guard(_temperature_mutex);
+    memcpy(temperatures, _temperatures, sizeof(_temperatures));
 }
 
 std::string GlycolTemperature::getDataBuffer() {
     std::lock_guard<std::mutex> guard(_temperature_mutex);
-    return _last_processed;
+    return std::string(_parser.last_line());
 }
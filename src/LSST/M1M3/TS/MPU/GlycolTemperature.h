@@ -30,6 +30,8 @@
 #include <cRIO/Thread.h>
 #include <Transports/Transport.h>
 
+#include "MPU/GlycolTemperatureParser.h"
+
 namespace LSST {
 namespace M1M3 {
 namespace TS {
@@ -56,6 +58,13 @@ public:
      */
     std::vector<float> getTemperatures();
 
+    /**
+     * Copy temperatures into provided array. Doesn't allocate memory.
+     *
+     * @param temperatures array to fill with GlycolTemperatureParser::CHANNELS values
+     */
+    void getTemperatures(float temperatures[GlycolTemperatureParser::CHANNELS]);
+
     /**
      * Retrieves last parsed buffer.
      *
@@ -72,10 +81,9 @@ private:
     std::shared_ptr<Transports::Transport> _transport;
 
     std::mutex _temperature_mutex;
-    float _temperatures[8];
+    float _temperatures[GlycolTemperatureParser::CHANNELS];
 
-    std::string _data_buffer;
-    std::string _last_processed;
+    GlycolTemperatureParser _parser;
 };
 
 }  // namespace TS
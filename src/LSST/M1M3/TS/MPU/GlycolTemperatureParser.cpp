@@ -0,0 +1,199 @@
+/*
+ * Allocation free glycol temperature line parser.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#include "MPU/GlycolTemperatureParser.h"
+
+using namespace LSST::M1M3::TS;
+
+static inline bool is_terminator(uint8_t c) { return c == '\r' || c == '\n'; }
+
+GlycolTemperatureParser::GlycolTemperatureParser() { reset(); }
+
+void GlycolTemperatureParser::reset() {
+    frames = 0;
+    partial = 0;
+    garbage = 0;
+    overflows = 0;
+
+    _head = 0;
+    _count = 0;
+    _scanned = 0;
+    _resync = false;
+    _last_line_length = 0;
+}
+
+size_t GlycolTemperatureParser::push(const uint8_t *data, size_t length) {
+    size_t dropped = 0;
+
+    // only the last CAPACITY bytes can be stored
+    if (length > CAPACITY) {
+        dropped += length - CAPACITY;
+        data += length - CAPACITY;
+        length = CAPACITY;
+    }
+
+    if (_count + length > CAPACITY) {
+        size_t overflow = _count + length - CAPACITY;
+        _consume(overflow);
+        dropped += overflow;
+    }
+
+    if (dropped > 0) {
+        overflows += dropped;
+        _resync = true;
+        _scanned = 0;
+    }
+
+    size_t tail = (_head + _count) & MASK;
+    size_t first = std::min(length, CAPACITY - tail);
+    memcpy(_buffer + tail, data, first);
+    memcpy(_buffer, data + first, length - first);
+    _count += length;
+
+    return dropped;
+}
+
+bool GlycolTemperatureParser::next(float temperatures[CHANNELS]) {
+    while (true) {
+        // find line terminator
+        size_t len = _scanned;
+        while (len < _count && !is_terminator(_buffer[(_head + len) & MASK])) {
+            len++;
+        }
+
+        if (len == _count) {
+            _scanned = len;
+            // garbage or too long line, discard what was received so far
+            if (_resync || len > MAX_LINE) {
+                if (_resync == false) {
+                    garbage++;
+                    _resync = true;
+                }
+                _consume(len);
+                _scanned = 0;
+            }
+            return false;
+        }
+
+        _scanned = 0;
+
+        if (_resync || len > MAX_LINE) {
+            if (_resync == false) {
+                garbage++;
+            }
+            _resync = false;
+            _consume(len + 1);
+            continue;
+        }
+
+        // empty line - the \n part of \r\n or consecutive terminators
+        if (len == 0) {
+            _consume(1);
+            continue;
+        }
+
+        size_t first = std::min(len, CAPACITY - _head);
+        memcpy(_line, _buffer + _head, first);
+        memcpy(_line + first, _buffer, len - first);
+        _consume(len + 1);
+
+        // parse into temporary array, so garbage doesn't overwrite the last values
+        float values[CHANNELS];
+        size_t channels = parse_line(_line, _line + len, values);
+        if (channels == 0) {
+            garbage++;
+            continue;
+        }
+        if (channels < CHANNELS) {
+            partial++;
+        }
+
+        memcpy(temperatures, values, sizeof(values));
+        memcpy(_last_line, _line, len);
+        _last_line_length = len;
+        frames++;
+        return true;
+    }
+}
+
+size_t GlycolTemperatureParser::parse_line(const char *begin, const char *end, float temperatures[CHANNELS]) {
+    for (size_t i = 0; i < CHANNELS; i++) {
+        temperatures[i] = NAN;
+    }
+
+    // resynchronize on the first channel
+    const char *p = begin;
+    while (p + 4 <= end && memcmp(p, "C01=", 4) != 0) {
+        p++;
+    }
+
+    size_t i = 0;
+    for (; i < CHANNELS && p < end; i++) {
+        if (i > 0) {
+            if (*p != ',') {
+                break;
+            }
+            p++;
+        }
+        if (p >= end || *p != 'C') {
+            break;
+        }
+        p++;
+
+        unsigned int channel;
+        auto res = std::from_chars(p, end, channel);
+        if (res.ec != std::errc() || channel != i + 1) {
+            break;
+        }
+        p = res.ptr;
+
+        if (p >= end || *p != '=') {
+            break;
+        }
+        p++;
+
+        if (p < end && *p == '+') {
+            p++;
+        }
+
+        float value;
+        auto fres = std::from_chars(p, end, value);
+        if (fres.ec != std::errc()) {
+            break;
+        }
+        p = fres.ptr;
+
+        temperatures[i] = value < 900 ? value : NAN;
+    }
+
+    return i;
+}
+
+void GlycolTemperatureParser::_consume(size_t length) {
+    _head = (_head + length) & MASK;
+    _count -= length;
+}
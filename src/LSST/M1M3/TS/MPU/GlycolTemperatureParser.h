@@ -0,0 +1,158 @@
+/*
+ * Allocation free glycol temperature line parser.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TS_MPU_GLYCOLTEMPERATUREPARSER__
+#define __TS_MPU_GLYCOLTEMPERATUREPARSER__
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Parses glycol temperature sensor output. The sensor sends lines in
+ * C01=0020.0000,C02=0022.0000,...,C08=0011.0000 format, terminated with \r\n
+ * (or bare \r or \n). Received data are stored in a fixed capacity ring
+ * buffer, so the parser never allocates memory. Partial frames are kept until
+ * the rest of the line arrives. Garbage (lines without C01= field, too long
+ * lines, data lost due to buffer overflow) is skipped up to the next line
+ * terminator.
+ */
+class GlycolTemperatureParser {
+public:
+    /**
+     * Ring buffer capacity. Must be power of 2.
+     */
+    static constexpr size_t CAPACITY = 512;
+
+    /**
+     * Maximal accepted line length. Longer lines are discarded.
+     */
+    static constexpr size_t MAX_LINE = 160;
+
+    /**
+     * Number of temperature channels.
+     */
+    static constexpr size_t CHANNELS = 8;
+
+    GlycolTemperatureParser();
+
+    /**
+     * Clear buffer and counters.
+     */
+    void reset();
+
+    /**
+     * Append received data to the buffer. If the buffer is full, the oldest
+     * data are dropped and the parser resynchronizes on the next line
+     * terminator.
+     *
+     * @param data received data
+     * @param length data length
+     *
+     * @return number of bytes dropped from the buffer
+     */
+    size_t push(const uint8_t *data, size_t length);
+
+    /**
+     * Parse next complete line. Empty and garbage lines are skipped.
+     * Channels not present in the line or with value above 900 (sensor not
+     * connected) are set to NaN.
+     *
+     * @param temperatures array of CHANNELS values to fill
+     *
+     * @return true if a line was parsed and temperatures were filled, false if
+     * no complete line is available
+     */
+    bool next(float temperatures[CHANNELS]);
+
+    /**
+     * Number of bytes waiting in the buffer.
+     */
+    size_t size() const { return _count; }
+
+    /**
+     * Returns last successfully parsed line, without the terminator.
+     */
+    std::string_view last_line() const { return std::string_view(_last_line, _last_line_length); }
+
+    /**
+     * Number of successfully parsed lines.
+     */
+    uint64_t frames;
+
+    /**
+     * Number of parsed lines missing some channels.
+     */
+    uint64_t partial;
+
+    /**
+     * Number of lines skipped as garbage.
+     */
+    uint64_t garbage;
+
+    /**
+     * Number of bytes dropped due to buffer overflow.
+     */
+    uint64_t overflows;
+
+    /**
+     * Parse a single line. Leading garbage before C01= is skipped.
+     *
+     * @param begin line start
+     * @param end line end (terminator excluded)
+     * @param temperatures array of CHANNELS values to fill
+     *
+     * @return number of parsed channels, 0 if the line is garbage
+     */
+    static size_t parse_line(const char *begin, const char *end, float temperatures[CHANNELS]);
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be power of 2");
+    static_assert(MAX_LINE < CAPACITY, "MAX_LINE must fit into buffer");
+
+    uint8_t _buffer[CAPACITY];
+    size_t _head;
+    size_t _count;
+
+    // number of already scanned bytes (without a line terminator)
+    size_t _scanned;
+
+    // discard data up to next line terminator
+    bool _resync;
+
+    char _line[MAX_LINE];
+    char _last_line[MAX_LINE];
+    size_t _last_line_length;
+
+    void _consume(size_t length);
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !__TS_MPU_GLYCOLTEMPERATUREPARSER__
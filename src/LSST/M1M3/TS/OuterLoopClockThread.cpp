@@ -39,10 +39,14 @@ using namespace LSST::M1M3::TS;
 void OuterLoopClockThread::run(std::unique_lock<std::mutex> &lock) {
     SPDLOG_INFO("OuterLoopClockThread: Run");
 
+    // Update doesn't hold any state, so a single instance is reused for all
+    // ticks
+    auto update = std::make_shared<Commands::Update>();
+
     while (keepRunning) {
         runCondition.wait_for(lock, 500ms);
         if (Events::SummaryState::instance().active()) {
-            cRIO::ControllerThread::instance().enqueue(std::make_shared<Commands::Update>());
+            cRIO::ControllerThread::instance().enqueue(update);
         }
         Events::Heartbeat::instance().tryToggle();
     }
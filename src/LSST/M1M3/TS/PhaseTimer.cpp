@@ -0,0 +1,67 @@
+/*
+ * Measures duration of (possibly concurrent) startup phases.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include "PhaseTimer.h"
+
+using namespace LSST::M1M3::TS;
+
+static float _seconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<float>(d).count();
+}
+
+PhaseTimer::PhaseTimer(const std::string &name) : _name(name) { _started = std::chrono::steady_clock::now(); }
+
+void PhaseTimer::start(const std::string &phase) {
+    std::lock_guard<std::mutex> lg(_lock);
+    _records.push_back({phase, elapsed(), std::chrono::steady_clock::duration::zero(), false});
+}
+
+void PhaseTimer::stop(const std::string &phase) {
+    std::lock_guard<std::mutex> lg(_lock);
+    for (auto &r : _records) {
+        if (r.phase == phase && r.finished == false) {
+            r.duration = elapsed() - r.offset;
+            r.finished = true;
+            return;
+        }
+    }
+}
+
+std::vector<PhaseTimer::Record> PhaseTimer::records() {
+    std::lock_guard<std::mutex> lg(_lock);
+    return _records;
+}
+
+void PhaseTimer::report() {
+    auto total = elapsed();
+    for (auto &r : records()) {
+        if (r.finished) {
+            SPDLOG_INFO("{} phase {:<20} at {:6.2f} s took {:6.2f} s", _name, r.phase, _seconds(r.offset),
+                        _seconds(r.duration));
+        } else {
+            SPDLOG_INFO("{} phase {:<20} at {:6.2f} s didn't finish", _name, r.phase, _seconds(r.offset));
+        }
+    }
+    SPDLOG_INFO("{} took {:.2f} s", _name, _seconds(total));
+}
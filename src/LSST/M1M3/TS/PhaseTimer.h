@@ -0,0 +1,115 @@
+/*
+ * Measures duration of (possibly concurrent) startup phases.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_PhaseTimer_
+#define _TS_PhaseTimer_
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Measures duration of startup phases. Phases can run concurrently, each
+ * phase records its start offset and duration. The report lists phases in
+ * their start order, so it is apparent which phases overlapped and which
+ * phase dominates the startup time.
+ */
+class PhaseTimer {
+public:
+    /**
+     * Constructs timer, starting its clock.
+     *
+     * @param name name used in the report
+     */
+    PhaseTimer(const std::string &name);
+
+    struct Record {
+        std::string phase;
+        std::chrono::steady_clock::duration offset;
+        std::chrono::steady_clock::duration duration;
+        bool finished;
+    };
+
+    /**
+     * Records phase start.
+     *
+     * @param phase phase name
+     */
+    void start(const std::string &phase);
+
+    /**
+     * Records phase end. Ignored if the phase wasn't started.
+     *
+     * @param phase phase name
+     */
+    void stop(const std::string &phase);
+
+    /**
+     * Measures phase for the lifetime of the object.
+     */
+    class Phase {
+    public:
+        Phase(PhaseTimer &timer, const std::string &phase) : _timer(timer), _phase(phase) {
+            _timer.start(_phase);
+        }
+        ~Phase() { _timer.stop(_phase); }
+
+    private:
+        PhaseTimer &_timer;
+        std::string _phase;
+    };
+
+    /**
+     * Returns recorded phases, in start order.
+     */
+    std::vector<Record> records();
+
+    /**
+     * Returns time elapsed since the timer was constructed.
+     */
+    std::chrono::steady_clock::duration elapsed() const {
+        return std::chrono::steady_clock::now() - _started;
+    }
+
+    /**
+     * Logs phases start offsets and durations, and the total time.
+     */
+    void report();
+
+private:
+    std::string _name;
+    std::chrono::steady_clock::time_point _started;
+
+    std::mutex _lock;
+    std::vector<Record> _records;
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_PhaseTimer_
@@ -0,0 +1,143 @@
+/*
+ * Bounded queue of SAL samples published from a single thread.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+
+#include <spdlog/spdlog.h>
+
+#include "LatencyProbe.h"
+#include "PublishQueue.h"
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+constexpr auto report_interval = std::chrono::seconds(600);
+
+PublishQueue::PublishQueue(token) {
+    _queued = 0;
+    _publishing = false;
+    _next_report = std::chrono::steady_clock::now() + report_interval;
+}
+
+bool PublishQueue::flush(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> ql(_queue_mutex);
+    return _queue_condition.wait_for(ql, timeout, [this] { return _queued == 0 && _publishing == false; });
+}
+
+size_t PublishQueue::depth() {
+    std::lock_guard<std::mutex> lg(_queue_mutex);
+    return _queued;
+}
+
+std::vector<PublishQueue::TopicStatistics> PublishQueue::get_statistics() {
+    std::lock_guard<std::mutex> lg(_queue_mutex);
+    std::vector<TopicStatistics> ret;
+    ret.reserve(_topics.size());
+    for (auto &t : _topics) {
+        ret.push_back({t->name, t->depth, t->high_water, t->published, t->dropped, t->failed});
+    }
+    return ret;
+}
+
+void PublishQueue::run(std::unique_lock<std::mutex> &lock) {
+    // producers notify _queue_condition, the thread lock is held only by stop
+    lock.unlock();
+
+    SPDLOG_INFO("Running SAL publish queue.");
+
+    std::unique_lock<std::mutex> ql(_queue_mutex);
+    while (keepRunning) {
+        _queue_condition.wait_for(ql, 100ms, [this] { return _queued > 0 || keepRunning == false; });
+        _drain(ql);
+        _report();
+    }
+
+    // flush samples queued before the stop request
+    _drain(ql);
+    SPDLOG_INFO("SAL publish queue stopped.");
+
+    ql.unlock();
+    lock.lock();
+}
+
+void PublishQueue::_drain(std::unique_lock<std::mutex> &queue_lock) {
+    while (_queued > 0) {
+        // round robin, so a busy topic cannot starve others
+        for (size_t i = 0; i < _topics.size(); i++) {
+            auto topic = _topics[i].get();
+            if (topic->depth == 0) {
+                continue;
+            }
+
+            topic->pop();
+            _queued--;
+            _publishing = true;
+
+            bool sent = false;
+            queue_lock.unlock();
+            try {
+                salReturn ret = topic->publish(_sal.get());
+                if (ret == SAL__OK) {
+                    sent = true;
+                } else {
+                    SPDLOG_WARN("Cannot send {}: {}", topic->name, ret);
+                }
+            } catch (std::exception &ex) {
+                // log only the first exception in a report interval, _report summarizes the rest
+                if (topic->failed == topic->reported_failed) {
+                    SPDLOG_ERROR("Exception while publishing {}: {}", topic->name, ex.what());
+                }
+            }
+            queue_lock.lock();
+
+            _publishing = false;
+            if (sent) {
+                topic->published++;
+                LatencyProbe::instance().mark(LatencyProbe::PUBLISHED, topic->outgoing_trace);
+            } else {
+                topic->failed++;
+            }
+        }
+        _queue_condition.notify_all();
+    }
+}
+
+void PublishQueue::_report() {
+    auto now = std::chrono::steady_clock::now();
+    if (now < _next_report) {
+        return;
+    }
+    _next_report = now + report_interval;
+
+    for (auto &t : _topics) {
+        if (t->dropped != t->reported_dropped) {
+            SPDLOG_WARN("Publish queue {}: dropped {} samples (total {}), high water {}/{}.", t->name,
+                        t->dropped - t->reported_dropped, t->dropped, t->high_water, DEPTH);
+            t->reported_dropped = t->dropped;
+        }
+        if (t->failed != t->reported_failed) {
+            SPDLOG_WARN("Publish queue {}: failed to publish {} samples (total {}).", t->name,
+                        t->failed - t->reported_failed, t->failed);
+            t->reported_failed = t->failed;
+        }
+    }
+}
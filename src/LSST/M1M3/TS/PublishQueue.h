@@ -0,0 +1,262 @@
+/*
+ * Bounded queue of SAL samples published from a single thread.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_PublishQueue_
+#define _TS_PublishQueue_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <SAL_MTM1M3TS.h>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/Thread.h>
+
+#include "LatencyProbe.h"
+#include "Telemetry/TelemetryHistory.h"
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Describes how samples of a given type are written to DDS. Specializations
+ * shall provide topic name and static put(SAL_MTM1M3TS *, T *) method.
+ */
+template <typename T>
+struct PublishTopic;
+
+#define PUBLISH_TOPIC(sample_type, topic)                            \
+    template <>                                                      \
+    struct PublishTopic<sample_type> {                               \
+        static constexpr const char *name = #topic;                  \
+        static salReturn put(SAL_MTM1M3TS *sal, sample_type *data) { \
+            return sal->putSample_##topic(data);                     \
+        }                                                            \
+    };
+
+PUBLISH_TOPIC(MTM1M3TS_thermalDataC, thermalData)
+PUBLISH_TOPIC(MTM1M3TS_mixingValveC, mixingValve)
+PUBLISH_TOPIC(MTM1M3TS_glycolLoopTemperatureC, glycolLoopTemperature)
+PUBLISH_TOPIC(MTM1M3TS_flowMeterC, flowMeter)
+PUBLISH_TOPIC(MTM1M3TS_glycolPumpC, glycolPump)
+PUBLISH_TOPIC(MTM1M3TS_logevent_heartbeatC, logevent_heartbeat)
+
+/**
+ * Topics without SAL counterpart. Samples are only recorded in the telemetry
+ * history and journal.
+ */
+#define LOCAL_TOPIC(sample_type, topic)                              \
+    template <>                                                      \
+    struct PublishTopic<sample_type> {                               \
+        static constexpr const char *name = #topic;                  \
+        static salReturn put(SAL_MTM1M3TS *, sample_type *) {        \
+            return SAL__OK;                                          \
+        }                                                            \
+    };
+
+LOCAL_TOPIC(Telemetry::ThermalSummary, thermalDataSummary)
+
+/**
+ * Multiple producers, single consumer queue of SAL samples. Producers (the
+ * control loop and MPU threads) only copy sample into a per-topic ring
+ * buffer, putSample is called from the publisher thread. If a topic ring is
+ * full, its oldest sample is dropped - producers never block on DDS. Samples
+ * left in the queue are published when the thread is stopped. Published
+ * samples are recorded in the TelemetryHistory.
+ */
+class PublishQueue final : public cRIO::Thread, public cRIO::Singleton<PublishQueue> {
+public:
+    PublishQueue(token);
+
+    /**
+     * Number of samples queued per topic.
+     */
+    static constexpr size_t DEPTH = 8;
+
+    /**
+     * Per-topic queue statistics.
+     */
+    struct TopicStatistics {
+        const char *name;
+        size_t depth;
+        size_t high_water;
+        uint64_t published;
+        uint64_t dropped;
+        uint64_t failed;
+    };
+
+    /**
+     * Sets SAL used to publish samples. Must be called before the thread is started.
+     */
+    void set_SAL(std::shared_ptr<SAL_MTM1M3TS> sal) { _sal = sal; }
+
+    /**
+     * Copies sample into topic queue. Never blocks on DDS.
+     *
+     * @param sample sample to publish
+     */
+    template <typename T>
+    void enqueue(const T &sample) {
+        auto &topic = _topic<T>();
+        {
+            std::lock_guard<std::mutex> lg(_queue_mutex);
+            if (topic.push(sample, LatencyProbe::current()) == false) {
+                _queued++;
+            }
+        }
+        _queue_condition.notify_all();
+    }
+
+    /**
+     * Waits until all queued samples are published.
+     *
+     * @param timeout maximal time to wait
+     *
+     * @return true if queue was emptied, false on timeout
+     */
+    bool flush(std::chrono::milliseconds timeout);
+
+    /**
+     * Returns number of samples waiting in the queue.
+     */
+    size_t depth();
+
+    std::vector<TopicStatistics> get_statistics();
+
+protected:
+    void run(std::unique_lock<std::mutex> &lock) override;
+
+private:
+    class TopicQueueBase {
+    public:
+        TopicQueueBase(const char *topic_name) : name(topic_name) {}
+        virtual ~TopicQueueBase() {}
+
+        /**
+         * Moves the oldest sample to the outgoing buffer.
+         */
+        virtual void pop() = 0;
+
+        /**
+         * Writes outgoing buffer to DDS.
+         */
+        virtual salReturn publish(SAL_MTM1M3TS *sal) = 0;
+
+        const char *name;
+        size_t depth = 0;
+        size_t high_water = 0;
+        uint64_t published = 0;
+        uint64_t dropped = 0;
+        uint64_t failed = 0;
+        uint64_t reported_dropped = 0;
+        uint64_t reported_failed = 0;
+
+        // latency trace of the outgoing sample
+        int32_t outgoing_trace = 0;
+
+    protected:
+        size_t _head = 0;
+    };
+
+    template <typename T>
+    class TopicQueue final : public TopicQueueBase {
+    public:
+        TopicQueue() : TopicQueueBase(PublishTopic<T>::name) {}
+
+        /**
+         * @param sample sample to queue
+         * @param trace latency trace of the thread producing the sample
+         *
+         * @return true if the oldest sample was dropped
+         */
+        bool push(const T &sample, int32_t trace) {
+            bool drop = depth == DEPTH;
+            if (drop) {
+                _head = (_head + 1) % DEPTH;
+                depth--;
+                dropped++;
+            }
+            _samples[(_head + depth) % DEPTH] = sample;
+            _traces[(_head + depth) % DEPTH] = trace;
+            depth++;
+            if (depth > high_water) {
+                high_water = depth;
+            }
+            return drop;
+        }
+
+        void pop() override {
+            _outgoing = _samples[_head];
+            outgoing_trace = _traces[_head];
+            _head = (_head + 1) % DEPTH;
+            depth--;
+        }
+
+        salReturn publish(SAL_MTM1M3TS *sal) override {
+            // keep local history even when DDS fails
+            Telemetry::TelemetryHistory::instance().record(_outgoing);
+            return PublishTopic<T>::put(sal, &_outgoing);
+        }
+
+    private:
+        T _samples[DEPTH];
+        int32_t _traces[DEPTH];
+        T _outgoing;
+    };
+
+    template <typename T>
+    TopicQueue<T> &_topic() {
+        static TopicQueue<T> *topic = _register(new TopicQueue<T>());
+        return *topic;
+    }
+
+    template <typename Q>
+    Q *_register(Q *topic) {
+        std::lock_guard<std::mutex> lg(_queue_mutex);
+        _topics.emplace_back(topic);
+        return topic;
+    }
+
+    void _drain(std::unique_lock<std::mutex> &queue_lock);
+    void _report();
+
+    std::shared_ptr<SAL_MTM1M3TS> _sal;
+
+    std::mutex _queue_mutex;
+    std::condition_variable _queue_condition;
+    std::vector<std::unique_ptr<TopicQueueBase>> _topics;
+    size_t _queued;
+    bool _publishing;
+
+    std::chrono::steady_clock::time_point _next_report;
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // ! _TS_PublishQueue_
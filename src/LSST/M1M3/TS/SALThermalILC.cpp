@@ -28,13 +28,14 @@
 #include "Events/EnabledILC.h"
 #include "Events/ThermalWarning.h"
 #include "Events/ThermalInfo.h"
+#include "Settings/FcuIdentityCache.h"
 #include "Settings/Thermal.h"
 #include "Telemetry/ThermalData.h"
 
 using namespace LSST::M1M3::TS;
 
 SALThermalILC::SALThermalILC(std::shared_ptr<SAL_MTM1M3TS> m1m3tsSAL)
-        : ILC::ILCBusList(1), cRIO::ThermalILC(1), _m1m3tsSAL(m1m3tsSAL) {}
+        : ILC::ILCBusList(1), cRIO::ThermalILC(1), _m1m3tsSAL(m1m3tsSAL), _mode_sequencer(nullptr) {}
 
 #if 0
 void SALThermalILC::handleMissingReply(uint8_t address, uint8_t func) {
@@ -54,13 +55,21 @@ void SALThermalILC::processServerID(uint8_t address, uint64_t uniqueID, uint8_t
     Events::ThermalInfo::instance().processServerID(address, ilcIndex, uniqueID, ilcAppType, networkNodeType,
                                                     ilcSelectedOptions, networkNodeOptions, majorRev,
                                                     minorRev, firmwareName);
+    Settings::FcuIdentityCache::instance().update(
+            address, {true, uniqueID, ilcAppType, networkNodeType, ilcSelectedOptions, networkNodeOptions,
+                      majorRev, minorRev, firmwareName});
 }
 
 void SALThermalILC::processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) {
     Events::ThermalWarning::instance().update(address, mode, status, faults);
+    Settings::FcuIdentityCache::instance().status(address, mode);
 }
 
-void SALThermalILC::processChangeILCMode(uint8_t address, uint16_t mode) {}
+void SALThermalILC::processChangeILCMode(uint8_t address, uint16_t mode) {
+    if (_mode_sequencer != nullptr) {
+        _mode_sequencer->mode_changed(address, mode);
+    }
+}
 
 void SALThermalILC::processSetTempILCAddress(uint8_t address, uint8_t newAddress) {}
 
@@ -28,6 +28,8 @@
 
 #include <memory>
 
+#include "ILCModeSequencer.h"
+
 namespace LSST {
 namespace M1M3 {
 namespace TS {
@@ -39,6 +41,27 @@ class SALThermalILC : public cRIO::ThermalILC {
 public:
     SALThermalILC(std::shared_ptr<SAL_MTM1M3TS> m1m3tsSAL);
 
+    /**
+     * Sets sequencer receiving mode change responses.
+     *
+     * @param sequencer mode sequencer, nullptr to stop forwarding the responses
+     */
+    void setModeSequencer(ILCModeSequencer *sequencer) { _mode_sequencer = sequencer; }
+
+    /**
+     * Forwards mode change responses to the sequencer during its lifetime.
+     */
+    class SequencerScope {
+    public:
+        SequencerScope(SALThermalILC &ilc, ILCModeSequencer &sequencer) : _ilc(ilc) {
+            _ilc.setModeSequencer(&sequencer);
+        }
+        ~SequencerScope() { _ilc.setModeSequencer(nullptr); }
+
+    private:
+        SALThermalILC &_ilc;
+    };
+
 protected:
     void processServerID(uint8_t address, uint64_t uniqueID, uint8_t ilcAppType, uint8_t networkNodeType,
                          uint8_t ilcSelectedOptions, uint8_t networkNodeOptions, uint8_t majorRev,
@@ -58,6 +81,7 @@ protected:
 
 private:
     std::shared_ptr<SAL_MTM1M3TS> _m1m3tsSAL;
+    ILCModeSequencer *_mode_sequencer;
 
     uint8_t _address2ILCIndex(uint8_t address);
 };
@@ -0,0 +1,146 @@
+/*
+ * Single writer sequence lock.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TS_SEQLOCK__
+#define __TS_SEQLOCK__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+/**
+ * Sequence lock protecting a trivially copyable value. A single writer
+ * publishes new values, any number of readers retrieve consistent copies
+ * without taking a lock. Readers retry if the writer modified the value
+ * during the copy. The value is stored as relaxed atomic words, so the copy
+ * isn't a data race.
+ *
+ * @tparam T stored value type. Must be trivially copyable.
+ */
+template <typename T>
+class SeqLock {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock value must be trivially copyable");
+
+    SeqLock() : _sequence(0) {
+        for (auto &w : _data) {
+            w.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    SeqLock(const T &value) : SeqLock() { store(value); }
+
+    /**
+     * Store new value. Only a single thread can call this method.
+     *
+     * @param value new value
+     */
+    void store(const T &value) {
+        uint64_t words[WORDS] = {0};
+        memcpy(words, &value, sizeof(T));
+
+        auto seq = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            _data[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        _sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Load consistent copy of the stored value. Never blocks the writer.
+     *
+     * @return stored value
+     */
+    T load() const {
+        uint64_t words[WORDS];
+        uint64_t seq1, seq2;
+
+        do {
+            seq1 = _sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++) {
+                words[i] = _data[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq2 = _sequence.load(std::memory_order_relaxed);
+        } while ((seq1 & 1) || seq1 != seq2);
+
+        T ret;
+        memcpy(&ret, words, sizeof(T));
+        return ret;
+    }
+
+    /**
+     * Tries to load consistent copy of the stored value. Useful for readers
+     * which shall not spin forever if the writer died during store (value in
+     * a shared memory).
+     *
+     * @param value loaded value
+     * @param attempts maximal number of attempts
+     *
+     * @return true if consistent value was loaded
+     */
+    bool try_load(T &value, unsigned attempts) const {
+        uint64_t words[WORDS];
+
+        for (unsigned a = 0; a < attempts; a++) {
+            uint64_t seq1 = _sequence.load(std::memory_order_acquire);
+            if (seq1 & 1) {
+                continue;
+            }
+            for (size_t i = 0; i < WORDS; i++) {
+                words[i] = _data[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq1 == _sequence.load(std::memory_order_relaxed)) {
+                memcpy(&value, words, sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns number of completed stores.
+     */
+    uint64_t version() const { return _sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> _sequence;
+    std::atomic<uint64_t> _data[WORDS];
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !__TS_SEQLOCK__
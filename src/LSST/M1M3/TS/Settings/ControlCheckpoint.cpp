@@ -0,0 +1,147 @@
+/*
+ * Warm-restart checkpoint of the controller state.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <yaml-cpp/yaml.h>
+#include <spdlog/spdlog.h>
+
+#include <cRIO/Settings/Path.h>
+
+#include "FilePersister.h"
+#include "Settings/ControlCheckpoint.h"
+
+using namespace LSST::M1M3::TS::Settings;
+
+ControlCheckpoint::ControlCheckpoint(std::string filename, uint32_t max_age) : _max_age(max_age) {
+    file_path = cRIO::Settings::Path::getFilePath("v1/" + filename);
+    glycol_setpoint = NAN;
+    heaters_setpoint = NAN;
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        heater_PWM[i] = 0;
+        fan_RPM[i] = 0;
+    }
+    finer_control_state = -1;
+    mixing_valve_target = NAN;
+    memset(&_date, 0, sizeof(_date));
+    _valid = false;
+}
+
+void ControlCheckpoint::load() {
+    _valid = false;
+
+    try {
+        YAML::Node doc = YAML::LoadFile(file_path);
+
+        auto dat_buf = doc["Date"].as<std::string>();
+        auto end = strptime(dat_buf.c_str(), "%Y-%m-%dT%T", &_date);
+        if (end == nullptr || *end != '\0') {
+            SPDLOG_WARN("Invalid date in checkpoint file {}: '{}'", file_path, dat_buf);
+            return;
+        }
+        _date.tm_isdst = 0;
+
+        if (_is_too_old()) {
+            SPDLOG_INFO("Controller checkpoint {} is too old - {}, MaxAge is {} seconds, ignoring it.",
+                        file_path, dat_buf, _max_age);
+            return;
+        }
+
+        auto setpoints = doc["Setpoints"];
+        glycol_setpoint = setpoints["Glycol"].as<float>(NAN);
+        heaters_setpoint = setpoints["Heaters"].as<float>(NAN);
+
+        auto fcu = doc["FCU"];
+        auto heaters = fcu["HeaterPWM"].as<std::vector<float>>();
+        auto fans = fcu["FanRPM"].as<std::vector<int>>();
+        if (heaters.size() != cRIO::NUM_TS_ILC || fans.size() != cRIO::NUM_TS_ILC) {
+            SPDLOG_WARN("Checkpoint file {} contains {} heaters and {} fans targets, expected {}.", file_path,
+                        heaters.size(), fans.size(), cRIO::NUM_TS_ILC);
+            return;
+        }
+        for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+            heater_PWM[i] = heaters[i];
+            fan_RPM[i] = fans[i];
+        }
+
+        auto mixing_valve = doc["MixingValve"];
+        finer_control_state = mixing_valve["State"].as<int>(-1);
+        mixing_valve_target = mixing_valve["Target"].as<float>(NAN);
+
+        if (std::isnan(glycol_setpoint) || std::isnan(heaters_setpoint)) {
+            SPDLOG_INFO("Checkpoint file {} doesn't contain valid setpoints, ignoring it.", file_path);
+            return;
+        }
+
+        _valid = true;
+        SPDLOG_INFO("Loaded controller checkpoint from {} recorded at {} for {:+.2f}°C/{:+.2f}°C setpoints.",
+                    file_path, dat_buf, glycol_setpoint, heaters_setpoint);
+    } catch (YAML::Exception &ex) {
+        SPDLOG_WARN("Cannot load controller checkpoint from {}:{}:{} (line, column): {}", file_path,
+                    ex.mark.line, ex.mark.column, ex.what());
+    }
+}
+
+void ControlCheckpoint::save() {
+    auto now = time(nullptr);
+
+    gmtime_r(&now, &_date);
+    _valid = true;
+
+    // copy of the values is serialized on the persister thread
+    FilePersister::instance().persist(file_path, [copy = *this]() { return copy._serialize(); });
+}
+
+std::string ControlCheckpoint::_serialize() const {
+    YAML::Node doc, setpoints, fcu, mixing_valve;
+
+    char dat_buf[80];
+    strftime(dat_buf, 80, "%FT%T", &_date);
+
+    doc["Date"] = dat_buf;
+
+    setpoints["Glycol"] = glycol_setpoint;
+    setpoints["Heaters"] = heaters_setpoint;
+    doc["Setpoints"] = setpoints;
+
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        fcu["HeaterPWM"].push_back(heater_PWM[i]);
+        fcu["FanRPM"].push_back(fan_RPM[i]);
+    }
+    fcu["HeaterPWM"].SetStyle(YAML::EmitterStyle::Flow);
+    fcu["FanRPM"].SetStyle(YAML::EmitterStyle::Flow);
+    doc["FCU"] = fcu;
+
+    mixing_valve["State"] = finer_control_state;
+    mixing_valve["Target"] = mixing_valve_target;
+    doc["MixingValve"] = mixing_valve;
+
+    return YAML::Dump(doc) + "\n";
+}
+
+bool ControlCheckpoint::_is_too_old() {
+    auto now = time(nullptr);
+    time_t recorded_date = timegm(&_date);
+
+    auto diff = difftime(now, recorded_date);
+    return diff > _max_age || diff < -1;
+}
@@ -0,0 +1,101 @@
+/*
+ * Warm-restart checkpoint of the controller state.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Settings_ControlCheckpoint_h
+#define _TS_Settings_ControlCheckpoint_h
+
+#include <string>
+#include <time.h>
+
+#include <cRIO/ThermalILC.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Settings {
+
+/***
+ * Checkpoint of the controller state, used for warm restarts. Stores FCU
+ * heaters and fans targets, mixing valve target and the setpoints the state
+ * was recorded for in a yaml file next to the saved setpoints. The file is
+ * written by the FilePersister, so a crash during write never leaves a
+ * partial checkpoint behind.
+ */
+class ControlCheckpoint {
+public:
+    /***
+     * Constructs checkpoint instance.
+     *
+     * @param filename file where the checkpoint is saved
+     * @param max_age maximal age of the checkpoint, in seconds, to be
+     * considered valid
+     */
+    ControlCheckpoint(std::string filename, uint32_t max_age);
+
+    /***
+     * Loads checkpoint from the file. Invalidates the checkpoint if the file
+     * cannot be read, or is older than max_age.
+     */
+    void load();
+
+    /***
+     * Saves current values into the checkpoint file. The file is written
+     * asynchronously by the FilePersister.
+     */
+    void save();
+
+    /***
+     * Returns true if valid, not too old checkpoint was loaded or saved.
+     */
+    bool is_valid() { return _valid && _is_too_old() == false; }
+
+    struct tm date() { return _date; }
+
+    uint32_t max_age() { return _max_age; }
+
+    std::string file_path;
+
+    float glycol_setpoint;
+    float heaters_setpoint;
+
+    float heater_PWM[cRIO::NUM_TS_ILC];
+    int fan_RPM[cRIO::NUM_TS_ILC];
+
+    int finer_control_state;
+    float mixing_valve_target;
+
+private:
+    uint32_t _max_age;
+    struct tm _date;
+    bool _valid;
+
+    bool _is_too_old();
+
+    std::string _serialize() const;
+};
+
+}  // namespace Settings
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  //! _TS_Settings_ControlCheckpoint_h
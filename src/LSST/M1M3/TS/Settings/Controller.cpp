@@ -21,40 +21,84 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <fmt/ranges.h>
 #include <spdlog/spdlog.h>
 #include <yaml-cpp/yaml.h>
 
 #include "Settings/AirNozzles.h"
 #include "Settings/Controller.h"
+#include "Settings/FcuAnomaly.h"
 #include "Settings/FlowMeter.h"
 #include "Settings/GlycolPump.h"
 #include "Settings/Heaters.h"
+#include "Settings/Journal.h"
 #include "Settings/MixingValve.h"
 #include "Settings/SavedSetpoints.h"
 #include "Settings/Setpoint.h"
 #include "Settings/Thermal.h"
+#include "Settings/TelemetryHistory.h"
+#include "Settings/ThermalDataPublish.h"
+#include "Settings/ThermalStatistics.h"
 
 using namespace LSST::M1M3::TS::Settings;
 
-Controller::Controller(token) {}
+Controller::Controller(token)
+        : _sections({
+                  {"FlowMeter", [](YAML::Node doc) { FlowMeter::instance().load(doc); }},
+                  {"GlycolPump", [](YAML::Node doc) { GlycolPump::instance().load(doc); }},
+                  {"MixingValve", [](YAML::Node doc) { MixingValve::instance().load(doc); }},
+                  {"Heaters", [](YAML::Node doc) { Heaters::instance().load(doc); }},
+                  {"Setpoint", [](YAML::Node doc) { Setpoint::instance().load(doc); }},
+                  {"FCU", [](YAML::Node doc) { Thermal::instance().load(doc); }},
+                  {"ThermalDataPublish", [](YAML::Node doc) { ThermalDataPublish::instance().load(doc); }},
+                  {"ThermalStatistics", [](YAML::Node doc) { ThermalStatistics::instance().load(doc); }},
+                  {"FcuAnomaly", [](YAML::Node doc) { FcuAnomaly::instance().load(doc); }},
+                  {"TelemetryHistory", [](YAML::Node doc) { TelemetryHistory::instance().load(doc); }},
+                  {"Journal", [](YAML::Node doc) { Journal::instance().load(doc); }},
+          }) {}
 
 void Controller::load(const std::string &configuration_override) {
+    _load(false);
+    // start from fresh PIDs, reload keeps their state
+    Heaters::instance().reset_FCU_PIDs();
+    AirNozzles::instance().load("AirNozzles.csv");
+}
+
+std::vector<std::string> Controller::reload() {
+    auto changed = _load(true);
+    if (changed.empty()) {
+        SPDLOG_INFO("Configuration wasn't changed.");
+    } else {
+        SPDLOG_INFO("Reloaded configuration sections: {}.", fmt::join(changed, ", "));
+    }
+    return changed;
+}
+
+std::vector<std::string> Controller::_load(bool changed_only) {
     std::string filename = cRIO::Settings::Path::getFilePath("v1/_init.yaml");
     SPDLOG_INFO("Using configuration file \"{}\"", filename);
+    std::vector<std::string> changed;
     try {
         YAML::Node doc = YAML::LoadFile(filename);
 
-        FlowMeter::instance().load(doc["FlowMeter"]);
-        GlycolPump::instance().load(doc["GlycolPump"]);
-        MixingValve::instance().load(doc["MixingValve"]);
-        Heaters::instance().load(doc["Heaters"]);
-        Setpoint::instance().load(doc["Setpoint"]);
-        Thermal::instance().load(doc["FCU"]);
-        AirNozzles::instance().load("AirNozzles.csv");
+        for (auto &section : _sections) {
+            auto node = doc[section.first];
+            auto content = YAML::Dump(node);
+            if (changed_only) {
+                auto loaded = _loaded.find(section.first);
+                if (loaded != _loaded.end() && loaded->second == content) {
+                    continue;
+                }
+            }
+            section.second(node);
+            _loaded[section.first] = content;
+            changed.push_back(section.first);
+        }
     } catch (YAML::Exception &ex) {
         auto msg = fmt::format("YAML Loading {}:{}:{} (line, column): {}", filename, ex.mark.line,
                                ex.mark.column, ex.what());
         SPDLOG_ERROR(msg);
         throw std::runtime_error(msg);
     }
+    return changed;
 }
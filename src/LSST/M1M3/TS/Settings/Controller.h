@@ -24,6 +24,13 @@
 #ifndef _TS_Settings_Controller_h
 #define _TS_Settings_Controller_h
 
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
 #include <cRIO/Settings/Path.h>
 #include <cRIO/Singleton.h>
 
@@ -40,6 +47,32 @@ public:
     Controller(token);
 
     void load(const std::string &configuration_override);
+
+    /**
+     * Reloads configuration file. Only sections which changed since the last
+     * load are applied, so running control loops of unchanged sections
+     * aren't disturbed. AirNozzles.csv is loaded only by load.
+     *
+     * @return names of changed sections
+     *
+     * @throw std::runtime_error when the configuration cannot be loaded
+     */
+    std::vector<std::string> reload();
+
+private:
+    std::vector<std::string> _load(bool changed_only);
+
+    typedef std::function<void(YAML::Node)> section_load_t;
+
+    /**
+     * Configuration sections, in load order.
+     */
+    const std::vector<std::pair<std::string, section_load_t>> _sections;
+
+    /**
+     * Last loaded sections content, used to find changed sections.
+     */
+    std::map<std::string, std::string> _loaded;
 };
 
 }  // namespace Settings
@@ -0,0 +1,70 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include <Settings/FcuAnomaly.h>
+
+using namespace LSST::M1M3::TS::Settings;
+
+FcuAnomaly::FcuAnomaly(token) {
+    enabled = false;
+    smoothing = 0.1;
+    persistence = 20;
+    fanMinTarget = 200;
+    fanTolerance = 0.2;
+    heaterMinPWM = 50;
+    heaterMinResponse = 0.5;
+    rtdMaxDeviation = 3;
+}
+
+void FcuAnomaly::load(YAML::Node doc) {
+    SPDLOG_INFO("Loading FCU anomaly detection settings.");
+
+    enabled = doc["Enabled"].as<bool>();
+
+    smoothing = doc["Smoothing"].as<float>();
+    if (!(smoothing > 0 && smoothing <= 1)) {
+        throw std::runtime_error(
+                fmt::format("FcuAnomaly/Smoothing shall be in (0, 1] range, is {:.3f}.", smoothing));
+    }
+
+    persistence = doc["Persistence"].as<int>();
+    if (persistence < 1) {
+        throw std::runtime_error(fmt::format("FcuAnomaly/Persistence shall be positive, is {}.", persistence));
+    }
+
+    auto fan = doc["Fan"];
+    fanMinTarget = fan["MinTarget"].as<int>();
+    fanTolerance = fan["Tolerance"].as<float>();
+
+    auto heater = doc["Heater"];
+    heaterMinPWM = heater["MinPWM"].as<float>();
+    heaterMinResponse = heater["MinResponse"].as<float>();
+
+    rtdMaxDeviation = doc["RTD"]["MaxDeviation"].as<float>();
+
+    if (fanTolerance <= 0 || rtdMaxDeviation <= 0) {
+        throw std::runtime_error("FcuAnomaly/Fan/Tolerance and FcuAnomaly/RTD/MaxDeviation shall be positive.");
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Settings_FcuAnomaly_h
+#define _TS_Settings_FcuAnomaly_h
+
+#include <yaml-cpp/yaml.h>
+
+#include <cRIO/Singleton.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Settings {
+
+/***
+ * Thresholds of the FCU anomaly detection.
+ */
+class FcuAnomaly : public cRIO::Singleton<FcuAnomaly> {
+public:
+    FcuAnomaly(token);
+
+    void load(YAML::Node doc);
+
+    bool enabled;
+
+    /***
+     * Weight of a new sample in exponentially weighted averages, (0, 1].
+     */
+    float smoothing;
+
+    /***
+     * Number of consecutive samples a condition must hold to raise or clear
+     * an anomaly.
+     */
+    int persistence;
+
+    /***
+     * Fans commanded below this RPM aren't checked.
+     */
+    int fanMinTarget;
+
+    /***
+     * Maximal relative difference between measured and commanded fan RPM.
+     */
+    float fanTolerance;
+
+    /***
+     * Heaters commanded below this PWM (%) aren't checked.
+     */
+    float heaterMinPWM;
+
+    /***
+     * Minimal differential temperature (degC) of a heating FCU.
+     */
+    float heaterMinResponse;
+
+    /***
+     * Maximal deviation (degC) of FCU absolute temperature from the mean of
+     * all FCUs.
+     */
+    float rtdMaxDeviation;
+};
+
+}  // namespace Settings
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  //!_TS_Settings_FcuAnomaly_h
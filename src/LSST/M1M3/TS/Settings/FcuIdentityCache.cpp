@@ -0,0 +1,288 @@
+/*
+ * Persistent cache of FCU ILCs identities.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include <cRIO/Settings/Path.h>
+
+#include "Events/ThermalInfo.h"
+#include "FilePersister.h"
+#include "Settings/FcuIdentityCache.h"
+
+using namespace LSST::M1M3::TS::Settings;
+
+FcuIdentityCache::FcuIdentityCache(token) {
+    _enabled = false;
+    _max_age = 0;
+    _refresh_count = 0;
+    _refresh_start = 0;
+    _changed = false;
+    _cached = 0;
+    _unconfirmed = 0;
+    _invalidate(0);
+}
+
+void FcuIdentityCache::load(YAML::Node doc) {
+    std::lock_guard<std::mutex> lg(_lock);
+
+    if (!doc) {
+        SPDLOG_INFO("FCU identity cache isn't configured, FCU ILCs will always be fully discovered.");
+        _enabled = false;
+        return;
+    }
+
+    auto new_path = cRIO::Settings::Path::getFilePath("v1/" + doc["Filename"].as<std::string>());
+    auto new_max_age = doc["MaxAge"].as<uint32_t>();
+    _refresh_count = std::clamp(doc["RefreshCount"].as<int>(0), 0, cRIO::NUM_TS_ILC);
+
+    // keep identities discovered since the cache was loaded
+    if (_enabled && new_path == file_path && new_max_age == _max_age) {
+        return;
+    }
+
+    file_path = new_path;
+    _max_age = new_max_age;
+    _enabled = true;
+
+    _load_file();
+}
+
+void FcuIdentityCache::disable() {
+    std::lock_guard<std::mutex> lg(_lock);
+    _enabled = false;
+}
+
+void FcuIdentityCache::request_identity(cRIO::ThermalILC &ilc, uint8_t address, uint8_t expected_mode) {
+    std::lock_guard<std::mutex> lg(_lock);
+
+    int i = address - 1;
+    auto &identity = _identities[i];
+
+    // previous round wasn't applied - the bus transaction failed before the ILC confirmed its identity
+    if (_polled[i] && _verified[i] == false) {
+        identity.known = false;
+    }
+
+    bool refresh = (i - _refresh_start + cRIO::NUM_TS_ILC) % cRIO::NUM_TS_ILC < _refresh_count;
+
+    _polled[i] = _enabled && identity.known && refresh == false;
+    _verified[i] = false;
+    _expected_mode[i] = expected_mode;
+    if (_polled[i]) {
+        ilc.reportServerStatus(address);
+    } else {
+        ilc.reportServerID(address);
+    }
+}
+
+void FcuIdentityCache::status(uint8_t address, uint8_t mode) {
+    std::lock_guard<std::mutex> lg(_lock);
+
+    int i = address - 1;
+    if (_polled[i] == false || _verified[i]) {
+        return;
+    }
+
+    if (mode != _expected_mode[i]) {
+        SPDLOG_WARN("FCU ILC {} reported mode {}, expected {}. It will be fully discovered.", address, mode,
+                    _expected_mode[i]);
+        return;
+    }
+
+    _verified[i] = true;
+}
+
+void FcuIdentityCache::update(uint8_t address, const Identity &identity) {
+    std::lock_guard<std::mutex> lg(_lock);
+
+    auto &cached = _identities[address - 1];
+    _polled[address - 1] = false;
+    _verified[address - 1] = false;
+
+    if (cached.known && cached.uniqueID == identity.uniqueID && cached.majorRev == identity.majorRev &&
+        cached.minorRev == identity.minorRev && cached.firmwareName == identity.firmwareName) {
+        return;
+    }
+
+    if (cached.known) {
+        SPDLOG_INFO("FCU ILC {} identity changed - unique ID {:012X}, firmware {} {}.{}", address,
+                    identity.uniqueID, identity.firmwareName, identity.majorRev, identity.minorRev);
+    }
+
+    cached = identity;
+    cached.known = true;
+    _changed = true;
+}
+
+void FcuIdentityCache::apply() {
+    std::lock_guard<std::mutex> lg(_lock);
+
+    _cached = 0;
+    _unconfirmed = 0;
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        if (_polled[i] == false) {
+            continue;
+        }
+        _polled[i] = false;
+
+        if (_verified[i] == false) {
+            _identities[i].known = false;
+            _unconfirmed++;
+            continue;
+        }
+        _verified[i] = false;
+        _cached++;
+
+        auto &identity = _identities[i];
+        Events::ThermalInfo::instance().processServerID(
+                i + 1, i, identity.uniqueID, identity.ilcAppType, identity.networkNodeType,
+                identity.ilcSelectedOptions, identity.networkNodeOptions, identity.majorRev,
+                identity.minorRev, identity.firmwareName);
+    }
+
+    if (_cached > 0) {
+        SPDLOG_DEBUG("Used {} cached FCU ILC identities.", _cached);
+    }
+    if (_unconfirmed > 0) {
+        SPDLOG_WARN("{} FCU ILCs didn't confirm their cached identity, they will be fully discovered.",
+                    _unconfirmed);
+    }
+
+    _refresh_start = (_refresh_start + _refresh_count) % cRIO::NUM_TS_ILC;
+
+    if (_enabled && _changed) {
+        _changed = false;
+        FilePersister::instance().persist(file_path, [content = _serialize()]() { return content; });
+    }
+}
+
+void FcuIdentityCache::invalidate(uint8_t address) {
+    std::lock_guard<std::mutex> lg(_lock);
+    _invalidate(address);
+}
+
+FcuIdentityCache::Identity FcuIdentityCache::get(uint8_t address) {
+    std::lock_guard<std::mutex> lg(_lock);
+    return _identities[address - 1];
+}
+
+void FcuIdentityCache::_invalidate(uint8_t address) {
+    if (address == 0) {
+        for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+            _identities[i].known = false;
+            _polled[i] = false;
+            _verified[i] = false;
+        }
+        return;
+    }
+    _identities[address - 1].known = false;
+    _polled[address - 1] = false;
+    _verified[address - 1] = false;
+}
+
+void FcuIdentityCache::_load_file() {
+    _invalidate(0);
+
+    try {
+        YAML::Node doc = YAML::LoadFile(file_path);
+
+        struct tm date;
+        memset(&date, 0, sizeof(date));
+
+        auto dat_buf = doc["Date"].as<std::string>();
+        auto end = strptime(dat_buf.c_str(), "%Y-%m-%dT%T", &date);
+        if (end == nullptr || *end != '\0') {
+            SPDLOG_WARN("Invalid date in FCU identity cache {}: '{}'", file_path, dat_buf);
+            return;
+        }
+        date.tm_isdst = 0;
+
+        auto diff = difftime(time(nullptr), timegm(&date));
+        if (diff > _max_age || diff < -1) {
+            SPDLOG_INFO("FCU identity cache {} is too old - {}, MaxAge is {} seconds, FCU ILCs will be fully "
+                        "discovered.",
+                        file_path, dat_buf, _max_age);
+            return;
+        }
+
+        int loaded = 0;
+        for (auto ilc : doc["ILCs"]) {
+            auto address = ilc["Address"].as<int>();
+            if (address < 1 || address > cRIO::NUM_TS_ILC) {
+                SPDLOG_WARN("Invalid FCU ILC address in identity cache {}: {}", file_path, address);
+                continue;
+            }
+            auto &identity = _identities[address - 1];
+            identity.uniqueID = ilc["UniqueID"].as<uint64_t>();
+            identity.ilcAppType = ilc["ILCAppType"].as<int>();
+            identity.networkNodeType = ilc["NetworkNodeType"].as<int>();
+            identity.ilcSelectedOptions = ilc["ILCSelectedOptions"].as<int>();
+            identity.networkNodeOptions = ilc["NetworkNodeOptions"].as<int>();
+            identity.majorRev = ilc["MajorRev"].as<int>();
+            identity.minorRev = ilc["MinorRev"].as<int>();
+            identity.firmwareName = ilc["FirmwareName"].as<std::string>();
+            identity.known = true;
+            loaded++;
+        }
+
+        SPDLOG_INFO("Loaded {} FCU ILC identities from {} recorded at {}.", loaded, file_path, dat_buf);
+    } catch (YAML::Exception &ex) {
+        _invalidate(0);
+        SPDLOG_WARN("Cannot load FCU identity cache from {}:{}:{} (line, column): {}", file_path,
+                    ex.mark.line, ex.mark.column, ex.what());
+    }
+}
+
+std::string FcuIdentityCache::_serialize() {
+    YAML::Node doc;
+
+    char dat_buf[80];
+    auto now = time(nullptr);
+    struct tm date;
+    gmtime_r(&now, &date);
+    strftime(dat_buf, 80, "%FT%T", &date);
+
+    doc["Date"] = dat_buf;
+
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        auto &identity = _identities[i];
+        if (identity.known == false) {
+            continue;
+        }
+        YAML::Node ilc;
+        ilc["Address"] = i + 1;
+        ilc["UniqueID"] = identity.uniqueID;
+        ilc["ILCAppType"] = static_cast<int>(identity.ilcAppType);
+        ilc["NetworkNodeType"] = static_cast<int>(identity.networkNodeType);
+        ilc["ILCSelectedOptions"] = static_cast<int>(identity.ilcSelectedOptions);
+        ilc["NetworkNodeOptions"] = static_cast<int>(identity.networkNodeOptions);
+        ilc["MajorRev"] = static_cast<int>(identity.majorRev);
+        ilc["MinorRev"] = static_cast<int>(identity.minorRev);
+        ilc["FirmwareName"] = identity.firmwareName;
+        doc["ILCs"].push_back(ilc);
+    }
+
+    return YAML::Dump(doc) + "\n";
+}
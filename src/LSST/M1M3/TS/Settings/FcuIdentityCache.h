@@ -0,0 +1,172 @@
+/*
+ * Persistent cache of FCU ILCs identities.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Settings_FcuIdentityCache_h
+#define _TS_Settings_FcuIdentityCache_h
+
+#include <mutex>
+#include <string>
+#include <time.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/ThermalILC.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Settings {
+
+/**
+ * Cache of FCU ILCs identities (ServerID responses), persisted in a yaml
+ * file. ServerID responses carry firmware names and are the largest frames
+ * on the bus. ILCs with cached identity are only polled for their status on
+ * start and bus recovery, the identity is then taken from the cache if the
+ * ILC replied in the expected mode. ILCs which didn't reply, or replied in
+ * an unexpected mode, are fully discovered on the next request. Full
+ * discovery is also done for unknown addresses, and for all addresses if the
+ * cache is older than IdentityCache/MaxAge.
+ *
+ * The status response doesn't contain the ILC unique ID. To detect replaced
+ * ILCs, IdentityCache/RefreshCount ILCs with cached identity are asked for
+ * their ServerID in every request round, rotating over all addresses.
+ */
+class FcuIdentityCache : public cRIO::Singleton<FcuIdentityCache> {
+public:
+    FcuIdentityCache(token);
+
+    struct Identity {
+        bool known;
+        uint64_t uniqueID;
+        uint8_t ilcAppType;
+        uint8_t networkNodeType;
+        uint8_t ilcSelectedOptions;
+        uint8_t networkNodeOptions;
+        uint8_t majorRev;
+        uint8_t minorRev;
+        std::string firmwareName;
+    };
+
+    /**
+     * Loads cache settings and the cache file.
+     *
+     * @param doc FCU/IdentityCache configuration node
+     */
+    void load(YAML::Node doc);
+
+    /**
+     * Disables the cache - full discovery is always done.
+     */
+    void disable();
+
+    /**
+     * Queues identity request for the ILC. ILCs with cached identity are
+     * asked for their status, others (and ILCs in the refresh window) for
+     * their ServerID.
+     *
+     * @param ilc ILC bus
+     * @param address ILC address
+     * @param expected_mode mode the ILC shall report in its status
+     */
+    void request_identity(cRIO::ThermalILC &ilc, uint8_t address, uint8_t expected_mode);
+
+    /**
+     * Records status response. Verifies cached identity of polled ILC.
+     *
+     * @param address ILC address
+     * @param mode reported ILC mode
+     */
+    void status(uint8_t address, uint8_t mode);
+
+    /**
+     * Records identity received in ServerID response.
+     *
+     * @param address ILC address
+     * @param identity received identity
+     */
+    void update(uint8_t address, const Identity &identity);
+
+    /**
+     * Passes cached identities of ILCs which confirmed them by their status
+     * to ThermalInfo, and persists the cache if any identity changed. Polled
+     * ILCs which didn't confirm their identity are scheduled for full
+     * discovery. Shall be called after the bus transaction with requests
+     * queued by request_identity.
+     */
+    void apply();
+
+    /**
+     * Forgets cached identity, the ILC will be fully discovered on the next
+     * request.
+     *
+     * @param address ILC address, 0 to forget all identities
+     */
+    void invalidate(uint8_t address = 0);
+
+    /**
+     * Returns cached identity.
+     *
+     * @param address ILC address
+     */
+    Identity get(uint8_t address);
+
+    /**
+     * Returns number of identities taken from the cache by the last apply.
+     */
+    int cached() { return _cached; }
+
+    /**
+     * Returns number of polled ILCs which didn't confirm their identity in
+     * the last apply.
+     */
+    int unconfirmed() { return _unconfirmed; }
+
+    std::string file_path;
+
+private:
+    void _invalidate(uint8_t address);
+    void _load_file();
+    std::string _serialize();
+
+    std::mutex _lock;
+
+    bool _enabled;
+    uint32_t _max_age;
+    int _refresh_count;
+    int _refresh_start;
+
+    Identity _identities[cRIO::NUM_TS_ILC];
+    bool _polled[cRIO::NUM_TS_ILC];
+    bool _verified[cRIO::NUM_TS_ILC];
+    uint8_t _expected_mode[cRIO::NUM_TS_ILC];
+    bool _changed;
+    int _cached;
+    int _unconfirmed;
+};
+
+}  // namespace Settings
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  //! _TS_Settings_FcuIdentityCache_h
@@ -29,6 +29,10 @@
 
 using namespace LSST::M1M3::TS::Settings;
 
+static bool _pid_changed(const LSST::PID::PIDParameters &p1, const LSST::PID::PIDParameters &p2) {
+    return p1.timestep != p2.timestep || p1.P != p2.P || p1.I != p2.I || p1.D != p2.D || p1.N != p2.N;
+}
+
 Heaters::Heaters(token) { memset(heaters_PID, 0, sizeof(heaters_PID)); }
 
 Heaters::~Heaters() {
@@ -56,20 +60,37 @@ void Heaters::load(YAML::Node doc) {
         fcu_pid.emplace(fcu_specific.second["Address"].as<int>() - 1, PID::PIDParameters(fcu_params));
     }
 
+    int updated = 0;
+
     for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
-        delete heaters_PID[i];
-        try {
-            heaters_PID[i] = new PID::LimitedPID(fcu_pid.at(i), 0, 255);
+        PID::PIDParameters params = default_params;
+        auto custom = fcu_pid.find(i);
+        if (custom != fcu_pid.end()) {
+            params = custom->second;
             SPDLOG_DEBUG("FCU heaters custom PID {} - timestep: {} P: {} I: {} D: {} N: {}", i + 1,
-                         fcu_pid[i].timestep, fcu_pid[i].P, fcu_pid[i].I, fcu_pid[i].D, fcu_pid[i].N);
-        } catch (std::out_of_range &ex) {
-            heaters_PID[i] = new PID::LimitedPID(default_params, 0, 255);
+                         params.timestep, params.P, params.I, params.D, params.N);
         }
+
+        if (heaters_PID[i] == nullptr) {
+            heaters_PID[i] = new PID::LimitedPID(params, 0, 255);
+        } else if (_pid_changed(_pid_parameters[i], params)) {
+            heaters_PID[i]->updateParameters(params);
+            updated++;
+        }
+        _pid_parameters[i] = params;
+    }
+
+    if (updated > 0) {
+        SPDLOG_INFO("Updated {} FCU heaters PID parameters.", updated);
     }
     interval = doc["Interval"].as<float>();
     if (interval <= 0) {
         throw std::runtime_error("Heaters/Interval must be greater than 0");
     }
+    temperatureMaxAge = doc["TemperatureMaxAge"].as<float>();
+    if (temperatureMaxAge <= 0) {
+        throw std::runtime_error("Heaters/TemperatureMaxAge must be greater than 0");
+    }
 }
 
 void Heaters::reset_FCU_PIDs() {
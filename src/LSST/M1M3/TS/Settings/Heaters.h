@@ -42,6 +42,12 @@ public:
     Heaters(token);
     ~Heaters();
 
+    /***
+     * Loads heaters settings. Existing PIDs are kept, only PIDs with changed
+     * parameters are updated, so their state is preserved.
+     *
+     * @param doc Heaters configuration section
+     */
     void load(YAML::Node doc);
 
     void reset_FCU_PIDs();
@@ -49,6 +55,15 @@ public:
     PID::LimitedPID *heaters_PID[cRIO::NUM_TS_ILC];
 
     float interval;
+
+    /***
+     * Maximal age of FCU temperature measurement in seconds. Heaters of FCUs
+     * with older measurements are switched off.
+     */
+    float temperatureMaxAge;
+
+private:
+    PID::PIDParameters _pid_parameters[cRIO::NUM_TS_ILC];
 };
 
 }  // namespace Settings
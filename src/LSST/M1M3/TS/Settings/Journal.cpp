@@ -0,0 +1,59 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include <Settings/Journal.h>
+
+using namespace LSST::M1M3::TS::Settings;
+
+Journal::Journal(token) {
+    enabled = false;
+    fileSize = 0;
+    rotationInterval = 0;
+    keep = 0;
+}
+
+void Journal::load(YAML::Node doc) {
+    SPDLOG_INFO("Loading telemetry journal settings.");
+
+    enabled = doc["Enabled"].as<bool>();
+    directory = doc["Directory"].as<std::string>();
+
+    auto size = doc["FileSize"].as<float>();
+    if (size < 1 || size > 1024) {
+        throw std::runtime_error(
+                fmt::format("Journal/FileSize shall be between 1 and 1024 MB, is {:.1f}.", size));
+    }
+    fileSize = size * 1024 * 1024;
+
+    rotationInterval = doc["RotationInterval"].as<float>() * 3600;
+    if (rotationInterval <= 0) {
+        throw std::runtime_error("Journal/RotationInterval shall be positive.");
+    }
+
+    keep = doc["Keep"].as<int>();
+    if (keep < 1) {
+        throw std::runtime_error(fmt::format("Journal/Keep shall be at least 1, is {}.", keep));
+    }
+}
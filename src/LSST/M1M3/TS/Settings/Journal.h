@@ -0,0 +1,78 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Settings_Journal_h
+#define _TS_Settings_Journal_h
+
+#include <string>
+
+#include <yaml-cpp/yaml.h>
+
+#include <cRIO/Singleton.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Settings {
+
+/***
+ * On-disk telemetry journal settings.
+ */
+class Journal : public cRIO::Singleton<Journal> {
+public:
+    Journal(token);
+
+    void load(YAML::Node doc);
+
+    /***
+     * True if published telemetry shall be journaled.
+     */
+    bool enabled;
+
+    /***
+     * Directory holding journal files.
+     */
+    std::string directory;
+
+    /***
+     * Size of a single journal file, in bytes. The file is preallocated.
+     */
+    size_t fileSize;
+
+    /***
+     * Maximal time span of a single journal file, in seconds.
+     */
+    float rotationInterval;
+
+    /***
+     * Number of journal files kept per topic. Older files are removed.
+     */
+    int keep;
+};
+
+}  // namespace Settings
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  //!_TS_Settings_Journal_h
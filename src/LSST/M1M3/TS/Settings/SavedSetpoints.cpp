@@ -21,8 +21,6 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <iomanip>
-#include <fstream>
 #include <time.h>
 
 #include <yaml-cpp/yaml.h>
@@ -30,6 +28,7 @@
 
 #include <cRIO/Settings/Path.h>
 
+#include "FilePersister.h"
 #include "Settings/SavedSetpoints.h"
 #include "Settings/Setpoint.h"
 
@@ -75,34 +74,31 @@ void SavedSetpoints::load() {
 }
 
 void SavedSetpoints::save(float glycol, float heaters) {
-    YAML::Node doc, setpoints;
-
     auto now = time(nullptr);
 
     gmtime_r(&now, &_date);
-    char dat_buf[80];
-    strftime(dat_buf, 80, "%FT%T", &_date);
 
-    doc["Date"] = dat_buf;
+    _glycol = glycol;
+    _heaters = heaters;
 
-    setpoints["Glycol"] = glycol;
-    setpoints["Heaters"] = heaters;
+    // only values are copied, serialization and I/O run on the persister thread
+    FilePersister::instance().persist(file_path, [now, glycol, heaters]() -> std::string {
+        YAML::Node doc, setpoints;
 
-    doc["Setpoints"] = setpoints;
+        struct tm date;
+        gmtime_r(&now, &date);
+        char dat_buf[80];
+        strftime(dat_buf, 80, "%FT%T", &date);
 
-    try {
-        std::ofstream ofs(file_path, std::ostream::out | std::ostream::trunc);
-        ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        ofs << YAML::Dump(doc);
-
-        ofs.close();
-    } catch (std::ios_base::failure &e) {
-        SPDLOG_ERROR("Cannot write setpoints to {} - {} ({} {})", file_path, strerror(errno),
-                     e.code().message(), e.code().value());
-    }
+        doc["Date"] = dat_buf;
 
-    _glycol = glycol;
-    _heaters = heaters;
+        setpoints["Glycol"] = glycol;
+        setpoints["Heaters"] = heaters;
+
+        doc["Setpoints"] = setpoints;
+
+        return YAML::Dump(doc);
+    });
 }
 
 bool SavedSetpoints::is_valid() {
@@ -45,6 +45,14 @@ public:
     SavedSetpoints(std::string filename);
 
     void load();
+
+    /***
+     * Saves setpoints. Only copies values, the file is written
+     * asynchronously by the FilePersister.
+     *
+     * @param glycol glycol setpoint
+     * @param heaters heaters setpoint
+     */
     void save(float glycol, float heaters);
 
     /***
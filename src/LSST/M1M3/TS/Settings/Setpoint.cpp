@@ -23,21 +23,32 @@
 
 #include <spdlog/spdlog.h>
 
+#include <cRIO/Settings/Path.h>
+
 #include "Events/AppliedSetpoints.h"
+#include "Events/FcuTargets.h"
 #include "Settings/SavedSetpoints.h"
 #include "Settings/Setpoint.h"
+#include "Telemetry/FinerControl.h"
+#include "TSApplication.h"
 
 using namespace LSST::M1M3::TS::Settings;
 
-Setpoint::Setpoint(token) : _saved_setpoints(nullptr) {
+Setpoint::Setpoint(token) : _saved_setpoints(nullptr), _checkpoint(nullptr), _checkpoint_consumed(false) {
     glycolSupplyPercentage = 100;
+    glycolTemperatureMaxAge = 30;
     safetyAirTemperatureMaxAge = 600;
+    checkpointInterval = 60;
+    checkpointBumplessTime = 300;
 
     low = NAN;
     high = NAN;
 }
 
-Setpoint::~Setpoint() { delete _saved_setpoints; }
+Setpoint::~Setpoint() {
+    delete _saved_setpoints;
+    delete _checkpoint;
+}
 
 void Setpoint::load(YAML::Node doc) {
     SPDLOG_INFO("Loading Setpoint settings.");
@@ -52,6 +63,13 @@ void Setpoint::load(YAML::Node doc) {
                             glycolSupplyPercentage));
     }
 
+    glycolTemperatureMaxAge = doc["GlycolTemperatureMaxAge"].as<float>();
+    if (glycolTemperatureMaxAge <= 0) {
+        throw std::runtime_error(fmt::format(
+                "Setpoint/GlycolTemperatureMaxAge configuration parameter must be positive, was {:.2f}.",
+                glycolTemperatureMaxAge));
+    }
+
     low = doc["Low"].as<float>();
     high = doc["High"].as<float>();
     if (low >= high) {
@@ -83,14 +101,47 @@ void Setpoint::load(YAML::Node doc) {
 
     safetyAirTemperatureMaxAge = safety["AirTemperatureMaxAge"].as<float>();
 
-    delete _saved_setpoints;
-
     auto save = doc["Save"];
 
     savedSetpointsMaxAge = save["MaxAge"].as<uint64_t>();
-    _saved_setpoints = new SavedSetpoints(save["Filename"].as<std::string>());
 
-    _saved_setpoints->load();
+    // keep saved setpoints and checkpoint if their files weren't changed
+    auto saved_path = cRIO::Settings::Path::getFilePath("v1/" + save["Filename"].as<std::string>());
+    if (_saved_setpoints == nullptr || _saved_setpoints->file_path != saved_path) {
+        delete _saved_setpoints;
+        _saved_setpoints = new SavedSetpoints(save["Filename"].as<std::string>());
+
+        _saved_setpoints->load();
+    }
+
+    auto checkpoint = save["Checkpoint"];
+    if (checkpoint) {
+        checkpointInterval = checkpoint["Interval"].as<float>();
+        if (checkpointInterval <= 0) {
+            throw std::runtime_error(fmt::format(
+                    "Setpoint/Save/Checkpoint/Interval configuration parameter must be positive, was {:.2f}.",
+                    checkpointInterval));
+        }
+        checkpointBumplessTime = checkpoint["BumplessTime"].as<float>(300);
+        if (checkpointBumplessTime < 0) {
+            throw std::runtime_error(fmt::format(
+                    "Setpoint/Save/Checkpoint/BumplessTime configuration parameter cannot be negative, was "
+                    "{:.2f}.",
+                    checkpointBumplessTime));
+        }
+        auto checkpoint_path =
+                cRIO::Settings::Path::getFilePath("v1/" + checkpoint["Filename"].as<std::string>());
+        auto max_age = checkpoint["MaxAge"].as<uint32_t>();
+        if (_checkpoint == nullptr || _checkpoint->file_path != checkpoint_path ||
+            _checkpoint->max_age() != max_age) {
+            delete _checkpoint;
+            _checkpoint = new ControlCheckpoint(checkpoint["Filename"].as<std::string>(), max_age);
+            _checkpoint->load();
+        }
+    } else {
+        delete _checkpoint;
+        _checkpoint = nullptr;
+    }
 }
 
 void Setpoint::save_setpoints(float glycol, float heaters) {
@@ -105,3 +156,74 @@ void Setpoint::apply_saved_setpoints() {
     Events::AppliedSetpoints::instance().set_applied_setpoints(_saved_setpoints->glycol(),
                                                                _saved_setpoints->heaters());
 }
+
+void Setpoint::save_checkpoint() {
+    if (_checkpoint == nullptr) {
+        return;
+    }
+
+    auto &applied_setpoints = Events::AppliedSetpoints::instance();
+    _checkpoint->glycol_setpoint = applied_setpoints.get_applied_glycol_setpoint();
+    _checkpoint->heaters_setpoint = applied_setpoints.get_applied_heaters_setpoint();
+
+    {
+        auto ilc_lock = TSApplication::lock_ilc();
+
+        const auto &heater_PWM = Events::FcuTargets::instance().get_heaterPWM();
+        const auto &fan_RPM = Events::FcuTargets::instance().get_fanRPM();
+        for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+            _checkpoint->heater_PWM[i] = heater_PWM[i];
+            _checkpoint->fan_RPM[i] = fan_RPM[i];
+        }
+    }
+
+    _checkpoint->finer_control_state =
+            Telemetry::FinerControl::instance().snapshot(_checkpoint->mixing_valve_target);
+
+    _checkpoint->save();
+}
+
+const ControlCheckpoint *Setpoint::apply_checkpoint() {
+    if (_checkpoint == nullptr || _checkpoint_consumed || _checkpoint->is_valid() == false) {
+        return nullptr;
+    }
+
+    // apply checkpoint only once after restart
+    _checkpoint_consumed = true;
+
+    auto &applied_setpoints = Events::AppliedSetpoints::instance();
+    if (fabs(applied_setpoints.get_applied_glycol_setpoint() - _checkpoint->glycol_setpoint) > 0.001 ||
+        fabs(applied_setpoints.get_applied_heaters_setpoint() - _checkpoint->heaters_setpoint) > 0.001) {
+        SPDLOG_INFO(
+                "Controller checkpoint was recorded for {:+.2f}°C/{:+.2f}°C setpoints, applied setpoints "
+                "differ, not resuming from the checkpoint.",
+                _checkpoint->glycol_setpoint, _checkpoint->heaters_setpoint);
+        return nullptr;
+    }
+
+    int heaters[cRIO::NUM_TS_ILC];
+    int fans[cRIO::NUM_TS_ILC];
+
+    // converts human readable values back to 0-255 demands
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        heaters[i] = round(_checkpoint->heater_PWM[i] * 255.0 / 100.0);
+        fans[i] = _checkpoint->fan_RPM[i] / 10;
+    }
+
+    try {
+        Events::FcuTargets::instance().set_FCU_heaters_fans(heaters, fans);
+    } catch (std::exception &ex) {
+        SPDLOG_WARN("Cannot apply checkpointed FCU targets: {}", ex.what());
+        return nullptr;
+    }
+
+    if (_checkpoint->finer_control_state != Telemetry::FinerControl::FAULTED &&
+        !std::isnan(_checkpoint->mixing_valve_target)) {
+        Telemetry::FinerControl::instance().set_target(_checkpoint->mixing_valve_target);
+    }
+
+    SPDLOG_INFO("Resumed controller state from checkpoint {}, mixing valve target {:.1f}%.",
+                _checkpoint->file_path, _checkpoint->mixing_valve_target);
+
+    return _checkpoint;
+}
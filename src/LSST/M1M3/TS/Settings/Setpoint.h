@@ -30,6 +30,7 @@
 
 #include <cRIO/Singleton.h>
 
+#include "Settings/ControlCheckpoint.h"
 #include "Settings/SavedSetpoints.h"
 #include "TSPublisher.h"
 
@@ -49,9 +50,32 @@ public:
 
     void apply_saved_setpoints();
 
+    /***
+     * Returns true if controller state checkpointing is configured.
+     */
+    bool has_checkpoint() { return _checkpoint != nullptr; }
+
+    /***
+     * Records current FCU targets, mixing valve target and applied setpoints
+     * into the checkpoint file.
+     */
+    void save_checkpoint();
+
+    /***
+     * Applies checkpointed FCU targets and mixing valve target. The checkpoint
+     * is applied only once in the process lifetime, only if it isn't older
+     * than Save/Checkpoint/MaxAge and only if it was recorded for the
+     * currently applied setpoints.
+     *
+     * @return applied checkpoint, used to seed control loops, or nullptr if
+     * the checkpoint wasn't applied
+     */
+    const ControlCheckpoint *apply_checkpoint();
+
     float timestep;
     float mixingValveStep;
     float glycolSupplyPercentage;
+    float glycolTemperatureMaxAge;
     float high;
     float low;
 
@@ -63,6 +87,14 @@ public:
 
     SavedSetpoints *_saved_setpoints;
     uint32_t savedSetpointsMaxAge;
+
+    ControlCheckpoint *_checkpoint;
+    float checkpointInterval;
+    float checkpointBumplessTime;
+
+private:
+    // survives settings reloads, so the checkpoint is applied only once after restart
+    bool _checkpoint_consumed;
 };
 
 }  // namespace Settings
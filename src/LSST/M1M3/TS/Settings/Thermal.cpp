@@ -27,6 +27,7 @@
 #include <cRIO/ThermalILC.h>
 
 #include <Events/EnabledILC.h>
+#include <Settings/FcuIdentityCache.h>
 #include <Settings/Thermal.h>
 
 using namespace LSST::M1M3::TS::Settings;
@@ -47,6 +48,8 @@ void Thermal::load(YAML::Node doc) {
 
     defaultFanSpeed = doc["DefaultFanSpeed"].as<int>();
 
+    FcuIdentityCache::instance().load(doc["IdentityCache"]);
+
     log();
     Events::EnabledILC::instance().send();
 }
@@ -0,0 +1,55 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include <Settings/ThermalDataPublish.h>
+
+using namespace LSST::M1M3::TS::Settings;
+
+ThermalDataPublish::ThermalDataPublish(token) {
+    differentialTemperatureDeadband = 0;
+    absoluteTemperatureDeadband = 0;
+    fanRPMDeadband = 0;
+    maxSilentInterval = 0;
+}
+
+void ThermalDataPublish::load(YAML::Node doc) {
+    SPDLOG_INFO("Loading thermal data publishing settings.");
+
+    auto deadband = doc["Deadband"];
+
+    differentialTemperatureDeadband = deadband["DifferentialTemperature"].as<float>();
+    absoluteTemperatureDeadband = deadband["AbsoluteTemperature"].as<float>();
+    fanRPMDeadband = deadband["FanRPM"].as<int>();
+
+    if (differentialTemperatureDeadband < 0 || absoluteTemperatureDeadband < 0 || fanRPMDeadband < 0) {
+        throw std::runtime_error("ThermalDataPublish/Deadband values cannot be negative.");
+    }
+
+    maxSilentInterval = doc["MaxSilentInterval"].as<float>();
+    if (maxSilentInterval < 0) {
+        throw std::runtime_error(fmt::format(
+                "ThermalDataPublish/MaxSilentInterval cannot be negative, is {:.1f}.", maxSilentInterval));
+    }
+}
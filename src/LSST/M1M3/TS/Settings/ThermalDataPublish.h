@@ -0,0 +1,74 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Settings_ThermalDataPublish_h
+#define _TS_Settings_ThermalDataPublish_h
+
+#include <yaml-cpp/yaml.h>
+
+#include <cRIO/Singleton.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Settings {
+
+/***
+ * Publishing policy of the thermalData telemetry. The telemetry is published
+ * only if any FCU value moved more than its deadband since the last publish,
+ * or the maximal silent interval expired.
+ */
+class ThermalDataPublish : public cRIO::Singleton<ThermalDataPublish> {
+public:
+    ThermalDataPublish(token);
+
+    void load(YAML::Node doc);
+
+    /***
+     * Deadband of differentialTemperature, in degC.
+     */
+    float differentialTemperatureDeadband;
+
+    /***
+     * Deadband of absoluteTemperature, in degC.
+     */
+    float absoluteTemperatureDeadband;
+
+    /***
+     * Deadband of fanRPM, in RPM.
+     */
+    int fanRPMDeadband;
+
+    /***
+     * Maximal interval between published samples, in seconds. 0 means every
+     * sample is published.
+     */
+    float maxSilentInterval;
+};
+
+}  // namespace Settings
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  //!_TS_Settings_ThermalDataPublish_h
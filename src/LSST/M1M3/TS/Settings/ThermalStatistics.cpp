@@ -0,0 +1,48 @@
+/*
+ * This file is part of LSST M1M3 thermal system package.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include <Settings/ThermalStatistics.h>
+
+using namespace LSST::M1M3::TS::Settings;
+
+ThermalStatistics::ThermalStatistics(token) { windows = {10, 60}; }
+
+void ThermalStatistics::load(YAML::Node doc) {
+    SPDLOG_INFO("Loading thermal statistics settings.");
+
+    auto new_windows = doc["Windows"].as<std::vector<float>>();
+    if (new_windows.size() > MAX_WINDOWS) {
+        throw std::runtime_error(fmt::format("ThermalStatistics/Windows can contain at most {} windows, has {}.",
+                                             MAX_WINDOWS, new_windows.size()));
+    }
+    for (auto w : new_windows) {
+        if (w < 1) {
+            throw std::runtime_error(
+                    fmt::format("ThermalStatistics/Windows shall be at least 1 second, is {:.1f}.", w));
+        }
+    }
+
+    windows = new_windows;
+}
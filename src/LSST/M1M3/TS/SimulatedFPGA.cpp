@@ -26,6 +26,7 @@
 #include <cRIO/ModbusBuffer.h>
 #include <cRIO/Timestamp.h>
 
+#include "LatencyProbe.h"
 #include "Settings/MixingValve.h"
 #include "SimulatedFPGA.h"
 #include "TSPublisher.h"
@@ -47,6 +48,8 @@ SimulatedFPGA::SimulatedFPGA() : ILC::ILCBusList(1), IFPGA(), ThermalILC(1), _U1
 SimulatedFPGA::~SimulatedFPGA() {}
 
 void SimulatedFPGA::writeCommandFIFO(uint16_t *data, size_t length, uint32_t timeout) {
+    LatencyProbe::instance().mark(LatencyProbe::FIFO_WRITE);
+
     uint16_t *d = data;
     while (d < data + length) {
         size_t dl;
@@ -90,6 +93,7 @@ void SimulatedFPGA::writeRequestFIFO(uint16_t *data, size_t length, uint32_t tim
 }
 
 void SimulatedFPGA::readSGLResponseFIFO(float *data, size_t length, uint32_t timeout) {
+    LatencyProbe::instance().mark(LatencyProbe::RESPONSE);
     for (size_t i = 0; i < length; i++) {
         data[i] = _mixing_valve + random() / (float)RAND_MAX / 1000.0;
     }
@@ -110,6 +114,7 @@ void SimulatedFPGA::readU16ResponseFIFO(uint16_t *data, size_t length, uint32_t
             _U16ResponseStatus = DATA;
             break;
         case DATA:
+            LatencyProbe::instance().mark(LatencyProbe::RESPONSE);
             memcpy(data, _response.getBuffer(), _response.getLength() * 2);
             _response.clear();
             _U16ResponseStatus = IDLE;
@@ -34,3 +34,16 @@ void TSApplication::callFunctionOnAllIlcs(std::function<void(uint8_t)> func) {
         }
     }
 }
+
+bool TSApplication::changeAllILCsMode(const std::vector<uint16_t> &modes, uint32_t timeout, int retries) {
+    auto ilc_lock = lock_ilc();
+
+    std::vector<uint8_t> addresses;
+    callFunctionOnAllIlcs([&addresses](uint8_t address) { addresses.push_back(address); });
+
+    ILCModeSequencer sequencer(
+            *_ilc, [this, timeout]() { IFPGA::get().ilcCommands(*_ilc, timeout); }, retries);
+
+    SALThermalILC::SequencerScope scope(*_ilc, sequencer);
+    return sequencer.run(addresses, modes);
+}
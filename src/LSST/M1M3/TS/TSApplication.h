@@ -23,6 +23,7 @@
 #ifndef _TS_TSApplication_h
 #define _TS_TSApplication_h
 
+#include <mutex>
 #include <vector>
 
 #include <IFPGA.h>
@@ -41,10 +42,37 @@ public:
 
     void callFunctionOnAllIlcs(std::function<void(uint8_t)> func);
 
+    /**
+     * Changes mode of all enabled ILCs through the mode sequence, one bus
+     * transaction per mode. Returned modes are verified, addresses which
+     * failed are retried. Takes the ILC bus lock.
+     *
+     * @param modes sequence of ILC modes
+     * @param timeout bus transaction timeout
+     * @param retries number of retries for addresses failing in their slot
+     *
+     * @return true if all ILCs reached the last mode
+     */
+    bool changeAllILCsMode(const std::vector<uint16_t> &modes, uint32_t timeout = 1000, int retries = 2);
+
     static SALThermalILC *ilc() { return instance()._ilc; }
 
+    /**
+     * Locks ILC bus. Must be held while ilc() command buffer is filled and
+     * executed, and while data updated from ILC responses (ThermalData,
+     * FcuTargets) are used. The ILC bus is accessed from the controller
+     * thread, but also from MPU threads when they fault the CSC. The lock is
+     * recursive, so functions taking it can call each other.
+     *
+     * @return lock owning the ILC bus mutex
+     */
+    static std::unique_lock<std::recursive_mutex> lock_ilc() {
+        return std::unique_lock<std::recursive_mutex>(instance()._ilc_mutex);
+    }
+
 private:
     SALThermalILC *_ilc;
+    std::recursive_mutex _ilc_mutex;
 };
 
 }  // namespace TS
@@ -34,6 +34,7 @@
 #include "NiFpga/NiFpga_ts_M1M3ThermalFPGA.h"
 
 #include "IFPGA.h"
+#include "PublishQueue.h"
 #include "TSPublisher.h"
 
 using namespace LSST::M1M3::TS;
@@ -55,6 +56,7 @@ TSPublisher::~TSPublisher() {
 
 void TSPublisher::setSAL(std::shared_ptr<SAL_MTM1M3TS> m1m3TSSAL) {
     _m1m3TSSAL = m1m3TSSAL;
+    PublishQueue::instance().set_SAL(m1m3TSSAL);
 
     SPDLOG_DEBUG("TSPublisher: Initializing SAL Telemetry");
     _m1m3TSSAL->salTelemetryPub((char *)"MTM1M3TS_thermalData");
@@ -156,7 +158,13 @@ void TSPublisher::startPumpThread() {
     pump_thread->start();
 }
 
-void TSPublisher::startupPump() { pump_thread->startup(); }
+void TSPublisher::startupPump() {
+    if (pump_thread == NULL) {
+        SPDLOG_WARN("Cannot startup EGW pump - the pump thread is not running.");
+        return;
+    }
+    pump_thread->startup();
+}
 
 void TSPublisher::stopFlowMeterThread() {
     if (_flow_meter_thread == NULL) {
@@ -28,6 +28,7 @@
 #include <SAL_MTM1M3TS.h>
 
 #include <Commands/SAL.h>
+#include <LatencyProbe.h>
 #include <TSSubscriber.h>
 
 #include <cRIO/Command.h>
@@ -45,6 +46,8 @@ TSSubscriber::TSSubscriber(std::shared_ptr<SAL_MTM1M3TS> m1m3tsSAL) {
         MTM1M3TS_command_##name##C data;                                   \
         int32_t commandID = m1m3tsSAL->acceptCommand_##name(&data);        \
         if (commandID <= 0) return;                                        \
+        LatencyProbe::instance().mark(LatencyProbe::COMMAND_ACCEPTED,      \
+                                      commandID);                          \
         cRIO::ControllerThread::instance().enqueue(                        \
                 std::make_shared<Commands::SAL_##name>(commandID, &data)); \
     }
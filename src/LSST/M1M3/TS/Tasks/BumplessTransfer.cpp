@@ -0,0 +1,55 @@
+/*
+ * Bumpless transfer of a restored PID output.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Tasks/BumplessTransfer.h"
+
+using namespace LSST::M1M3::TS::Tasks;
+
+BumplessTransfer::BumplessTransfer() : _seeded(false), _restored(0), _duration(0), _offset(0) {}
+
+void BumplessTransfer::seed(float restored, float duration) {
+    _seeded = true;
+    _restored = restored;
+    _duration = duration;
+    _offset = 0;
+}
+
+float BumplessTransfer::apply(float output, std::chrono::steady_clock::time_point now) {
+    if (_seeded) {
+        _seeded = false;
+        _offset = _restored - output;
+        _start = now;
+        return _restored;
+    }
+
+    if (_offset == 0) {
+        return output;
+    }
+
+    float elapsed = std::chrono::duration<float>(now - _start).count();
+    if (elapsed >= _duration) {
+        _offset = 0;
+        return output;
+    }
+
+    return output + _offset * (1 - elapsed / _duration);
+}
@@ -0,0 +1,79 @@
+/*
+ * Bumpless transfer of a restored PID output.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Tasks_BumplessTransfer_
+#define _TS_Tasks_BumplessTransfer_
+
+#include <chrono>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Tasks {
+
+/***
+ * Bumpless transfer of a PID output resumed from a checkpoint. ts_cRIOcpp
+ * PIDs don't expose their integrator, so a freshly constructed PID cannot be
+ * pre-loaded with the checkpointed output. Instead, the difference between
+ * the restored output and the first output of the PID is added to the PID
+ * output and linearly bled off over the transfer duration, letting the PID
+ * integrator take over.
+ */
+class BumplessTransfer {
+public:
+    BumplessTransfer();
+
+    /***
+     * Seeds the transfer. The next apply() returns the restored output.
+     *
+     * @param restored restored (checkpointed) PID output
+     * @param duration time to bleed off the difference, in seconds
+     */
+    void seed(float restored, float duration);
+
+    /***
+     * Returns PID output with the remaining transfer offset added.
+     *
+     * @param output PID output
+     * @param now current time
+     */
+    float apply(float output, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /***
+     * Returns true if the transfer is seeded or in progress.
+     */
+    bool active() { return _seeded || _offset != 0; }
+
+private:
+    bool _seeded;
+    float _restored;
+    float _duration;
+    float _offset;
+    std::chrono::steady_clock::time_point _start;
+};
+
+}  // namespace Tasks
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // ! _TS_Tasks_BumplessTransfer_
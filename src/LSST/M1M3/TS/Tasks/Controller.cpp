@@ -20,17 +20,21 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
+
 #include <cRIO/ControllerThread.h>
 
 #include "Events/AppliedSetpoints.h"
+#include "Settings/MixingValve.h"
 #include "Settings/Setpoint.h"
 #include "Tasks/Controller.h"
+#include "Telemetry/FinerControl.h"
 
 using namespace LSST::M1M3::TS::Tasks;
 
 Controller::Controller(token) {}
 
-void Controller::set_setpoints(float glycol, float heaters) {
+void Controller::set_setpoints(float glycol, float heaters, const Settings::ControlCheckpoint *resume) {
     const std::lock_guard<std::mutex> lock(_lock);
 
     auto small_change = Events::AppliedSetpoints::instance().set_applied_setpoints(glycol, heaters);
@@ -65,7 +69,68 @@ void Controller::set_setpoints(float glycol, float heaters) {
         cRIO::ControllerThread::instance().enqueue(_heaters_temperature_task);
     }
 
+    // setpoints are applied from commands executed on the controller thread,
+    // so the tasks cannot run before they are seeded
+    if (resume != nullptr) {
+        auto bumpless_time = Settings::Setpoint::instance().checkpointBumplessTime;
+        _heaters_temperature_task->resume(resume->heater_PWM, bumpless_time);
+        if (resume->finer_control_state != Telemetry::FinerControl::FAULTED &&
+            !std::isnan(resume->mixing_valve_target)) {
+            _glycol_temperature_task->resume(resume->mixing_valve_target, bumpless_time);
+        }
+        SPDLOG_INFO("Control loops resumed from checkpoint, bumpless transfer in {:.0f} seconds.",
+                    bumpless_time);
+    }
+
+    if (_save_checkpoint_task == nullptr && Settings::Setpoint::instance().has_checkpoint()) {
+        _save_checkpoint_task = std::make_shared<SaveCheckpoint>();
+        cRIO::ControllerThread::instance().enqueue(_save_checkpoint_task);
+    }
+
     Events::AppliedSetpoints::instance().send();
     SPDLOG_INFO("Glycol setpoints: {:0.2f} FCU heaters setpoint: {:0.2f}", glycol, heaters);
     Settings::Setpoint::instance().save_setpoints(glycol, heaters);
 }
+
+void Controller::update_mixing_valve_PID() {
+    const std::lock_guard<std::mutex> lock(_lock);
+
+    if (_glycol_temperature_task == nullptr) {
+        return;
+    }
+
+    _glycol_temperature_task->target_pid.updateParameters(Settings::MixingValve::instance().pid_parameters);
+    SPDLOG_INFO("Updated EGW's control PID parameters.");
+}
+
+double Controller::power_up_coolant_pump(std::chrono::milliseconds settle,
+                                         CoolantPumpPowerUp::powered_t on_powered,
+                                         CoolantPumpPowerUp::failed_t on_failed) {
+    const std::lock_guard<std::mutex> lock(_lock);
+
+    if (_coolant_pump_power_up != nullptr && _coolant_pump_power_up->pending()) {
+        throw std::runtime_error("EGW pump power up is already in progress.");
+    }
+
+    _coolant_pump_power_up = std::make_shared<CoolantPumpPowerUp>(settle, on_powered, on_failed);
+    cRIO::ControllerThread::instance().enqueue(_coolant_pump_power_up);
+
+    return _coolant_pump_power_up->remaining();
+}
+
+void Controller::cancel_coolant_pump_power_up() {
+    const std::lock_guard<std::mutex> lock(_lock);
+
+    if (_coolant_pump_power_up == nullptr) {
+        return;
+    }
+
+    cRIO::ControllerThread::instance().remove(_coolant_pump_power_up);
+    _coolant_pump_power_up->cancel();
+    _coolant_pump_power_up.reset();
+}
+
+bool Controller::coolant_pump_power_up_pending() {
+    const std::lock_guard<std::mutex> lock(_lock);
+    return _coolant_pump_power_up != nullptr && _coolant_pump_power_up->pending();
+}
@@ -28,8 +28,11 @@
 
 #include <cRIO/Singleton.h>
 
+#include "Settings/ControlCheckpoint.h"
+#include "Tasks/CoolantPumpPowerUp.h"
 #include "Tasks/GlycolTemperatureControl.h"
 #include "Tasks/HeatersTemperatureControl.h"
+#include "Tasks/SaveCheckpoint.h"
 
 namespace LSST {
 namespace M1M3 {
@@ -40,13 +43,54 @@ class Controller : public cRIO::Singleton<Controller> {
 public:
     Controller(token);
 
-    void set_setpoints(float glycol, float heaters);
+    /**
+     * Applies new setpoints, (re)starting control loops as needed.
+     *
+     * @param glycol glycol setpoint
+     * @param heaters heaters setpoint
+     * @param resume if not nullptr, control loops bumplessly resume from the
+     * checkpointed outputs
+     */
+    void set_setpoints(float glycol, float heaters, const Settings::ControlCheckpoint *resume = nullptr);
+
+    /**
+     * Updates running glycol temperature control PID with the current
+     * MixingValve/PID parameters. PID state is preserved.
+     */
+    void update_mixing_valve_PID();
+
+    /**
+     * Schedule EGW coolant pump power up. Only a single power up can be
+     * pending.
+     *
+     * @param settle delay between pump power on and pump thread start
+     * @param on_powered called when the pump is powered and its thread started
+     * @param on_failed called when power up fails or is cancelled
+     *
+     * @return expected number of seconds till power up completes
+     *
+     * @throw std::runtime_error if another power up is pending
+     */
+    double power_up_coolant_pump(std::chrono::milliseconds settle, CoolantPumpPowerUp::powered_t on_powered,
+                                 CoolantPumpPowerUp::failed_t on_failed);
+
+    /**
+     * Cancel pending coolant pump power up. No-op if nothing is pending.
+     */
+    void cancel_coolant_pump_power_up();
+
+    /**
+     * Returns true if coolant pump power up is pending.
+     */
+    bool coolant_pump_power_up_pending();
 
 private:
     std::mutex _lock;
 
     std::shared_ptr<GlycolTemperatureControl> _glycol_temperature_task;
     std::shared_ptr<HeatersTemperatureControl> _heaters_temperature_task;
+    std::shared_ptr<CoolantPumpPowerUp> _coolant_pump_power_up;
+    std::shared_ptr<SaveCheckpoint> _save_checkpoint_task;
 };
 
 }  // namespace Tasks
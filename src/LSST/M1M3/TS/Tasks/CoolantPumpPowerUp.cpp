@@ -0,0 +1,111 @@
+/*
+ * Deferred EGW coolant pump power up task.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include "IFPGA.h"
+#include "Tasks/CoolantPumpPowerUp.h"
+#include "TSPublisher.h"
+
+using namespace LSST::M1M3::TS::Tasks;
+
+CoolantPumpPowerUp::CoolantPumpPowerUp(std::chrono::milliseconds settle, powered_t on_powered,
+                                       failed_t on_failed)
+        : _state(WAITING), _settle(settle), _on_powered(on_powered), _on_failed(on_failed) {
+    _deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(remaining() + 1));
+}
+
+LSST::cRIO::task_return_t CoolantPumpPowerUp::run() {
+    auto now = std::chrono::steady_clock::now();
+
+    if (pending() && now > _deadline) {
+        _fail("EGW pump power up timed out");
+        return Task::DONT_RESCHEDULE;
+    }
+
+    try {
+        switch (_state) {
+            case WAITING: {
+                auto power_up = IFPGA::get().getCoolantPumpPowerUpTime();
+                if (power_up > now) {
+                    auto wait = std::chrono::ceil<std::chrono::milliseconds>(power_up - now);
+                    SPDLOG_INFO("Waiting {} ms for EGW pump power down.", wait.count());
+                    return wait.count();
+                }
+                IFPGA::get().setCoolantPumpPower(true);
+                SPDLOG_INFO("Glycol pump turned on.");
+                _state = SETTLING;
+                _settled = now + _settle;
+                if (_settle.count() > 0) {
+                    return _settle.count();
+                }
+            }
+            // fall through
+            case SETTLING:
+                if (_settled > now) {
+                    return std::chrono::ceil<std::chrono::milliseconds>(_settled - now).count();
+                }
+                TSPublisher::instance().startPumpThread();
+                _state = DONE;
+                if (_on_powered) {
+                    _on_powered();
+                }
+                break;
+            case DONE:
+                break;
+        }
+    } catch (std::exception &ex) {
+        _fail(ex.what());
+    }
+
+    return Task::DONT_RESCHEDULE;
+}
+
+void CoolantPumpPowerUp::cancel() {
+    if (pending()) {
+        _fail("EGW pump power up cancelled");
+    }
+}
+
+double CoolantPumpPowerUp::remaining() const {
+    auto now = std::chrono::steady_clock::now();
+    switch (_state) {
+        case WAITING: {
+            auto power_up = std::max(IFPGA::get().getCoolantPumpPowerUpTime(), now);
+            return std::chrono::duration<double>(power_up - now + _settle).count();
+        }
+        case SETTLING:
+            return std::max(0.0, std::chrono::duration<double>(_settled - now).count());
+        default:
+            return 0;
+    }
+}
+
+void CoolantPumpPowerUp::_fail(const std::string &reason) {
+    _state = DONE;
+    SPDLOG_WARN("Cannot power up EGW pump: {}", reason);
+    if (_on_failed) {
+        _on_failed(reason);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Deferred EGW coolant pump power up task.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Tasks_CoolantPumpPowerUp_
+#define _TS_Tasks_CoolantPumpPowerUp_
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include <cRIO/Task.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Tasks {
+
+/***
+ * Powers up EGW coolant pump without blocking the controller thread. The pump
+ * cannot be powered on sooner than GlycolPump.CommunicationRecoverPowerOff
+ * seconds after it was powered off. Instead of sleeping, the task reschedules
+ * itself until the power up is allowed, powers the pump on, waits for the
+ * optional settle delay (again by rescheduling) and starts the pump
+ * telemetry thread. Completion or failure is reported through callbacks, so
+ * SAL commands can acknowledge in progress and complete asynchronously. The
+ * power up fails if it isn't finished within the time expected at its
+ * construction (plus one second), so commands acknowledged with that timeout
+ * always complete.
+ */
+class CoolantPumpPowerUp : public cRIO::Task {
+public:
+    typedef std::function<void()> powered_t;
+    typedef std::function<void(const std::string &)> failed_t;
+
+    /***
+     * Construct power up task.
+     *
+     * @param settle delay between pump power up and pump thread start
+     * @param on_powered called after the pump thread was started
+     * @param on_failed called with reason if power up failed or was cancelled
+     */
+    CoolantPumpPowerUp(std::chrono::milliseconds settle, powered_t on_powered, failed_t on_failed);
+
+    cRIO::task_return_t run() override;
+
+    /***
+     * Cancel pending power up. Calls on_failed callback if the task is still
+     * pending. Caller is responsible for removing the task from the
+     * controller thread queue.
+     */
+    void cancel();
+
+    /***
+     * Returns true if the task hasn't yet finished.
+     */
+    bool pending() const { return _state == WAITING || _state == SETTLING; }
+
+    /***
+     * Returns expected number of seconds till the task finishes.
+     */
+    double remaining() const;
+
+private:
+    enum { WAITING, SETTLING, DONE } _state;
+
+    std::chrono::milliseconds _settle;
+    std::chrono::steady_clock::time_point _settled;
+    std::chrono::steady_clock::time_point _deadline;
+
+    powered_t _on_powered;
+    failed_t _on_failed;
+
+    void _fail(const std::string &reason);
+};
+
+}  // namespace Tasks
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // ! _TS_Tasks_CoolantPumpPowerUp_
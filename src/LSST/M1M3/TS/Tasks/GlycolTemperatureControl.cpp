@@ -27,6 +27,7 @@
 #include "Settings/MixingValve.h"
 #include "Settings/Setpoint.h"
 #include "Tasks/GlycolTemperatureControl.h"
+#include "Telemetry/DataAge.h"
 #include "Telemetry/FinerControl.h"
 #include "Telemetry/GlycolLoopTemperature.h"
 #include "Telemetry/MixingValve.h"
@@ -34,17 +35,40 @@
 using namespace LSST::M1M3::TS::Tasks;
 
 GlycolTemperatureControl::GlycolTemperatureControl()
-        : target_pid(Settings::MixingValve::instance().pid_parameters, 0, 100) {}
+        : target_pid(Settings::MixingValve::instance().pid_parameters, 0, 100), _stale(false) {}
+
+void GlycolTemperatureControl::resume(float mixing_valve_target, float duration) {
+    _transfer.seed(mixing_valve_target, duration);
+}
 
 LSST::cRIO::task_return_t GlycolTemperatureControl::run() {
     // don do anything in engineering mode
     if (Events::EngineeringMode::instance().is_enabled()) {
         return Settings::Setpoint::instance().timestep * 1000.0;
     }
-    auto &glycol_temp = Telemetry::GlycolLoopTemperature::instance();
+    auto glycol_temp = Telemetry::GlycolLoopTemperature::instance().snapshot();
     auto &s_setpoint = Settings::Setpoint::instance();
 
-    auto mirror_loop = glycol_temp.get_mirror_loop_average(s_setpoint.glycolSupplyPercentage / 100.0);
+    auto now = std::chrono::steady_clock::now();
+    Telemetry::DataAge::instance().record(Telemetry::DataAge::GLYCOL_TEMPERATURE, glycol_temp.received, now);
+
+    float age = std::chrono::duration<float>(now - glycol_temp.received).count();
+    if (age > s_setpoint.glycolTemperatureMaxAge) {
+        if (_stale == false) {
+            SPDLOG_WARN(
+                    "Glycol loop temperatures are {:.1f} seconds old, Setpoint/GlycolTemperatureMaxAge is "
+                    "{:.1f} seconds. Holding mixing valve position.",
+                    age, s_setpoint.glycolTemperatureMaxAge);
+            _stale = true;
+        }
+        return s_setpoint.timestep * 1000.0;
+    }
+    if (_stale) {
+        SPDLOG_INFO("Glycol loop temperatures are fresh again.");
+        _stale = false;
+    }
+
+    auto mirror_loop = glycol_temp.mirror_loop_average(s_setpoint.glycolSupplyPercentage / 100.0);
     float target_glycol_temp = Events::AppliedSetpoints::instance().get_applied_glycol_setpoint();
 
     if (isnan(target_glycol_temp) || isnan(mirror_loop)) {
@@ -56,7 +80,8 @@ LSST::cRIO::task_return_t GlycolTemperatureControl::run() {
 
     auto step = Settings::Setpoint::instance().mixingValveStep;
 
-    float target_mixing_valve = round(target_pid.process(target_glycol_temp, mirror_loop) / step) * step;
+    float target_mixing_valve =
+            round(_transfer.apply(target_pid.process(target_glycol_temp, mirror_loop)) / step) * step;
 
     target_mixing_valve = std::max(0.0f, std::min(target_mixing_valve, 100.0f));
 
@@ -27,6 +27,7 @@
 
 #include "cRIO/Task.h"
 #include "PID/LimitedPID.h"
+#include "Tasks/BumplessTransfer.h"
 
 namespace LSST {
 namespace M1M3 {
@@ -47,9 +48,23 @@ public:
 
     virtual cRIO::task_return_t run();
 
+    /***
+     * Resumes mixing valve control from checkpointed target. The first PID
+     * output is replaced with the target, the difference is bled off over
+     * the duration.
+     *
+     * @param mixing_valve_target checkpointed mixing valve target, in %
+     * @param duration bumpless transfer duration, in seconds
+     */
+    void resume(float mixing_valve_target, float duration);
+
     float target_mixing_valve = 0;
 
     PID::LimitedPID target_pid;
+
+private:
+    bool _stale;
+    BumplessTransfer _transfer;
 };
 
 }  // namespace Tasks
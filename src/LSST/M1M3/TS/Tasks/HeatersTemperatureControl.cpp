@@ -29,26 +29,42 @@
 #include "Settings/Heaters.h"
 #include "Settings/Thermal.h"
 #include "Tasks/HeatersTemperatureControl.h"
+#include "Telemetry/DataAge.h"
 #include "Telemetry/ThermalData.h"
+#include "TSApplication.h"
 
 using namespace LSST::M1M3::TS::Tasks;
 
 HeatersTemperatureControl::HeatersTemperatureControl() {}
 
+void HeatersTemperatureControl::resume(const float heater_PWM[LSST::cRIO::NUM_TS_ILC], float duration) {
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        // PID output is 0-255 demand
+        _transfers[i].seed(heater_PWM[i] * 255.0 / 100.0, duration);
+    }
+}
+
 LSST::cRIO::task_return_t HeatersTemperatureControl::run() {
-    auto heaterPWM = Events::FcuTargets::instance().get_heaterPWM();
-    auto fanRPM = Events::FcuTargets::instance().get_fanRPM();
+    // FCU targets and thermal data can be modified by a fault on MPU thread
+    auto ilc_lock = TSApplication::lock_ilc();
+
+    const auto& fanRPM = Events::FcuTargets::instance().get_fanRPM();
 
     auto& thermal_data_telemetry = Telemetry::ThermalData::instance();
-    auto temperature = thermal_data_telemetry.get_absoluteTemperature();
+    const auto& temperature = thermal_data_telemetry.get_absoluteTemperature();
     auto target_temperature = Events::AppliedSetpoints::instance().get_applied_heaters_setpoint();
 
     auto& h_settings = Settings::Heaters::instance();
     auto& t_settings = Settings::Thermal::instance();
 
-    std::vector<int> target_heater(LSST::cRIO::NUM_TS_ILC);
-    std::vector<int> target_fan(LSST::cRIO::NUM_TS_ILC);
+    auto now = std::chrono::steady_clock::now();
+    auto& data_age = Telemetry::DataAge::instance();
+    int stale = 0;
+
+    int target_heater[LSST::cRIO::NUM_TS_ILC];
+    int target_fan[LSST::cRIO::NUM_TS_ILC];
     for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        target_heater[i] = 0;
         target_fan[i] = (fanRPM[i] == 0 ? t_settings.defaultFanSpeed : fanRPM[i]) / 10;
         if (h_settings.heaters_PID[i] == nullptr) {
             SPDLOG_ERROR("Heater {} PID is not set!", i);
@@ -58,12 +74,27 @@ LSST::cRIO::task_return_t HeatersTemperatureControl::run() {
         if (isnan(temperature[i])) {
             continue;
         }
+        auto received = thermal_data_telemetry.get_received(i);
+        data_age.record(Telemetry::DataAge::FCU_TEMPERATURE, received, now);
+        if (std::chrono::duration<float>(now - received).count() > h_settings.temperatureMaxAge) {
+            target_heater[i] = 0;
+            stale++;
+            continue;
+        }
         if (thermal_data_telemetry.is_heater_disabled(i)) {
             target_heater[i] = 0;
             continue;
         }
-        target_heater[i] = round(h_settings.heaters_PID[i]->process(target_temperature, temperature[i]));
+        float demand =
+                _transfers[i].apply(h_settings.heaters_PID[i]->process(target_temperature, temperature[i]));
+        target_heater[i] = round(std::max(0.0f, std::min(demand, 255.0f)));
     }
+    if (stale > 0) {
+        SPDLOG_WARN(
+                "{} FCUs temperature measurements older than {:.1f} seconds, their heaters are switched off.",
+                stale, h_settings.temperatureMaxAge);
+    }
+
     try {
         Events::FcuTargets::instance().set_FCU_heaters_fans(target_heater, target_fan);
     } catch (std::exception& ex) {
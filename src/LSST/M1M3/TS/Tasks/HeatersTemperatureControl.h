@@ -23,7 +23,10 @@
 #ifndef _TS_Tasks_HeatersTemperatureControl_
 #define _TS_Tasks_HeatersTemperatureControl_
 
+#include <cRIO/ThermalILC.h>
+
 #include "cRIO/Task.h"
+#include "Tasks/BumplessTransfer.h"
 
 namespace LSST {
 namespace M1M3 {
@@ -35,6 +38,19 @@ public:
     HeatersTemperatureControl();
 
     virtual cRIO::task_return_t run();
+
+    /***
+     * Resumes heaters control from checkpointed heaters PWM. The first output
+     * of each heater PID is replaced with the checkpointed value, the
+     * difference is bled off over the duration.
+     *
+     * @param heater_PWM checkpointed heaters PWM, in %
+     * @param duration bumpless transfer duration, in seconds
+     */
+    void resume(const float heater_PWM[cRIO::NUM_TS_ILC], float duration);
+
+private:
+    BumplessTransfer _transfers[cRIO::NUM_TS_ILC];
 };
 
 }  // namespace Tasks
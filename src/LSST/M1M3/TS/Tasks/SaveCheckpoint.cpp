@@ -0,0 +1,39 @@
+/*
+ * Task periodically checkpointing controller state.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Events/SummaryState.h"
+#include "Settings/Setpoint.h"
+#include "Tasks/SaveCheckpoint.h"
+
+using namespace LSST::M1M3::TS::Tasks;
+
+SaveCheckpoint::SaveCheckpoint() {}
+
+LSST::cRIO::task_return_t SaveCheckpoint::run() {
+    auto &s_setpoint = Settings::Setpoint::instance();
+
+    if (Events::SummaryState::instance().enabled()) {
+        s_setpoint.save_checkpoint();
+    }
+
+    return s_setpoint.checkpointInterval * 1000.0;
+}
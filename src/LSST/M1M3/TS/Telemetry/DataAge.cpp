@@ -0,0 +1,101 @@
+/*
+ * Statistics of control loop input data age.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+#include "Telemetry/DataAge.h"
+
+using namespace LSST::M1M3::TS::Telemetry;
+using namespace std::chrono_literals;
+
+constexpr auto report_interval = 60s;
+
+static const char *input_names[DataAge::INPUTS] = {"Glycol temperature", "FCU temperature"};
+
+DataAge::DataAge(token) {
+    for (int i = 0; i < INPUTS; i++) {
+        _head[i] = 0;
+        _count[i] = 0;
+    }
+    _next_report = std::chrono::steady_clock::now() + report_interval;
+}
+
+void DataAge::record(Input input, std::chrono::steady_clock::time_point received,
+                     std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(_lock);
+
+    _ages[input][_head[input]] = std::chrono::duration<float, std::milli>(now - received).count();
+    _head[input] = (_head[input] + 1) % SAMPLES;
+    if (_count[input] < SAMPLES) {
+        _count[input]++;
+    }
+}
+
+DataAge::Percentiles DataAge::percentiles(Input input) {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _percentiles(input);
+}
+
+void DataAge::report() {
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (now < _next_report) {
+        return;
+    }
+    _next_report = now + report_interval;
+
+    for (int i = 0; i < INPUTS; i++) {
+        auto p = _percentiles(static_cast<Input>(i));
+        if (p.samples == 0) {
+            continue;
+        }
+        SPDLOG_INFO("{} data age (ms) - samples {} p50 {:.1f} p90 {:.1f} p99 {:.1f} max {:.1f}",
+                    input_names[i], p.samples, p.p50, p.p90, p.p99, p.max);
+    }
+}
+
+DataAge::Percentiles DataAge::_percentiles(Input input) {
+    Percentiles ret;
+    ret.samples = _count[input];
+    if (ret.samples == 0) {
+        ret.p50 = ret.p90 = ret.p99 = ret.max = NAN;
+        return ret;
+    }
+
+    float sorted[SAMPLES];
+    std::copy(_ages[input], _ages[input] + ret.samples, sorted);
+    std::sort(sorted, sorted + ret.samples);
+
+    auto percentile = [&sorted, &ret](float p) { return sorted[static_cast<size_t>(p * (ret.samples - 1))]; };
+
+    ret.p50 = percentile(0.5);
+    ret.p90 = percentile(0.9);
+    ret.p99 = percentile(0.99);
+    ret.max = sorted[ret.samples - 1];
+
+    return ret;
+}
@@ -0,0 +1,107 @@
+/*
+ * Statistics of control loop input data age.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_DataAge_
+#define _TS_Telemetry_DataAge_
+
+#include <chrono>
+#include <mutex>
+
+#include <cRIO/Singleton.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Collects age of the sensor data at the time the control loops consume
+ * them, i.e. end-to-end latency between data reception and their use.
+ * Percentiles of the collected ages are periodically logged.
+ */
+class DataAge final : public cRIO::Singleton<DataAge> {
+public:
+    DataAge(token);
+
+    /**
+     * Inputs tracked.
+     */
+    enum Input { GLYCOL_TEMPERATURE = 0, FCU_TEMPERATURE = 1, INPUTS = 2 };
+
+    /**
+     * Age percentiles, in milliseconds.
+     */
+    struct Percentiles {
+        size_t samples;
+        float p50;
+        float p90;
+        float p99;
+        float max;
+    };
+
+    /**
+     * Record input age.
+     *
+     * @param input consumed input
+     * @param received time the data were received
+     * @param now time the data were consumed
+     */
+    void record(Input input, std::chrono::steady_clock::time_point received,
+                std::chrono::steady_clock::time_point now);
+
+    /**
+     * Calculates percentiles of the recorded ages.
+     *
+     * @param input input for which percentiles shall be calculated
+     *
+     * @return percentiles of the last SAMPLES recorded ages
+     */
+    Percentiles percentiles(Input input);
+
+    /**
+     * Logs percentiles if report interval passed since the last report.
+     */
+    void report();
+
+    /**
+     * Number of samples kept per input.
+     */
+    static constexpr size_t SAMPLES = 1024;
+
+private:
+    std::mutex _lock;
+
+    float _ages[INPUTS][SAMPLES];
+    size_t _head[INPUTS];
+    size_t _count[INPUTS];
+
+    std::chrono::steady_clock::time_point _next_report;
+
+    Percentiles _percentiles(Input input);
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_DataAge_
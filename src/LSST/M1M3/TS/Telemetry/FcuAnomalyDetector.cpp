@@ -0,0 +1,153 @@
+/*
+ * Streaming FCU anomaly detection.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+#include "Settings/FcuAnomaly.h"
+#include "Telemetry/FcuAnomalyDetector.h"
+
+using namespace LSST::M1M3::TS::Telemetry;
+
+const char *FcuAnomalyDetector::anomaly_names[ANOMALIES] = {
+        "fan doesn't follow its target", "heater doesn't heat", "temperature drifts from other FCUs"};
+
+FcuAnomalyDetector::FcuAnomalyDetector(token) { reset(); }
+
+void FcuAnomalyDetector::update(int index, float heater_PWM, int target_fan_RPM, float differential_temperature,
+                                int fan_RPM, float absolute_temperature) {
+    auto &settings = Settings::FcuAnomaly::instance();
+    if (settings.enabled == false) {
+        return;
+    }
+
+    auto &state = _fcus[index];
+
+    // missing data are handled by ThermalWarning and data age checks
+    if (std::isnan(differential_temperature) || std::isnan(absolute_temperature) || fan_RPM < 0) {
+        return;
+    }
+
+    float fan_error = target_fan_RPM > 0 ? std::fabs(fan_RPM - target_fan_RPM) / target_fan_RPM : 0;
+
+    if (state.initialized == false) {
+        state.fan_error = fan_error;
+        state.heater_PWM = heater_PWM;
+        state.differential_temperature = differential_temperature;
+        state.absolute_temperature = absolute_temperature;
+        state.initialized = true;
+    } else {
+        float a = settings.smoothing;
+        state.fan_error += a * (fan_error - state.fan_error);
+        state.heater_PWM += a * (heater_PWM - state.heater_PWM);
+        state.differential_temperature += a * (differential_temperature - state.differential_temperature);
+        state.absolute_temperature += a * (absolute_temperature - state.absolute_temperature);
+    }
+
+    _persist(state, FAN_STUCK, target_fan_RPM >= settings.fanMinTarget && state.fan_error > settings.fanTolerance,
+             settings.persistence);
+
+    _persist(state, HEATER_DEAD,
+             state.heater_PWM >= settings.heaterMinPWM &&
+                     state.differential_temperature < settings.heaterMinResponse,
+             settings.persistence);
+
+    _persist(state, RTD_DRIFT,
+             !std::isnan(_fleet_temperature) &&
+                     std::fabs(state.absolute_temperature - _fleet_temperature) > settings.rtdMaxDeviation,
+             settings.persistence);
+}
+
+int FcuAnomalyDetector::tick() {
+    double sum = 0;
+    int count = 0;
+    int anomalous = 0;
+
+    for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+        auto &state = _fcus[i];
+        if (state.initialized && (state.flags & (1 << RTD_DRIFT)) == 0) {
+            sum += state.absolute_temperature;
+            count++;
+        }
+
+        if (state.flags != 0) {
+            anomalous++;
+        }
+
+        if (state.flags == state.reported) {
+            continue;
+        }
+
+        for (int a = 0; a < ANOMALIES; a++) {
+            uint8_t bit = 1 << a;
+            if ((state.flags & bit) == (state.reported & bit)) {
+                continue;
+            }
+            if (state.flags & bit) {
+                SPDLOG_WARN("FCU {} anomaly: {} (heater {:.1f}%, differential temperature {:.2f}, fan error "
+                            "{:.0f}%, temperature {:.2f}, FCUs mean {:.2f}).",
+                            i + 1, anomaly_names[a], state.heater_PWM, state.differential_temperature,
+                            state.fan_error * 100, state.absolute_temperature, _fleet_temperature);
+            } else {
+                SPDLOG_INFO("FCU {} anomaly cleared: {}.", i + 1, anomaly_names[a]);
+            }
+        }
+        state.reported = state.flags;
+    }
+
+    _fleet_temperature = count > 0 ? sum / count : NAN;
+
+    return anomalous;
+}
+
+void FcuAnomalyDetector::reset() {
+    for (auto &state : _fcus) {
+        state.initialized = false;
+        state.fan_error = 0;
+        state.heater_PWM = 0;
+        state.differential_temperature = NAN;
+        state.absolute_temperature = NAN;
+        for (auto &c : state.counters) {
+            c = 0;
+        }
+        state.flags = 0;
+        state.reported = 0;
+    }
+    _fleet_temperature = NAN;
+}
+
+void FcuAnomalyDetector::_persist(FcuState &state, Anomaly anomaly, bool condition, int persistence) {
+    uint8_t bit = 1 << anomaly;
+    bool flagged = state.flags & bit;
+
+    if (condition == flagged) {
+        state.counters[anomaly] = 0;
+        return;
+    }
+
+    state.counters[anomaly]++;
+    if (state.counters[anomaly] >= persistence) {
+        state.flags ^= bit;
+        state.counters[anomaly] = 0;
+    }
+}
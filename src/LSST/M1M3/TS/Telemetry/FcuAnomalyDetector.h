@@ -0,0 +1,109 @@
+/*
+ * Streaming FCU anomaly detection.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_FcuAnomalyDetector_
+#define _TS_Telemetry_FcuAnomalyDetector_
+
+#include <cstdint>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/ThermalILC.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Detects FCUs whose telemetry doesn't track their targets (FcuTargets) -
+ * stuck fans, dead heaters - and FCUs whose temperature drifts from other
+ * FCUs (drifting RTD). Exponentially weighted averages of the errors are
+ * kept per FCU; an anomaly is raised or cleared after its condition holds
+ * for Settings::FcuAnomaly::persistence samples. Changes are logged as
+ * warnings (forwarded to SAL logMessage). Update is O(1), the fleet mean
+ * used for RTD drift is calculated once per cycle in tick.
+ */
+class FcuAnomalyDetector final : public cRIO::Singleton<FcuAnomalyDetector> {
+public:
+    FcuAnomalyDetector(token);
+
+    enum Anomaly { FAN_STUCK, HEATER_DEAD, RTD_DRIFT, ANOMALIES };
+
+    /**
+     * Adds FCU sample.
+     *
+     * @param index FCU index (0 based)
+     * @param heater_PWM commanded heater PWM (%)
+     * @param target_fan_RPM commanded fan RPM
+     * @param differential_temperature measured differential temperature
+     * @param fan_RPM measured fan RPM
+     * @param absolute_temperature measured absolute temperature
+     */
+    void update(int index, float heater_PWM, int target_fan_RPM, float differential_temperature, int fan_RPM,
+                float absolute_temperature);
+
+    /**
+     * Reports changed anomalies and updates fleet mean temperature. Shall be
+     * called once per control cycle.
+     *
+     * @return number of FCUs with an anomaly
+     */
+    int tick();
+
+    /**
+     * Returns true if FCU has given anomaly.
+     */
+    bool has_anomaly(int index, Anomaly anomaly) const { return _fcus[index].flags & (1 << anomaly); }
+
+    /**
+     * Clears all state - averages, counters and anomalies.
+     */
+    void reset();
+
+    static const char *anomaly_names[ANOMALIES];
+
+private:
+    struct FcuState {
+        bool initialized;
+        // exponentially weighted averages
+        float fan_error;
+        float heater_PWM;
+        float differential_temperature;
+        float absolute_temperature;
+        // consecutive samples with condition different from flag
+        uint16_t counters[ANOMALIES];
+        uint8_t flags;
+        uint8_t reported;
+    };
+
+    void _persist(FcuState &state, Anomaly anomaly, bool condition, int persistence);
+
+    FcuState _fcus[cRIO::NUM_TS_ILC];
+    float _fleet_temperature;
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_FcuAnomalyDetector_
@@ -82,6 +82,12 @@ void FinerControl::set_target(float demand) {
     }
 }
 
+int FinerControl::snapshot(float &demand) {
+    std::lock_guard<std::mutex> lock_g(_lock);
+    demand = _last_setpoint;
+    return state;
+}
+
 float FinerControl::get_target(float valve_position) {
     std::lock_guard<std::mutex> lock_g(_lock);
 
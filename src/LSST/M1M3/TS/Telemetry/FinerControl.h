@@ -62,6 +62,16 @@ public:
      */
     float get_target(float valve_position);
 
+    /***
+     * Returns current state and mixing valve demand. Used to checkpoint
+     * controller state for warm restarts.
+     *
+     * @param[out] demand current mixing valve demand, in %
+     *
+     * @return current state machine state
+     */
+    int snapshot(float &demand);
+
     /***
      * State machine states.
      *
@@ -25,7 +25,8 @@
 #include <spdlog/spdlog.h>
 
 #include <IFPGA.h>
-#include <TSPublisher.h>
+#include <LiveState.h>
+#include <PublishQueue.h>
 #include <Telemetry/FlowMeterThread.h>
 
 using namespace LSST::M1M3::TS::Telemetry;
@@ -60,10 +61,8 @@ void FlowMeterThread::run(std::unique_lock<std::mutex>& lock) {
             positiveTotalizer = get_positive_totalizer();
             negativeTotalizer = get_negative_totalizer();
 
-            salReturn ret = TSPublisher::SAL()->putSample_flowMeter(this);
-            if (ret != SAL__OK) {
-                SPDLOG_WARN("Cannot send FlowMeter: {}", ret);
-            }
+            LiveState::instance().update(*this);
+            PublishQueue::instance().enqueue<MTM1M3TS_flowMeterC>(*this);
             error_count = 0;
         } catch (std::runtime_error& er) {
             if (error_count == 0) {
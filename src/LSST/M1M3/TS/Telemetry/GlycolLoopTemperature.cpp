@@ -26,7 +26,8 @@
 #include "Settings/Setpoint.h"
 #include "Tasks/Controller.h"
 #include "Telemetry/GlycolLoopTemperature.h"
-#include "TSPublisher.h"
+#include "LiveState.h"
+#include "PublishQueue.h"
 
 using namespace LSST::M1M3::TS::Telemetry;
 
@@ -40,30 +41,49 @@ GlycolLoopTemperature::GlycolLoopTemperature(token) {
     mirrorCoolantSupplyTemperature = NAN;
     mirrorCoolantReturnTemperature = NAN;
 
+    GlycolLoopSnapshot empty;
+    empty.frame = 0;
+    for (int i = 0; i < 8; i++) {
+        empty.temperatures[i] = NAN;
+    }
+    _snapshot.store(empty);
+
     _safety_violations_count = 0;
 }
 
 void GlycolLoopTemperature::update(const std::vector<float> &temperatures) {
-    {
-        const std::lock_guard<std::mutex> lock(_access_mutex);
-
-        aboveMirrorTemperature = temperatures[0];
-        insideCellTemperature1 = temperatures[1];
-        insideCellTemperature2 = temperatures[2];
-        insideCellTemperature3 = temperatures[3];
-        telescopeCoolantSupplyTemperature = temperatures[4];
-        telescopeCoolantReturnTemperature = temperatures[5];
-        mirrorCoolantSupplyTemperature = temperatures[6];
-        mirrorCoolantReturnTemperature = temperatures[7];
+    if (temperatures.size() < 8) {
+        throw std::runtime_error(
+                fmt::format("Expected 8 glycol loop temperatures, received {}.", temperatures.size()));
     }
+    update(temperatures.data());
+}
+
+void GlycolLoopTemperature::update(const float temperatures[8]) {
+    GlycolLoopSnapshot snapshot;
+    snapshot.frame = _snapshot.version();
+    snapshot.received = std::chrono::steady_clock::now();
+    for (int i = 0; i < 8; i++) {
+        snapshot.temperatures[i] = temperatures[i];
+    }
+    _snapshot.store(snapshot);
+
+    aboveMirrorTemperature = temperatures[0];
+    insideCellTemperature1 = temperatures[1];
+    insideCellTemperature2 = temperatures[2];
+    insideCellTemperature3 = temperatures[3];
+    telescopeCoolantSupplyTemperature = temperatures[4];
+    telescopeCoolantReturnTemperature = temperatures[5];
+    mirrorCoolantSupplyTemperature = temperatures[6];
+    mirrorCoolantReturnTemperature = temperatures[7];
 
     auto applied_glycol = Events::AppliedSetpoints::instance().get_applied_glycol_setpoint();
 
-    if (!isnan(applied_glycol)) {
+    if (!isnan(applied_glycol) && !isnan(snapshot.above_mirror())) {
         // check M1M3 measurements..
         auto &s_setpoint = Settings::Setpoint::instance();
 
-        float target_temp = get_above_mirror_temperature();
+        float target_temp = snapshot.above_mirror();
         float t_diff = applied_glycol - target_temp;
         if (abs(t_diff) > s_setpoint.safetyRange) {
             if (_safety_violations_count > s_setpoint.safetyMaxViolations) {
@@ -101,47 +121,36 @@ void GlycolLoopTemperature::update(const std::vector<float> &temperatures) {
         }
     }
 
-    salReturn ret = TSPublisher::SAL()->putSample_glycolLoopTemperature(this);
-    if (ret != SAL__OK) {
-        SPDLOG_WARN("Cannot send GlycolTemperatureThread: {}", ret);
-        return;
-    }
+    LiveState::instance().update(*this);
+    PublishQueue::instance().enqueue<MTM1M3TS_glycolLoopTemperatureC>(*this);
 }
 
 float GlycolLoopTemperature::get_above_mirror_temperature() {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    if (isnan(aboveMirrorTemperature)) {
+    auto snap = snapshot();
+    if (isnan(snap.above_mirror())) {
         throw std::runtime_error("Above mirror temperature requested before it was measured.");
     }
-    return aboveMirrorTemperature;
+    auto age = std::chrono::duration<float>(std::chrono::steady_clock::now() - snap.received).count();
+    auto max_age = Settings::Setpoint::instance().safetyAirTemperatureMaxAge;
+    if (age > max_age) {
+        throw std::runtime_error(
+                fmt::format("Above mirror temperature is too old - measured {:.1f} seconds ago, "
+                            "Setpoint/Safety/AirTemperatureMaxAge is {:.1f} seconds.",
+                            age, max_age));
+    }
+    return snap.above_mirror();
 }
 
-float GlycolLoopTemperature::get_mirror_cell_inside_temperature() {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    return (insideCellTemperature1 + insideCellTemperature2 + insideCellTemperature3) / 3.0;
-}
+float GlycolLoopTemperature::get_mirror_cell_inside_temperature() { return snapshot().mirror_cell_inside(); }
 
 float GlycolLoopTemperature::get_mirror_loop_average(float supply) {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    return (mirrorCoolantSupplyTemperature * supply) + (mirrorCoolantReturnTemperature * (1 - supply));
+    return snapshot().mirror_loop_average(supply);
 }
 
-float GlycolLoopTemperature::get_mirror_loop_supply() {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    return mirrorCoolantSupplyTemperature;
-}
+float GlycolLoopTemperature::get_mirror_loop_supply() { return snapshot().mirror_loop_supply(); }
 
-float GlycolLoopTemperature::get_mirror_loop_return() {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    return mirrorCoolantReturnTemperature;
-}
+float GlycolLoopTemperature::get_mirror_loop_return() { return snapshot().mirror_loop_return(); }
 
-float GlycolLoopTemperature::get_telescope_loop_supply() {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    return telescopeCoolantSupplyTemperature;
-}
+float GlycolLoopTemperature::get_telescope_loop_supply() { return snapshot().telescope_loop_supply(); }
 
-float GlycolLoopTemperature::get_telescope_loop_return() {
-    std::lock_guard<std::mutex> lock(_access_mutex);
-    return telescopeCoolantReturnTemperature;
-}
+float GlycolLoopTemperature::get_telescope_loop_return() { return snapshot().telescope_loop_return(); }
@@ -23,26 +23,77 @@
 #ifndef _TS_Telemetry_GlycolLoopTemperature_
 #define _TS_Telemetry_GlycolLoopTemperature_
 
-#include <mutex>
+#include <chrono>
 #include <vector>
 
 #include <SAL_MTM1M3TS.h>
 #include <cRIO/Singleton.h>
 
+#include "SeqLock.h"
+
 namespace LSST {
 namespace M1M3 {
 namespace TS {
 namespace Telemetry {
 
+/**
+ * Consistent copy of all glycol loop temperatures, received in a single
+ * sensor frame.
+ */
+struct GlycolLoopSnapshot {
+    /**
+     * Sensor frame number. 0 if no data were received.
+     */
+    uint64_t frame;
+
+    /**
+     * Time the frame was received.
+     */
+    std::chrono::steady_clock::time_point received;
+
+    /**
+     * Temperatures, in sensor order - above mirror, 3 inside cell, telescope
+     * supply and return, mirror supply and return.
+     */
+    float temperatures[8];
+
+    float above_mirror() const { return temperatures[0]; }
+
+    float mirror_cell_inside() const { return (temperatures[1] + temperatures[2] + temperatures[3]) / 3.0; }
+
+    float telescope_loop_supply() const { return temperatures[4]; }
+
+    float telescope_loop_return() const { return temperatures[5]; }
+
+    float mirror_loop_supply() const { return temperatures[6]; }
+
+    float mirror_loop_return() const { return temperatures[7]; }
+
+    float mirror_loop_average(float supply) const {
+        return (mirror_loop_supply() * supply) + (mirror_loop_return() * (1 - supply));
+    }
+};
+
 /**
  * Class holding and publishing glycol loop temperature telemetry. A singleton,
  * from which various glycol loop temperatures can be accessed.
+ *
+ * Values are stored in a sequence lock, written by GlycolTemperatureThread.
+ * Readers needing more than a single value shall use snapshot(), which
+ * provides consistent values from a single sensor frame without locking.
  */
 class GlycolLoopTemperature final : MTM1M3TS_glycolLoopTemperatureC,
                                     public cRIO::Singleton<GlycolLoopTemperature> {
 public:
     GlycolLoopTemperature(token);
 
+    /**
+     * Returns consistent copy of the last received temperatures. Lock free.
+     *
+     * @return last received temperatures
+     */
+    GlycolLoopSnapshot snapshot() const { return _snapshot.load(); }
+
     /**
      * Retrieves values from parsed float array, set internal values, and sends
      * updated telemetry through SAL/DDS.
@@ -51,10 +102,21 @@ public:
      */
     void update(const std::vector<float> &temperatures);
 
+    /**
+     * Set internal values from 8 temperatures, and sends updated telemetry
+     * through SAL/DDS. Doesn't allocate memory.
+     *
+     * @param temperatures 8 position array with temperature values
+     */
+    void update(const float temperatures[8]);
+
     /**
      * Retrieves last air temperature, measured above the mirror
      *
      * @return above mirror air temperature
+     *
+     * @throw std::runtime_error if the temperature wasn't measured or is
+     * older than Setpoint/Safety/AirTemperatureMaxAge
      */
     float get_above_mirror_temperature();
 
@@ -95,7 +157,7 @@ public:
     float get_telescope_loop_return();
 
 private:
-    std::mutex _access_mutex;
+    SeqLock<GlycolLoopSnapshot> _snapshot;
 
     int _safety_violations_count;
 };
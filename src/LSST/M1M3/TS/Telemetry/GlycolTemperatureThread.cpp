@@ -45,5 +45,7 @@ void GlycolTemperatureThread::updated() {
         Events::SummaryState::instance().fail(Events::ErrorCode::TemperatureSensors,
                                               "Cannot read data from the temperature sensors", "");
     }
-    GlycolLoopTemperature::instance().update(getTemperatures());
+    float temperatures[GlycolTemperatureParser::CHANNELS];
+    getTemperatures(temperatures);
+    GlycolLoopTemperature::instance().update(temperatures);
 }
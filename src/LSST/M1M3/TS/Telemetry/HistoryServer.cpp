@@ -0,0 +1,156 @@
+/*
+ * Local socket server answering telemetry history queries.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "Telemetry/HistoryServer.h"
+#include "Telemetry/TelemetryHistory.h"
+
+using namespace LSST::M1M3::TS::Telemetry;
+using namespace std::chrono_literals;
+
+constexpr size_t MAX_REQUEST = 256;
+
+HistoryServer::HistoryServer(const std::string &path) : _path(path), _socket(-1) {}
+
+HistoryServer::~HistoryServer() {
+    if (_socket >= 0) {
+        close(_socket);
+        unlink(_path.c_str());
+    }
+}
+
+std::string HistoryServer::process(const std::string &request) {
+    std::istringstream is(request);
+    float window = NAN;
+    std::string pattern;
+
+    is >> window >> pattern;
+    if (is.fail() || !(window > 0)) {
+        return "ERROR expected <window (seconds)> <column>\n";
+    }
+
+    auto stats = TelemetryHistory::instance().query(window, pattern);
+    if (stats.empty()) {
+        return fmt::format("ERROR no column matches {}\n", pattern);
+    }
+
+    std::string ret;
+    for (auto &s : stats) {
+        ret += fmt::format("{} {} {:.4f} {:.4f} {:.4f}\n", s.name, s.count, s.min, s.max, s.mean);
+    }
+    return ret;
+}
+
+void HistoryServer::run(std::unique_lock<std::mutex> &lock) {
+    if (_path.length() >= sizeof(sockaddr_un::sun_path)) {
+        SPDLOG_ERROR("History socket path {} is too long, history queries disabled.", _path);
+        return;
+    }
+
+    _socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_socket < 0) {
+        SPDLOG_ERROR("Cannot create history socket: {}", strerror(errno));
+        return;
+    }
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, _path.c_str(), sizeof(addr.sun_path) - 1);
+
+    unlink(_path.c_str());
+    if (bind(_socket, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(_socket, 4) < 0) {
+        SPDLOG_ERROR("Cannot listen on history socket {}: {}", _path, strerror(errno));
+        return;
+    }
+
+    SPDLOG_INFO("Serving telemetry history on {}.", _path);
+
+    while (keepRunning) {
+        pollfd pfd = {_socket, POLLIN, 0};
+        lock.unlock();
+        int ret = poll(&pfd, 1, 200);
+        lock.lock();
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SPDLOG_ERROR("Error polling history socket: {}", strerror(errno));
+            return;
+        }
+        if (ret == 0) {
+            continue;
+        }
+
+        int client = accept(_socket, nullptr, nullptr);
+        if (client < 0) {
+            SPDLOG_WARN("Cannot accept history connection: {}", strerror(errno));
+            continue;
+        }
+        lock.unlock();
+        _serve(client);
+        lock.lock();
+        close(client);
+    }
+}
+
+void HistoryServer::_serve(int client) {
+    std::string request;
+    char buf[64];
+
+    // read request line; don't let a stalled client block the server
+    while (request.find('\n') == std::string::npos && request.length() < MAX_REQUEST) {
+        pollfd pfd = {client, POLLIN, 0};
+        if (poll(&pfd, 1, 1000) <= 0) {
+            SPDLOG_WARN("Timeout reading history request.");
+            return;
+        }
+        ssize_t len = read(client, buf, sizeof(buf));
+        if (len <= 0) {
+            break;
+        }
+        request.append(buf, len);
+    }
+
+    auto response = process(request);
+    const char *data = response.c_str();
+    size_t left = response.length();
+    while (left > 0) {
+        ssize_t len = send(client, data, left, MSG_NOSIGNAL);
+        if (len <= 0) {
+            SPDLOG_WARN("Cannot send history response: {}", strerror(errno));
+            return;
+        }
+        data += len;
+        left -= len;
+    }
+}
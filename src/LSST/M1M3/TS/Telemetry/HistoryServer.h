@@ -0,0 +1,70 @@
+/*
+ * Local socket server answering telemetry history queries.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_HistoryServer_
+#define _TS_Telemetry_HistoryServer_
+
+#include <string>
+
+#include <cRIO/Thread.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Serves TelemetryHistory queries on a local (UNIX domain) socket. A client
+ * sends a single line with window length (seconds) and column pattern,
+ * server replies with a line per matching column - name, count, min, max
+ * and mean - and closes the connection.
+ */
+class HistoryServer final : public cRIO::Thread {
+public:
+    HistoryServer(const std::string &path);
+    ~HistoryServer();
+
+    /**
+     * Process single query line.
+     *
+     * @param request query line (window and pattern)
+     *
+     * @return response send back to the client
+     */
+    static std::string process(const std::string &request);
+
+protected:
+    void run(std::unique_lock<std::mutex> &lock) override;
+
+private:
+    void _serve(int client);
+
+    std::string _path;
+    int _socket;
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_HistoryServer_
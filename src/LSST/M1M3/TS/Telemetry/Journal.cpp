@@ -0,0 +1,488 @@
+/*
+ * Memory mapped columnar telemetry journal.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "Settings/Journal.h"
+#include "Telemetry/Journal.h"
+
+using namespace LSST::M1M3::TS::Telemetry;
+using namespace std::chrono_literals;
+
+constexpr size_t PAGE = 4096;
+constexpr double RETRY_INTERVAL = 60;
+
+JournalFile::JournalFile(const std::string &path, const std::string &topic,
+                         const std::vector<std::string> &columns, size_t size, double created)
+        : _path(path) {
+    size_t names = 0;
+    for (auto &c : columns) {
+        names += c.length() + 1;
+    }
+    size_t header_size = ((sizeof(JournalHeader) + names + PAGE - 1) / PAGE) * PAGE;
+    size_t block = block_size(columns.size());
+    size_t blocks = size > header_size ? (size - header_size) / block : 0;
+    if (blocks == 0) {
+        blocks = 1;
+    }
+    _size = header_size + blocks * block;
+
+    _fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (_fd < 0) {
+        throw std::runtime_error(fmt::format("cannot create {}: {}", path, strerror(errno)));
+    }
+
+    int ret = posix_fallocate(_fd, 0, _size);
+    if (ret != 0) {
+        ::close(_fd);
+        unlink(path.c_str());
+        throw std::runtime_error(fmt::format("cannot allocate {} bytes for {}: {}", _size, path, strerror(ret)));
+    }
+
+    void *map = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(_fd);
+        unlink(path.c_str());
+        throw std::runtime_error(fmt::format("cannot map {}: {}", path, strerror(errno)));
+    }
+    _map = static_cast<uint8_t *>(map);
+    _header = reinterpret_cast<JournalHeader *>(_map);
+
+    memset(_header, 0, sizeof(JournalHeader));
+    strncpy(_header->magic, MAGIC, sizeof(_header->magic));
+    _header->version = VERSION;
+    _header->columns = columns.size();
+    _header->block_rows = BLOCK_ROWS;
+    _header->header_size = header_size;
+    _header->rows = 0;
+    _header->capacity = blocks * BLOCK_ROWS;
+    _header->created = created;
+    strncpy(_header->topic, topic.c_str(), sizeof(_header->topic) - 1);
+
+    char *name = reinterpret_cast<char *>(_map + sizeof(JournalHeader));
+    for (auto &c : columns) {
+        memcpy(name, c.c_str(), c.length() + 1);
+        name += c.length() + 1;
+    }
+}
+
+JournalFile::~JournalFile() {
+    uint64_t blocks = (_header->rows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    size_t used = _header->header_size + blocks * block_size(_header->columns);
+
+    munmap(_map, _size);
+    if (ftruncate(_fd, used) != 0) {
+        SPDLOG_WARN("Cannot truncate journal {}: {}", _path, strerror(errno));
+    }
+    ::close(_fd);
+}
+
+bool JournalFile::append(double timestamp, const float *values) {
+    uint64_t row = _header->rows;
+    if (row >= _header->capacity) {
+        return false;
+    }
+
+    uint8_t *block = _map + _header->header_size + (row / BLOCK_ROWS) * block_size(_header->columns);
+    size_t i = row % BLOCK_ROWS;
+
+    reinterpret_cast<double *>(block)[i] = timestamp;
+    float *data = reinterpret_cast<float *>(block + BLOCK_ROWS * sizeof(double));
+    for (size_t c = 0; c < _header->columns; c++) {
+        data[c * BLOCK_ROWS + i] = values[c];
+    }
+
+    // readers of the live file see only complete rows
+    __atomic_store_n(&_header->rows, row + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool JournalFile::rename(const std::string &path, double created) {
+    // link fails if the path exists, rename would overwrite it
+    if (link(_path.c_str(), path.c_str()) != 0) {
+        if (errno == EEXIST) {
+            return false;
+        }
+        throw std::runtime_error(fmt::format("cannot link {} to {}: {}", _path, path, strerror(errno)));
+    }
+    if (unlink(_path.c_str()) != 0) {
+        SPDLOG_WARN("Cannot remove {}: {}", _path, strerror(errno));
+    }
+    _path = path;
+    _header->created = created;
+    return true;
+}
+
+JournalReader::JournalReader(const std::string &path) {
+    _fd = open(path.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        throw std::runtime_error(fmt::format("cannot open {}: {}", path, strerror(errno)));
+    }
+
+    struct stat st;
+    if (fstat(_fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(JournalHeader)) {
+        ::close(_fd);
+        throw std::runtime_error(fmt::format("{} is not a journal file", path));
+    }
+    _size = st.st_size;
+
+    void *map = mmap(nullptr, _size, PROT_READ, MAP_SHARED, _fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(_fd);
+        throw std::runtime_error(fmt::format("cannot map {}: {}", path, strerror(errno)));
+    }
+    _map = static_cast<const uint8_t *>(map);
+
+    auto header = reinterpret_cast<const JournalHeader *>(_map);
+    if (strncmp(header->magic, JournalFile::MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != JournalFile::VERSION || header->block_rows == 0 ||
+        header->header_size < sizeof(JournalHeader) || header->header_size > _size) {
+        munmap(const_cast<uint8_t *>(_map), _size);
+        ::close(_fd);
+        throw std::runtime_error(fmt::format("{} is not a valid journal file", path));
+    }
+
+    _block_rows = header->block_rows;
+    _header_size = header->header_size;
+    _topic = std::string(header->topic, strnlen(header->topic, sizeof(header->topic)));
+
+    const char *name = reinterpret_cast<const char *>(_map + sizeof(JournalHeader));
+    const char *end = reinterpret_cast<const char *>(_map + _header_size);
+    for (uint32_t c = 0; c < header->columns && name < end; c++) {
+        size_t len = strnlen(name, end - name);
+        _columns.emplace_back(name, len);
+        name += len + 1;
+    }
+
+    // file of a crashed CSC might be truncated
+    size_t block = _block_rows * (sizeof(double) + _columns.size() * sizeof(float));
+    uint64_t complete = (_size - _header_size) / block * _block_rows;
+    _rows = std::min(__atomic_load_n(&header->rows, __ATOMIC_ACQUIRE), complete);
+}
+
+JournalReader::~JournalReader() {
+    munmap(const_cast<uint8_t *>(_map), _size);
+    ::close(_fd);
+}
+
+double JournalReader::timestamp(uint64_t row) const {
+    return reinterpret_cast<const double *>(_block(row))[row % _block_rows];
+}
+
+float JournalReader::value(uint64_t row, size_t column) const {
+    auto data = reinterpret_cast<const float *>(_block(row) + _block_rows * sizeof(double));
+    return data[column * _block_rows + row % _block_rows];
+}
+
+void JournalReader::export_csv(std::ostream &os) const {
+    os << "timestamp";
+    for (auto &c : _columns) {
+        os << "," << _topic << "." << c;
+    }
+    os << std::endl;
+
+    fmt::memory_buffer buf;
+    for (uint64_t r = 0; r < _rows; r++) {
+        buf.clear();
+        fmt::format_to(std::back_inserter(buf), "{:.6f}", timestamp(r));
+        for (size_t c = 0; c < _columns.size(); c++) {
+            fmt::format_to(std::back_inserter(buf), ",{}", value(r, c));
+        }
+        buf.push_back('\n');
+        os.write(buf.data(), buf.size());
+    }
+}
+
+const uint8_t *JournalReader::_block(uint64_t row) const {
+    return _map + _header_size +
+           (row / _block_rows) * _block_rows * (sizeof(double) + _columns.size() * sizeof(float));
+}
+
+Journal::Journal(token) { _working = false; }
+
+void Journal::append(const std::string &topic, const std::vector<std::string> &columns, double timestamp,
+                     const float *values) {
+    auto &settings = Settings::Journal::instance();
+
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    if (settings.enabled == false) {
+        _clear();
+        return;
+    }
+
+    if (settings.directory != _directory) {
+        _clear();
+        _retry_after.clear();
+        _directory = settings.directory;
+    }
+
+    auto &file = _files[topic];
+    if (file == nullptr || timestamp - file->created() >= settings.rotationInterval) {
+        _rotate(topic, columns, timestamp);
+    }
+
+    if (file == nullptr) {
+        return;
+    }
+
+    if (file->append(timestamp, values) == false) {
+        _rotate(topic, columns, timestamp);
+        if (file != nullptr) {
+            file->append(timestamp, values);
+        }
+    }
+}
+
+void Journal::close() {
+    std::lock_guard<std::mutex> lg(_mutex);
+    _clear();
+}
+
+bool Journal::flush(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> ql(_queue_mutex);
+    return _queue_condition.wait_for(ql, timeout, [this] { return _jobs.empty() && _working == false; });
+}
+
+void Journal::run(std::unique_lock<std::mutex> &lock) {
+    // appends notify _queue_condition, the thread lock is held only by stop
+    lock.unlock();
+
+    SPDLOG_INFO("Running journal thread.");
+
+    std::unique_lock<std::mutex> ql(_queue_mutex);
+    while (keepRunning || _jobs.empty() == false) {
+        if (_jobs.empty()) {
+            _queue_condition.wait_for(ql, 100ms);
+            continue;
+        }
+
+        Job job = std::move(_jobs.front());
+        _jobs.pop_front();
+        _working = true;
+        ql.unlock();
+
+        auto created = _process(job);
+
+        // spare is stored unless the journal was reconfigured in between
+        if (created != nullptr) {
+            std::lock_guard<std::mutex> lg(_mutex);
+            auto &spare = _spares[job.topic];
+            if (Settings::Journal::instance().enabled && job.directory == _directory &&
+                spare.file == nullptr) {
+                spare.file = std::move(created);
+                spare.columns = job.columns;
+            }
+        }
+        if (created != nullptr) {
+            auto path = created->path();
+            created.reset();
+            unlink(path.c_str());
+        }
+
+        ql.lock();
+        _working = false;
+        _queue_condition.notify_all();
+    }
+
+    SPDLOG_INFO("Journal thread stopped.");
+
+    ql.unlock();
+    lock.lock();
+}
+
+void Journal::_rotate(const std::string &topic, const std::vector<std::string> &columns, double timestamp) {
+    auto &file = _files[topic];
+    Job job{_directory, topic, columns, std::move(file), false};
+
+    // nothing to retire while waiting for the retry
+    auto retry = _retry_after.find(topic);
+    if (retry != _retry_after.end() && timestamp < retry->second) {
+        if (job.retired != nullptr) {
+            _schedule(std::move(job));
+        }
+        return;
+    }
+
+    if (mkdir(_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        SPDLOG_ERROR("Cannot create journal directory {}: {}", _directory, strerror(errno));
+        _retry_after[topic] = timestamp + RETRY_INTERVAL;
+        if (job.retired != nullptr) {
+            _schedule(std::move(job));
+        }
+        return;
+    }
+
+    time_t now = timestamp;
+    struct tm tm;
+    char date[20];
+    strftime(date, sizeof(date), "%Y%m%dT%H%M%S", gmtime_r(&now, &tm));
+
+    try {
+        std::unique_ptr<JournalFile> next;
+
+        auto spare = _spares.find(topic);
+        if (spare != _spares.end()) {
+            if (spare->second.columns == columns) {
+                next = std::move(spare->second.file);
+            }
+            _spares.erase(spare);
+        }
+        if (next == nullptr) {
+            if (job.retired != nullptr && isRunning()) {
+                SPDLOG_WARN("Spare {} journal isn't ready, creating it on the publish thread.", topic);
+            }
+            next = _create(fmt::format("{}/.{}.new", _directory, topic), topic, columns);
+        }
+
+        // second rotation within the same second gets a sequence suffix
+        for (int seq = 0; file == nullptr; seq++) {
+            if (seq >= 1000) {
+                throw std::runtime_error(fmt::format("no free file name for {} {}", topic, date));
+            }
+            auto path = seq == 0 ? fmt::format("{}/{}_{}.journal", _directory, topic, date)
+                                 : fmt::format("{}/{}_{}_{:03d}.journal", _directory, topic, date, seq);
+            if (next->rename(path, timestamp)) {
+                SPDLOG_INFO("Journaling {} into {}.", topic, path);
+                file = std::move(next);
+            }
+        }
+        _retry_after.erase(topic);
+        job.create_spare = true;
+    } catch (std::runtime_error &er) {
+        SPDLOG_ERROR("Cannot open {} journal: {}", topic, er.what());
+        _retry_after[topic] = timestamp + RETRY_INTERVAL;
+        if (job.retired == nullptr) {
+            return;
+        }
+    }
+
+    _schedule(std::move(job));
+}
+
+void Journal::_schedule(Job job) {
+    if (isRunning() == false) {
+        job.retired.reset();
+        _remove_old(job.directory, job.topic);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(_queue_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _queue_condition.notify_all();
+}
+
+std::unique_ptr<JournalFile> Journal::_process(Job &job) {
+    // unmaps and truncates the rotated file
+    job.retired.reset();
+
+    _remove_old(job.directory, job.topic);
+
+    if (job.create_spare == false) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(_mutex);
+        auto spare = _spares.find(job.topic);
+        if (job.directory != _directory || (spare != _spares.end() && spare->second.file != nullptr)) {
+            return nullptr;
+        }
+    }
+
+    try {
+        return _create(fmt::format("{}/.{}.spare", job.directory, job.topic), job.topic, job.columns);
+    } catch (std::runtime_error &er) {
+        SPDLOG_WARN("Cannot create spare {} journal: {}", job.topic, er.what());
+    }
+    return nullptr;
+}
+
+void Journal::_clear() {
+    _files.clear();
+    for (auto &spare : _spares) {
+        if (spare.second.file == nullptr) {
+            continue;
+        }
+        auto path = spare.second.file->path();
+        spare.second.file.reset();
+        unlink(path.c_str());
+    }
+    _spares.clear();
+}
+
+std::unique_ptr<JournalFile> Journal::_create(const std::string &path, const std::string &topic,
+                                              const std::vector<std::string> &columns) {
+    // left behind by a crashed CSC
+    unlink(path.c_str());
+    return std::make_unique<JournalFile>(path, topic, columns, Settings::Journal::instance().fileSize, 0);
+}
+
+void Journal::_remove_old(const std::string &directory, const std::string &topic) {
+    DIR *dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+
+    std::vector<std::string> journals;
+    std::string prefix = topic + "_";
+    std::string suffix = ".journal";
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name(entry->d_name);
+        if (name.length() > prefix.length() + suffix.length() && name.compare(0, prefix.length(), prefix) == 0 &&
+            name.compare(name.length() - suffix.length(), suffix.length(), suffix) == 0) {
+            journals.push_back(name);
+        }
+    }
+    closedir(dir);
+
+    int keep = Settings::Journal::instance().keep;
+    if (journals.size() <= static_cast<size_t>(keep)) {
+        return;
+    }
+
+    // names contain UTC date (and sequence suffix), sorting them sorts files by creation time
+    std::sort(journals.begin(), journals.end());
+    for (size_t i = 0; i < journals.size() - keep; i++) {
+        auto path = directory + "/" + journals[i];
+        SPDLOG_INFO("Removing old journal {}.", path);
+        if (unlink(path.c_str()) != 0) {
+            SPDLOG_WARN("Cannot remove {}: {}", path, strerror(errno));
+        }
+    }
+}
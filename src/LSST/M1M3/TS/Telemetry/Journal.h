@@ -0,0 +1,257 @@
+/*
+ * Memory mapped columnar telemetry journal.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_Journal_
+#define _TS_Telemetry_Journal_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/Thread.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Journal file header. Followed by NUL separated column names, data blocks
+ * start at header_size offset. Each block holds block_rows rows - first
+ * block_rows double timestamps, then block_rows floats of every column.
+ */
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t columns;
+    uint32_t block_rows;
+    uint32_t header_size;
+    // number of complete rows, updated after row is written
+    uint64_t rows;
+    uint64_t capacity;
+    double created;
+    char topic[64];
+};
+
+/**
+ * Single journal file, preallocated and memory mapped for writing.
+ */
+class JournalFile {
+public:
+    static constexpr const char *MAGIC = "M1M3TSJ";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t BLOCK_ROWS = 256;
+
+    /**
+     * Creates and maps the journal file.
+     *
+     * @param path file path
+     * @param topic topic name
+     * @param columns column names
+     * @param size preallocated file size, in bytes
+     * @param created creation timestamp
+     *
+     * @throw std::runtime_error on error
+     */
+    JournalFile(const std::string &path, const std::string &topic, const std::vector<std::string> &columns,
+                size_t size, double created);
+
+    /**
+     * Unmaps the file and truncates it to the written blocks.
+     */
+    ~JournalFile();
+
+    /**
+     * Appends row.
+     *
+     * @param timestamp row timestamp
+     * @param values column values
+     *
+     * @return false if file is full
+     */
+    bool append(double timestamp, const float *values);
+
+    /**
+     * Links the file under a new name and removes the old name. Used to
+     * publish a pre-created file under its final name.
+     *
+     * @param path new file path
+     * @param created creation timestamp written into the header
+     *
+     * @return false if the path already exists
+     *
+     * @throw std::runtime_error on other errors
+     */
+    bool rename(const std::string &path, double created);
+
+    double created() const { return _header->created; }
+
+    uint64_t rows() const { return _header->rows; }
+
+    const std::string &path() const { return _path; }
+
+    static size_t block_size(size_t columns) {
+        return BLOCK_ROWS * (sizeof(double) + columns * sizeof(float));
+    }
+
+private:
+    std::string _path;
+    int _fd;
+    uint8_t *_map;
+    size_t _size;
+    JournalHeader *_header;
+};
+
+/**
+ * Read only access to a journal file.
+ */
+class JournalReader {
+public:
+    /**
+     * @throw std::runtime_error if file cannot be read or isn't a valid journal
+     */
+    JournalReader(const std::string &path);
+    ~JournalReader();
+
+    const std::string &topic() const { return _topic; }
+
+    const std::vector<std::string> &columns() const { return _columns; }
+
+    uint64_t rows() const { return _rows; }
+
+    double timestamp(uint64_t row) const;
+
+    float value(uint64_t row, size_t column) const;
+
+    /**
+     * Writes rows as CSV - timestamp and all columns.
+     */
+    void export_csv(std::ostream &os) const;
+
+private:
+    const uint8_t *_block(uint64_t row) const;
+
+    int _fd;
+    const uint8_t *_map;
+    size_t _size;
+    uint32_t _block_rows;
+    uint32_t _header_size;
+    uint64_t _rows;
+    std::string _topic;
+    std::vector<std::string> _columns;
+};
+
+/**
+ * Appends published telemetry to per-topic journal files. Files are rotated
+ * when full or older than the rotation interval, only Settings::Journal::keep
+ * newest files of a topic are kept.
+ *
+ * Appends run on the publish thread. When the journal thread is running, it
+ * closes the rotated files, removes old files and pre-creates (allocates and
+ * maps) a spare file for every topic. A rotation then only links the spare
+ * under its final name. The first file of a topic, or a file needed before
+ * its spare is ready, is created on the publish thread. If the thread isn't
+ * running, all work is done on the publish thread.
+ */
+class Journal final : public cRIO::Thread, public cRIO::Singleton<Journal> {
+public:
+    Journal(token);
+
+    /**
+     * Appends row to the topic journal. Doesn't do anything if journal is
+     * disabled.
+     */
+    void append(const std::string &topic, const std::vector<std::string> &columns, double timestamp,
+                const float *values);
+
+    /**
+     * Closes all journal files and removes spare files.
+     */
+    void close();
+
+    /**
+     * Waits until the journal thread finishes all pending work.
+     *
+     * @param timeout maximal time to wait
+     *
+     * @return true if no work is pending, false on timeout
+     */
+    bool flush(std::chrono::milliseconds timeout);
+
+protected:
+    void run(std::unique_lock<std::mutex> &lock) override;
+
+private:
+    struct Spare {
+        std::unique_ptr<JournalFile> file;
+        std::vector<std::string> columns;
+    };
+
+    /**
+     * Work done after a rotation - closing the rotated file, removing old
+     * files and creating the next spare file.
+     */
+    struct Job {
+        std::string directory;
+        std::string topic;
+        std::vector<std::string> columns;
+        std::unique_ptr<JournalFile> retired;
+        // false after a failed open, so the spare isn't retried before _retry_after
+        bool create_spare;
+    };
+
+    void _rotate(const std::string &topic, const std::vector<std::string> &columns, double timestamp);
+    void _schedule(Job job);
+    std::unique_ptr<JournalFile> _process(Job &job);
+    void _clear();
+
+    static std::unique_ptr<JournalFile> _create(const std::string &path, const std::string &topic,
+                                                const std::vector<std::string> &columns);
+    static void _remove_old(const std::string &directory, const std::string &topic);
+
+    std::mutex _mutex;
+    std::string _directory;
+    std::map<std::string, std::unique_ptr<JournalFile>> _files;
+    std::map<std::string, Spare> _spares;
+    // don't retry too often after a failure
+    std::map<std::string, double> _retry_after;
+
+    std::mutex _queue_mutex;
+    std::condition_variable _queue_condition;
+    std::deque<Job> _jobs;
+    bool _working;
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_Journal_
@@ -29,7 +29,8 @@
 #include "Settings/MixingValve.h"
 #include "Telemetry/FinerControl.h"
 #include "Telemetry/MixingValve.h"
-#include "TSPublisher.h"
+#include "LiveState.h"
+#include "PublishQueue.h"
 
 using namespace LSST::M1M3::TS;
 using namespace LSST::M1M3::TS::Telemetry;
@@ -46,9 +47,6 @@ void MixingValve::sendPosition(float position) {
         IFPGA::get().setMixingValvePosition(target);
     }
 
-    salReturn ret = TSPublisher::SAL()->putSample_mixingValve(this);
-    if (ret != SAL__OK) {
-        SPDLOG_WARN("Cannot send mixingValve: {}", ret);
-        return;
-    }
+    LiveState::instance().update(*this);
+    PublishQueue::instance().enqueue<MTM1M3TS_mixingValveC>(*this);
 }
@@ -29,7 +29,8 @@
 #include "Events/GlycolPumpStatus.h"
 #include "Events/SummaryState.h"
 #include "IFPGA.h"
-#include "TSPublisher.h"
+#include "LiveState.h"
+#include "PublishQueue.h"
 #include "Telemetry/PumpThread.h"
 #include "Settings/GlycolPump.h"
 
@@ -140,10 +141,8 @@ void PumpThread::run(std::unique_lock<std::mutex>& lock) {
             _fail_after = std::chrono::steady_clock::now() +
                           std::chrono::seconds(pump_settings.communicationTimeout);
 
-            salReturn ret = TSPublisher::SAL()->putSample_glycolPump(this);
-            if (ret != SAL__OK) {
-                SPDLOG_WARN("Cannot send VFD: {}", ret);
-            }
+            LiveState::instance().update(*this);
+            PublishQueue::instance().enqueue<MTM1M3TS_glycolPumpC>(*this);
 
             _success_count++;
             if (n_r == STARTUP) {
@@ -0,0 +1,321 @@
+/*
+ * In-memory columnar telemetry history.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <spdlog/spdlog.h>
+
+#include <cRIO/ThermalILC.h>
+
+#include "Settings/TelemetryHistory.h"
+#include "Telemetry/Journal.h"
+#include "Telemetry/TelemetryHistory.h"
+
+using namespace LSST::M1M3::TS::Telemetry;
+
+HistoryTable::HistoryTable(const char *topic) : _topic(topic) {
+    _capacity = 0;
+    _size = 0;
+    _head = 0;
+}
+
+void HistoryTable::add_column(const std::string &name) {
+    _columns.push_back(name);
+    _staging.resize(_columns.size(), NAN);
+    resize(_capacity);
+}
+
+void HistoryTable::resize(size_t capacity) {
+    _capacity = capacity;
+    _size = 0;
+    _head = 0;
+
+    _timestamps.assign(_capacity, NAN);
+    _values.assign(_capacity * _columns.size(), NAN);
+    _timestamps.shrink_to_fit();
+    _values.shrink_to_fit();
+}
+
+void HistoryTable::append(double timestamp) {
+    if (_capacity == 0) {
+        return;
+    }
+
+    size_t row = (_head + _size) % _capacity;
+    if (_size == _capacity) {
+        _head = (_head + 1) % _capacity;
+    } else {
+        _size++;
+    }
+
+    _timestamps[row] = timestamp;
+    for (size_t c = 0; c < _columns.size(); c++) {
+        _values[c * _capacity + row] = _staging[c];
+    }
+}
+
+void HistoryTable::query(double since, const std::string &pattern,
+                         std::vector<ColumnStatistics> &result) const {
+    // rows are ordered by time, find the first row inside the window
+    size_t first = _size;
+    for (size_t i = 0; i < _size; i++) {
+        if (_timestamps[(_head + i) % _capacity] >= since) {
+            first = i;
+            break;
+        }
+    }
+
+    for (size_t c = 0; c < _columns.size(); c++) {
+        if (_matches(_columns[c], pattern) == false) {
+            continue;
+        }
+
+        ColumnStatistics stat = {_topic + "." + _columns[c], 0, NAN, NAN, NAN};
+        double sum = 0;
+        auto column = _values.data() + c * _capacity;
+
+        for (size_t i = first; i < _size; i++) {
+            float v = column[(_head + i) % _capacity];
+            if (std::isnan(v)) {
+                continue;
+            }
+            if (stat.count == 0) {
+                stat.min = stat.max = v;
+            } else {
+                stat.min = std::min(stat.min, v);
+                stat.max = std::max(stat.max, v);
+            }
+            sum += v;
+            stat.count++;
+        }
+
+        if (stat.count > 0) {
+            stat.mean = sum / stat.count;
+        }
+
+        result.push_back(stat);
+    }
+}
+
+bool HistoryTable::_matches(const std::string &column, const std::string &pattern) const {
+    if (pattern == _topic) {
+        return true;
+    }
+
+    if (pattern.compare(0, _topic.length() + 1, _topic + ".") != 0) {
+        return false;
+    }
+
+    auto name = pattern.substr(_topic.length() + 1);
+    if (column == name) {
+        return true;
+    }
+
+    // pattern without index matches all indices
+    return column.length() > name.length() && column.compare(0, name.length(), name) == 0 &&
+           column[name.length()] == '[';
+}
+
+constexpr float THERMAL_DATA_RATE = 2;
+constexpr float GLYCOL_LOOP_TEMPERATURE_RATE = 2;
+constexpr float MIXING_VALVE_RATE = 2;
+constexpr float FLOW_METER_RATE = 0.5;
+constexpr float GLYCOL_PUMP_RATE = 0.5;
+
+TelemetryHistory::TelemetryHistory(token)
+        : _thermal_data("thermalData"),
+          _glycol_loop_temperature("glycolLoopTemperature"),
+          _mixing_valve("mixingValve"),
+          _flow_meter("flowMeter"),
+          _glycol_pump("glycolPump") {
+    _length = 0;
+
+    for (auto name : {"differentialTemperature", "fanRPM", "absoluteTemperature"}) {
+        for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+            _thermal_data.add_column(fmt::format("{}[{}]", name, i));
+        }
+    }
+
+    for (auto name : {"aboveMirrorTemperature", "insideCellTemperature1", "insideCellTemperature2",
+                      "insideCellTemperature3", "telescopeCoolantSupplyTemperature",
+                      "telescopeCoolantReturnTemperature", "mirrorCoolantSupplyTemperature",
+                      "mirrorCoolantReturnTemperature"}) {
+        _glycol_loop_temperature.add_column(name);
+    }
+
+    for (auto name : {"rawValvePosition", "valvePosition"}) {
+        _mixing_valve.add_column(name);
+    }
+
+    for (auto name : {"signalStrength", "flowRate", "netTotalizer", "positiveTotalizer", "negativeTotalizer"}) {
+        _flow_meter.add_column(name);
+    }
+
+    for (auto name : {"commandedFrequency", "targetFrequency", "outputFrequency", "speedFeedback",
+                      "outputCurrent", "busVoltage", "outputVoltage"}) {
+        _glycol_pump.add_column(name);
+    }
+}
+
+void TelemetryHistory::record(const MTM1M3TS_thermalDataC &data) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    auto row = _thermal_data.staging();
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        row[i] = data.differentialTemperature[i];
+        row[LSST::cRIO::NUM_TS_ILC + i] = data.fanRPM[i];
+        row[2 * LSST::cRIO::NUM_TS_ILC + i] = data.absoluteTemperature[i];
+    }
+    _append(_thermal_data);
+}
+
+void TelemetryHistory::record(const MTM1M3TS_glycolLoopTemperatureC &data) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    auto row = _glycol_loop_temperature.staging();
+    row[0] = data.aboveMirrorTemperature;
+    row[1] = data.insideCellTemperature1;
+    row[2] = data.insideCellTemperature2;
+    row[3] = data.insideCellTemperature3;
+    row[4] = data.telescopeCoolantSupplyTemperature;
+    row[5] = data.telescopeCoolantReturnTemperature;
+    row[6] = data.mirrorCoolantSupplyTemperature;
+    row[7] = data.mirrorCoolantReturnTemperature;
+    _append(_glycol_loop_temperature);
+}
+
+void TelemetryHistory::record(const MTM1M3TS_mixingValveC &data) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    auto row = _mixing_valve.staging();
+    row[0] = data.rawValvePosition;
+    row[1] = data.valvePosition;
+    _append(_mixing_valve);
+}
+
+void TelemetryHistory::record(const MTM1M3TS_flowMeterC &data) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    auto row = _flow_meter.staging();
+    row[0] = data.signalStrength;
+    row[1] = data.flowRate;
+    row[2] = data.netTotalizer;
+    row[3] = data.positiveTotalizer;
+    row[4] = data.negativeTotalizer;
+    _append(_flow_meter);
+}
+
+void TelemetryHistory::record(const MTM1M3TS_glycolPumpC &data) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    auto row = _glycol_pump.staging();
+    row[0] = data.commandedFrequency;
+    row[1] = data.targetFrequency;
+    row[2] = data.outputFrequency;
+    row[3] = data.speedFeedback;
+    row[4] = data.outputCurrent;
+    row[5] = data.busVoltage;
+    row[6] = data.outputVoltage;
+    _append(_glycol_pump);
+}
+
+void TelemetryHistory::record(const ThermalSummary &summary) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    auto &table = _summary_table(summary.window);
+    memcpy(table.staging(), summary.values, sizeof(summary.values));
+    _append(table);
+}
+
+std::vector<ColumnStatistics> TelemetryHistory::query(float window, const std::string &pattern) {
+    std::lock_guard<std::mutex> lg(_mutex);
+
+    std::vector<ColumnStatistics> ret;
+    double since = now() - window;
+
+    for (auto table : {&_thermal_data, &_glycol_loop_temperature, &_mixing_valve, &_flow_meter, &_glycol_pump}) {
+        table->query(since, pattern, ret);
+    }
+    for (auto &s : _summaries) {
+        s.second->query(since, pattern, ret);
+    }
+
+    return ret;
+}
+
+double TelemetryHistory::now() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void TelemetryHistory::_resize(float length) {
+    SPDLOG_INFO("Telemetry history length set to {:.1f} minutes.", length);
+
+    _length = length;
+
+    auto rows = [length](float rate) { return static_cast<size_t>(std::ceil(length * 60 * rate)); };
+
+    _thermal_data.resize(rows(THERMAL_DATA_RATE));
+    _glycol_loop_temperature.resize(rows(GLYCOL_LOOP_TEMPERATURE_RATE));
+    _mixing_valve.resize(rows(MIXING_VALVE_RATE));
+    _flow_meter.resize(rows(FLOW_METER_RATE));
+    _glycol_pump.resize(rows(GLYCOL_PUMP_RATE));
+    for (auto &s : _summaries) {
+        s.second->resize(rows(1 / s.first));
+    }
+}
+
+HistoryTable &TelemetryHistory::_summary_table(float window) {
+    for (auto &s : _summaries) {
+        if (s.first == window) {
+            return *s.second;
+        }
+    }
+
+    auto table = std::make_unique<HistoryTable>(fmt::format("thermalDataSummary{:g}s", window).c_str());
+    // the same order as in ThermalSummary::values
+    for (auto quantity : ThermalSummary::quantity_names) {
+        for (auto statistic : ThermalSummary::statistic_names) {
+            for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+                table->add_column(fmt::format("{}.{}[{}]", quantity, statistic, i));
+            }
+        }
+    }
+    table->resize(std::ceil(_length * 60 / window));
+
+    _summaries.emplace_back(window, std::move(table));
+    return *_summaries.back().second;
+}
+
+void TelemetryHistory::_append(HistoryTable &table) {
+    // settings can be reloaded at any time, resize tables on change
+    float length = Settings::TelemetryHistory::instance().length;
+    if (length != _length) {
+        _resize(length);
+    }
+
+    double timestamp = now();
+    table.append(timestamp);
+    Journal::instance().append(table.topic(), table.columns(), timestamp, table.staging());
+}
@@ -0,0 +1,175 @@
+/*
+ * In-memory columnar telemetry history.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_TelemetryHistory_
+#define _TS_Telemetry_TelemetryHistory_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SAL_MTM1M3TS.h>
+
+#include <cRIO/Singleton.h>
+
+#include "Telemetry/ThermalSummary.h"
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Statistics of a single column over a time window.
+ */
+struct ColumnStatistics {
+    std::string name;
+    size_t count;
+    float min;
+    float max;
+    float mean;
+};
+
+/**
+ * History of a single topic. Values are stored column-wise in a ring buffer,
+ * so a window query over a column reads contiguous memory. Rows are
+ * timestamped with the time of the recording.
+ */
+class HistoryTable {
+public:
+    HistoryTable(const char *topic);
+
+    void add_column(const std::string &name);
+
+    /**
+     * Reallocates storage for the given number of rows. Clears stored rows.
+     */
+    void resize(size_t capacity);
+
+    size_t capacity() const { return _capacity; }
+
+    size_t size() const { return _size; }
+
+    const std::string &topic() const { return _topic; }
+
+    const std::vector<std::string> &columns() const { return _columns; }
+
+    /**
+     * Returns row to fill before append is called. Values shall be in the
+     * column order.
+     */
+    float *staging() { return _staging.data(); }
+
+    /**
+     * Appends staged row, overwriting the oldest row if the table is full.
+     *
+     * @param timestamp row timestamp (seconds)
+     */
+    void append(double timestamp);
+
+    /**
+     * Calculates statistics of matching columns. A column matches if the
+     * pattern is its full name (topic.column[index]), the topic name, or
+     * the full name without an index.
+     *
+     * @param since rows with timestamp older than this are ignored
+     * @param pattern column pattern
+     * @param result statistics of matching columns are appended here
+     */
+    void query(double since, const std::string &pattern, std::vector<ColumnStatistics> &result) const;
+
+private:
+    bool _matches(const std::string &column, const std::string &pattern) const;
+
+    std::string _topic;
+    std::vector<std::string> _columns;
+    std::vector<float> _staging;
+
+    size_t _capacity;
+    size_t _size;
+    size_t _head;
+
+    std::vector<double> _timestamps;
+    std::vector<float> _values;
+};
+
+/**
+ * Memory bounded history of thermalData, glycolLoopTemperature, mixingValve,
+ * flowMeter and glycolPump telemetry, and of thermal summaries. Samples are recorded from the publish
+ * queue thread, history length is configured in Settings::TelemetryHistory.
+ * Recorded rows are also appended to the on-disk Journal.
+ */
+class TelemetryHistory final : public cRIO::Singleton<TelemetryHistory> {
+public:
+    TelemetryHistory(token);
+
+    /**
+     * Topics without history are ignored.
+     */
+    template <typename T>
+    void record(const T &) {}
+
+    void record(const MTM1M3TS_thermalDataC &data);
+    void record(const MTM1M3TS_glycolLoopTemperatureC &data);
+    void record(const MTM1M3TS_mixingValveC &data);
+    void record(const MTM1M3TS_flowMeterC &data);
+    void record(const MTM1M3TS_glycolPumpC &data);
+    void record(const ThermalSummary &summary);
+
+    /**
+     * Returns min/max/mean of matching columns.
+     *
+     * @param window window length, in seconds, ending now
+     * @param pattern column pattern, see HistoryTable::query
+     */
+    std::vector<ColumnStatistics> query(float window, const std::string &pattern);
+
+    /**
+     * Returns current time used to timestamp rows - seconds since UNIX epoch.
+     */
+    static double now();
+
+private:
+    void _resize(float length);
+    HistoryTable &_summary_table(float window);
+    void _append(HistoryTable &table);
+
+    std::mutex _mutex;
+    float _length;
+
+    HistoryTable _thermal_data;
+    HistoryTable _glycol_loop_temperature;
+    HistoryTable _mixing_valve;
+    HistoryTable _flow_meter;
+    HistoryTable _glycol_pump;
+
+    // thermalDataSummary<window>s tables
+    std::vector<std::pair<float, std::unique_ptr<HistoryTable>>> _summaries;
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_TelemetryHistory_
@@ -20,8 +20,14 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <Events/FcuTargets.h>
+#include <Settings/ThermalDataPublish.h>
+#include <LiveState.h>
+#include <PublishQueue.h>
 #include <TSPublisher.h>
+#include <Telemetry/FcuAnomalyDetector.h>
 #include <Telemetry/ThermalData.h>
+#include <Telemetry/ThermalStatistics.h>
 #include <cRIO/ThermalILC.h>
 #include <spdlog/spdlog.h>
 
@@ -30,7 +36,30 @@
 using namespace LSST::M1M3::TS;
 using namespace LSST::M1M3::TS::Telemetry;
 
-ThermalData::ThermalData(token) { reset(); }
+using namespace std::chrono_literals;
+
+/// approximate size of thermalData sample - timestamp, 4 bool, 2 float and int per FCU
+constexpr size_t sample_size = sizeof(double) + LSST::cRIO::NUM_TS_ILC * (4 * sizeof(bool) + 3 * 4);
+
+constexpr auto statistics_report_interval = 600s;
+
+ThermalData::ThermalData(token) {
+    reset();
+
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        _published_status[i] = 0xFF;
+        _published_differentialTemperature[i] = NAN;
+        _published_fanRPM[i] = -1;
+        _published_absoluteTemperature[i] = NAN;
+    }
+
+    _statistics.published = 0;
+    _statistics.suppressed = 0;
+    _statistics.bytes_saved = 0;
+    _statistics.changed_ilcs = 0;
+
+    _next_statistics_report = std::chrono::steady_clock::now() + statistics_report_interval;
+}
 
 void ThermalData::reset() {
     for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
@@ -54,14 +83,86 @@ void ThermalData::update(uint8_t address, uint8_t _status, float _differentialTe
     differentialTemperature[index] = _differentialTemperature;
     fanRPM[index] = (int)_fanRPM * 10.0;
     absoluteTemperature[index] = _absoluteTemperature;
+    _received[index] = std::chrono::steady_clock::now();
+
+    ThermalStatistics::instance().update(index, absoluteTemperature[index], differentialTemperature[index],
+                                         fanRPM[index]);
+
+    // heaters disabled by the FCU don't follow the target
+    auto &targets = Events::FcuTargets::instance();
+    FcuAnomalyDetector::instance().update(index, heaterDisabled[index] ? 0 : targets.get_heaterPWM()[index],
+                                          targets.get_fanRPM()[index], differentialTemperature[index],
+                                          fanRPM[index], absoluteTemperature[index]);
 }
 
 void ThermalData::send() {
-    timestamp = TSPublisher::instance().getTimestamp();
+    auto &policy = Settings::ThermalDataPublish::instance();
+    auto now = std::chrono::steady_clock::now();
+
+    ThermalStatistics::instance().tick(now);
+    FcuAnomalyDetector::instance().tick();
+    LiveState::instance().update(*this);
+
+    _statistics.changed_ilcs = 0;
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        if (_changed(i)) {
+            _statistics.changed_ilcs++;
+        }
+    }
 
-    salReturn ret = TSPublisher::SAL()->putSample_thermalData(this);
-    if (ret != SAL__OK) {
-        SPDLOG_WARN("Cannot send thermalData: {}", ret);
-        return;
+    bool silent_expired =
+            std::chrono::duration<float>(now - _last_published).count() >= policy.maxSilentInterval;
+
+    if (_statistics.changed_ilcs == 0 && silent_expired == false) {
+        _statistics.suppressed++;
+        _statistics.bytes_saved += sample_size;
+    } else {
+        SPDLOG_TRACE("Publishing thermalData, {} FCUs changed.", _statistics.changed_ilcs);
+
+        timestamp = TSPublisher::instance().getTimestamp();
+
+        PublishQueue::instance().enqueue<MTM1M3TS_thermalDataC>(*this);
+
+        for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+            _published_status[i] = _status(i);
+            _published_differentialTemperature[i] = differentialTemperature[i];
+            _published_fanRPM[i] = fanRPM[i];
+            _published_absoluteTemperature[i] = absoluteTemperature[i];
+        }
+        _last_published = now;
+        _statistics.published++;
     }
+
+    if (now >= _next_statistics_report) {
+        SPDLOG_INFO("thermalData published {}, suppressed {} samples, saved {} kB.", _statistics.published,
+                    _statistics.suppressed, _statistics.bytes_saved / 1024);
+        _next_statistics_report = now + statistics_report_interval;
+    }
+}
+
+uint8_t ThermalData::_status(int index) {
+    return (ilcFault[index] ? 0x01 : 0) | (heaterDisabled[index] ? 0x02 : 0) |
+           (heaterBreaker[index] ? 0x04 : 0) | (fanBreaker[index] ? 0x08 : 0);
+}
+
+/**
+ * Returns true if values differ by more than deadband. Change from or to NaN
+ * is always a change.
+ */
+static bool out_of_deadband(float published, float current, float deadband) {
+    if (std::isnan(published) || std::isnan(current)) {
+        return std::isnan(published) != std::isnan(current);
+    }
+    return fabs(current - published) > deadband;
+}
+
+bool ThermalData::_changed(int index) {
+    auto &policy = Settings::ThermalDataPublish::instance();
+
+    return _status(index) != _published_status[index] ||
+           out_of_deadband(_published_differentialTemperature[index], differentialTemperature[index],
+                           policy.differentialTemperatureDeadband) ||
+           abs(fanRPM[index] - _published_fanRPM[index]) > policy.fanRPMDeadband ||
+           out_of_deadband(_published_absoluteTemperature[index], absoluteTemperature[index],
+                           policy.absoluteTemperatureDeadband);
 }
@@ -23,20 +23,39 @@
 #ifndef _TS_Telemetry_ThermalData_
 #define _TS_Telemetry_ThermalData_
 
+#include <chrono>
+
 #include <SAL_MTM1M3TS.h>
 #include <cRIO/Singleton.h>
+#include <cRIO/ThermalILC.h>
 
 namespace LSST {
 namespace M1M3 {
 namespace TS {
 namespace Telemetry {
 
+/**
+ * FCU thermal data telemetry. Published according to the
+ * Settings::ThermalDataPublish policy - only if values changed more than
+ * deadbands, or the maximal silent interval expired.
+ */
 class ThermalData final : MTM1M3TS_thermalDataC, public cRIO::Singleton<ThermalData> {
 public:
     ThermalData(token);
 
     /**
-     * Resets stored values to NAN/0.
+     * Publishing statistics.
+     */
+    struct PublishStatistics {
+        uint64_t published;
+        uint64_t suppressed;
+        uint64_t bytes_saved;
+        // number of FCUs which changed in the last cycle
+        int changed_ilcs;
+    };
+
+    /**
+     * Resets stored values to NAN/0. Reception timestamps are kept.
      */
     void reset();
 
@@ -44,13 +63,44 @@ public:
                 float absoluteTemperature);
 
     /**
-     * Sends updates through SAL/DDS.
+     * Sends updates through SAL/DDS, if any value changed more than its
+     * deadband or maximal silent interval expired.
      */
     void send();
 
+    /**
+     * Returns publishing statistics.
+     */
+    PublishStatistics get_publish_statistics() const { return _statistics; }
+
     bool is_heater_disabled(int index) { return heaterDisabled[index]; }
 
-    auto get_absoluteTemperature() { return absoluteTemperature; }
+    const auto &get_absoluteTemperature() const { return absoluteTemperature; }
+
+    /**
+     * Returns time the FCU data were last received. Default (epoch) time
+     * point if no data were received.
+     *
+     * @param index FCU index (0 based)
+     */
+    std::chrono::steady_clock::time_point get_received(int index) { return _received[index]; }
+
+private:
+    std::chrono::steady_clock::time_point _received[cRIO::NUM_TS_ILC];
+
+    // last published values
+    uint8_t _published_status[cRIO::NUM_TS_ILC];
+    float _published_differentialTemperature[cRIO::NUM_TS_ILC];
+    int _published_fanRPM[cRIO::NUM_TS_ILC];
+    float _published_absoluteTemperature[cRIO::NUM_TS_ILC];
+
+    std::chrono::steady_clock::time_point _last_published;
+    std::chrono::steady_clock::time_point _next_statistics_report;
+
+    PublishStatistics _statistics;
+
+    uint8_t _status(int index);
+    bool _changed(int index);
 };
 
 }  // namespace Telemetry
@@ -0,0 +1,109 @@
+/*
+ * Windowed per-FCU thermal statistics.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <fmt/ranges.h>
+#include <spdlog/spdlog.h>
+
+#include "PublishQueue.h"
+#include "Telemetry/TelemetryHistory.h"
+#include "Telemetry/ThermalStatistics.h"
+
+using namespace LSST::M1M3::TS::Telemetry;
+
+const char *ThermalSummary::quantity_names[QUANTITIES] = {"absoluteTemperature", "differentialTemperature",
+                                                          "fanRPM"};
+const char *ThermalSummary::statistic_names[STATISTICS] = {"min", "max", "mean", "stddev"};
+
+ThermalStatistics::ThermalStatistics(token) { _window_count = 0; }
+
+void ThermalStatistics::update(int index, float absoluteTemperature, float differentialTemperature,
+                               float fanRPM) {
+    for (size_t w = 0; w < _window_count; w++) {
+        auto &acc = _windows[w].accumulators;
+        acc[ThermalSummary::ABSOLUTE_TEMPERATURE][index].add(absoluteTemperature);
+        acc[ThermalSummary::DIFFERENTIAL_TEMPERATURE][index].add(differentialTemperature);
+        acc[ThermalSummary::FAN_RPM][index].add(fanRPM);
+    }
+}
+
+int ThermalStatistics::tick(std::chrono::steady_clock::time_point now) {
+    if (_configured != Settings::ThermalStatistics::instance().windows) {
+        _configure(now);
+        return 0;
+    }
+
+    int closed = 0;
+
+    for (size_t w = 0; w < _window_count; w++) {
+        auto &window = _windows[w];
+        if (now < window.end) {
+            continue;
+        }
+
+        auto &summary = window.summary;
+        summary.window = window.length;
+        summary.start = window.start;
+        for (int q = 0; q < ThermalSummary::QUANTITIES; q++) {
+            for (int i = 0; i < cRIO::NUM_TS_ILC; i++) {
+                auto &acc = window.accumulators[q][i];
+                summary.values[q][ThermalSummary::MIN][i] = acc.min;
+                summary.values[q][ThermalSummary::MAX][i] = acc.max;
+                summary.values[q][ThermalSummary::MEAN][i] = acc.count > 0 ? acc.mean : NAN;
+                summary.values[q][ThermalSummary::STDDEV][i] = acc.stddev();
+            }
+        }
+
+        PublishQueue::instance().enqueue(summary);
+        closed++;
+
+        // keep windows aligned, unless ticks were missed
+        _start(window, window.end);
+        if (window.end <= now) {
+            _start(window, now);
+        }
+    }
+
+    return closed;
+}
+
+void ThermalStatistics::_configure(std::chrono::steady_clock::time_point now) {
+    _configured = Settings::ThermalStatistics::instance().windows;
+    _window_count = std::min(_configured.size(), Settings::ThermalStatistics::MAX_WINDOWS);
+
+    for (size_t w = 0; w < _window_count; w++) {
+        _windows[w].length = _configured[w];
+        _start(_windows[w], now);
+    }
+
+    SPDLOG_INFO("Thermal statistics windows: {} seconds.", fmt::join(_configured, ", "));
+}
+
+void ThermalStatistics::_start(Window &window, std::chrono::steady_clock::time_point begin) {
+    window.start = TelemetryHistory::now();
+    window.end = begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<float>(window.length));
+    for (auto &q : window.accumulators) {
+        for (auto &acc : q) {
+            acc.reset();
+        }
+    }
+}
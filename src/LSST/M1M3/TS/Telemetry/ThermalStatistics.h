@@ -0,0 +1,95 @@
+/*
+ * Windowed per-FCU thermal statistics.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_ThermalStatistics_
+#define _TS_Telemetry_ThermalStatistics_
+
+#include <chrono>
+#include <vector>
+
+#include <cRIO/Singleton.h>
+#include <cRIO/ThermalILC.h>
+
+#include "Settings/ThermalStatistics.h"
+#include "Telemetry/ThermalSummary.h"
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Accumulates absoluteTemperature, differentialTemperature and fanRPM of
+ * every FCU over tumbling windows configured in Settings::ThermalStatistics.
+ * Summaries of completed windows are queued for publishing. Updated from the
+ * controller thread, O(1) per sample.
+ */
+class ThermalStatistics final : public cRIO::Singleton<ThermalStatistics> {
+public:
+    ThermalStatistics(token);
+
+    /**
+     * Adds FCU sample.
+     *
+     * @param index FCU index (0 based)
+     */
+    void update(int index, float absoluteTemperature, float differentialTemperature, float fanRPM);
+
+    /**
+     * Closes windows which ended and queues their summaries.
+     *
+     * @param now current time
+     *
+     * @return number of closed windows
+     */
+    int tick(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * Returns the last completed summary of a window.
+     *
+     * @param window window index (in Settings::ThermalStatistics::windows)
+     */
+    const ThermalSummary &last(size_t window) const { return _windows[window].summary; }
+
+private:
+    struct Window {
+        float length;
+        std::chrono::steady_clock::time_point end;
+        double start;
+        Welford accumulators[ThermalSummary::QUANTITIES][cRIO::NUM_TS_ILC];
+        ThermalSummary summary;
+    };
+
+    void _configure(std::chrono::steady_clock::time_point now);
+    void _start(Window &window, std::chrono::steady_clock::time_point begin);
+
+    std::vector<float> _configured;
+    Window _windows[Settings::ThermalStatistics::MAX_WINDOWS];
+    size_t _window_count;
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_ThermalStatistics_
@@ -0,0 +1,102 @@
+/*
+ * Summary of FCU telemetry over a time window.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_Telemetry_ThermalSummary_
+#define _TS_Telemetry_ThermalSummary_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <cRIO/ThermalILC.h>
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+namespace Telemetry {
+
+/**
+ * Running mean and variance using Welford's online algorithm, plus min and
+ * max. NaN samples are ignored.
+ */
+struct Welford {
+    void reset() {
+        count = 0;
+        mean = 0;
+        m2 = 0;
+        min = NAN;
+        max = NAN;
+    }
+
+    void add(float value) {
+        if (std::isnan(value)) {
+            return;
+        }
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+        if (count == 1) {
+            min = max = value;
+        } else {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+    }
+
+    /**
+     * Returns sample standard deviation, NaN if less than 2 samples were
+     * added.
+     */
+    float stddev() const { return count > 1 ? std::sqrt(m2 / (count - 1)) : NAN; }
+
+    uint32_t count;
+    double mean;
+    double m2;
+    float min;
+    float max;
+};
+
+/**
+ * Summary of FCU telemetry over a window. Published as a local
+ * thermalDataSummary<window>s topic.
+ */
+struct ThermalSummary {
+    enum Quantity { ABSOLUTE_TEMPERATURE, DIFFERENTIAL_TEMPERATURE, FAN_RPM, QUANTITIES };
+    enum Statistic { MIN, MAX, MEAN, STDDEV, STATISTICS };
+
+    static const char *quantity_names[QUANTITIES];
+    static const char *statistic_names[STATISTICS];
+
+    // window length, in seconds
+    float window;
+    // window start, seconds since UNIX epoch
+    double start;
+    float values[QUANTITIES][STATISTICS][cRIO::NUM_TS_ILC];
+};
+
+}  // namespace Telemetry
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+#endif  // !_TS_Telemetry_ThermalSummary_
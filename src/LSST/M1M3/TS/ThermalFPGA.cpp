@@ -20,6 +20,10 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <thread>
 
@@ -27,6 +31,7 @@
 
 #include <cRIO/NiError.h>
 
+#include "LatencyProbe.h"
 #include "NiFpga_ts_M1M3ThermalFPGA.h"
 #include "ThermalFPGA.h"
 #include "TSPublisher.h"
@@ -39,6 +44,7 @@ using namespace std::chrono_literals;
 ThermalFPGA::ThermalFPGA() : IFPGA() {
     SPDLOG_DEBUG("ThermalFPGA: ThermalFPGA()");
     _session = 0;
+    _reused = false;
 }
 
 ThermalFPGA::~ThermalFPGA() {}
@@ -47,27 +53,103 @@ void ThermalFPGA::initialize() {
     NiThrowError(__PRETTY_FUNCTION__, NiFpga_Initialize());
 }
 
+/**
+ * Reads and discards all elements waiting in a target to host FIFO.
+ *
+ * @return number of discarded elements
+ */
+template <typename T>
+static size_t drain_FIFO(NiFpga_Status (*read)(NiFpga_Session, uint32_t, T *, size_t, uint32_t, size_t *),
+                         NiFpga_Session session, uint32_t fifo) {
+    T buffer[256];
+    size_t remaining = 0;
+    size_t drained = 0;
+    NiThrowError(__PRETTY_FUNCTION__, "NiFpga_ReadFifo", read(session, fifo, buffer, 0, 0, &remaining));
+    while (remaining > 0) {
+        size_t len = std::min(remaining, sizeof(buffer) / sizeof(T));
+        NiThrowError(__PRETTY_FUNCTION__, "NiFpga_ReadFifo", read(session, fifo, buffer, len, 0, &remaining));
+        drained += len;
+    }
+    return drained;
+}
+
 void ThermalFPGA::open() {
     SPDLOG_DEBUG("ThermalFPGA: open()");
+    auto started = std::chrono::steady_clock::now();
+    // NiFpga_Open downloads the bitfile if the running bitfile signature doesn't match
     NiOpen("/var/lib/M1M3TS", NiFpga_ts_M1M3ThermalFPGA, "RIO0", NiFpga_OpenAttribute_NoRun, &(_session));
     uint32_t ni_state;
     NiThrowError(__PRETTY_FUNCTION__, "NiFpga_GetFpgaViState", NiFpga_GetFpgaViState(_session, &ni_state));
     SPDLOG_INFO("FPGA state when starting CSC: {}.", ni_state);
+
+    // escape hatch for a running bitfile in a bad state
+    const char *force_reset = getenv("M1M3TS_FPGA_RESET");
+    if (ni_state == NiFpga_FpgaViState_Running && force_reset != nullptr && strcmp(force_reset, "1") == 0) {
+        SPDLOG_WARN("M1M3TS_FPGA_RESET set, resetting running FPGA bitfile.");
+        ni_state = NiFpga_FpgaViState_NotRunning;
+    }
+
+    _reused = false;
     switch (ni_state) {
         case NiFpga_FpgaViState_Invalid:
             NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Download", NiFpga_Download(_session));
         case NiFpga_FpgaViState_NaturallyStopped:
         case NiFpga_FpgaViState_NotRunning:
-        case NiFpga_FpgaViState_Running:
-            NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Abort", NiFpga_Abort(_session));
-            NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Reset", NiFpga_Reset(_session));
-            NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Run", NiFpga_Run(_session, 0));
+            _reset();
             break;
+        case NiFpga_FpgaViState_Running: {
+            // matching bitfile is already running - reuse it, only discard
+            // responses left in FIFOs by the previous CSC instance
+            size_t drained = drain_FIFO(NiFpga_ReadFifoU8, _session,
+                                        NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU8_U8ResponseFIFO);
+            drained += drain_FIFO(NiFpga_ReadFifoU16, _session,
+                                  NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU16_U16ResponseFIFO);
+            drained += drain_FIFO(NiFpga_ReadFifoSgl, _session,
+                                  NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoSgl_SGLResponseFIFO);
+            for (auto fifo : {NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU8_CoolantTempRead,
+                              NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU8_FlowMeter1Read,
+                              NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU8_FlowMeter2Read,
+                              NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU8_GlycoolRead}) {
+                drained += drain_FIFO(NiFpga_ReadFifoU8, _session, fifo);
+            }
+            SPDLOG_INFO("Reusing running FPGA bitfile {}, discarded {} stale FIFO elements.",
+                        NiFpga_ts_M1M3ThermalFPGA_Signature, drained);
+            _reused = true;
+            break;
+        }
         default:
             throw std::runtime_error(fmt::format("Unknow FPGA state: {}", ni_state));
     }
     setMixingValvePosition(0);
     setCoolantPumpPower(false);
+    SPDLOG_INFO("FPGA opened in {:.2f} s.",
+                std::chrono::duration<float>(std::chrono::steady_clock::now() - started).count());
+}
+
+bool ThermalFPGA::verify_reused(std::function<void(void)> transaction) {
+    if (_reused == false) {
+        return false;
+    }
+    _reused = false;
+
+    try {
+        transaction();
+        return false;
+    } catch (std::exception &ex) {
+        SPDLOG_WARN("First bus transaction through reused FPGA bitfile failed: {}. Resetting FPGA.",
+                    ex.what());
+    }
+
+    _reset();
+    setMixingValvePosition(0);
+    setCoolantPumpPower(false);
+    return true;
+}
+
+void ThermalFPGA::_reset() {
+    NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Abort", NiFpga_Abort(_session));
+    NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Reset", NiFpga_Reset(_session));
+    NiThrowError(__PRETTY_FUNCTION__, "NiFpga_Run", NiFpga_Run(_session, 0));
 }
 
 void ThermalFPGA::close() {
@@ -87,6 +169,7 @@ void ThermalFPGA::writeCommandFIFO(uint16_t *data, size_t length, uint32_t timeo
     NiThrowError(__PRETTY_FUNCTION__,
                  NiFpga_WriteFifoU16(_session, NiFpga_ts_M1M3ThermalFPGA_HostToTargetFifoU16_CommandFIFO,
                                      data, length, timeout, NULL));
+    LatencyProbe::instance().mark(LatencyProbe::FIFO_WRITE);
 
     writeDebugFile<uint16_t>("CMD<", data, length);
 }
@@ -103,6 +186,7 @@ void ThermalFPGA::readSGLResponseFIFO(float *data, size_t length, uint32_t timeo
     NiThrowError(__PRETTY_FUNCTION__,
                  NiFpga_ReadFifoSgl(_session, NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoSgl_SGLResponseFIFO,
                                     data, length, timeout, NULL));
+    LatencyProbe::instance().mark(LatencyProbe::RESPONSE);
 }
 
 void ThermalFPGA::readU8ResponseFIFO(uint8_t *data, size_t length, uint32_t timeout) {
@@ -117,6 +201,7 @@ void ThermalFPGA::readU16ResponseFIFO(uint16_t *data, size_t length, uint32_t ti
     NiThrowError(__PRETTY_FUNCTION__,
                  NiFpga_ReadFifoU16(_session, NiFpga_ts_M1M3ThermalFPGA_TargetToHostFifoU16_U16ResponseFIFO,
                                     data, length, timeout, NULL));
+    LatencyProbe::instance().mark(LatencyProbe::RESPONSE);
 
     writeDebugFile<uint16_t>("U16>", data, length);
 }
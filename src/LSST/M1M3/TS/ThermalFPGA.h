@@ -52,11 +52,18 @@ public:
     void waitOnIrqs(uint32_t irqs, uint32_t timeout, bool &timedout, uint32_t *triggered = NULL) override;
     void ackIrqs(uint32_t irqs) override;
 
+    bool verify_reused(std::function<void(void)> transaction) override;
+
     uint32_t getSession() { return _session; }
 
 private:
     uint32_t _session;
 
+    // running bitfile was reused on open and no bus transaction verified it yet
+    bool _reused;
+
+    void _reset();
+
     std::map<size_t, NiFpga_IrqContext> _contexes;
 };
 
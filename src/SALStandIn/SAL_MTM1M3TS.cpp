@@ -0,0 +1,94 @@
+/*
+ * In-process stand-in for the MTM1M3TS SAL library.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <time.h>
+
+#include <spdlog/spdlog.h>
+
+#include "SAL_MTM1M3TS.h"
+
+double SALStandIn::now() {
+    struct timespec tp;
+    clock_gettime(CLOCK_TAI, &tp);
+    return tp.tv_sec + tp.tv_nsec / 1e9;
+}
+
+#define SAL_STANDIN_TELEMETRY_INIT(topic) _##topic(#topic),
+#define SAL_STANDIN_EVENT_INIT(topic) _logevent_##topic("logevent_" #topic),
+#define SAL_STANDIN_COMMAND_INIT(topic) _command_##topic("command_" #topic),
+
+SAL_MTM1M3TS::SAL_MTM1M3TS(int index)
+        : SAL_STANDIN_TELEMETRY(SAL_STANDIN_TELEMETRY_INIT) SAL_STANDIN_EVENTS(SAL_STANDIN_EVENT_INIT)
+                  SAL_STANDIN_COMMANDS(SAL_STANDIN_COMMAND_INIT) _debug_level(0) {
+    SPDLOG_WARN("Using in-process SAL stand-in, MTM1M3TS topics are not published");
+}
+
+void SAL_MTM1M3TS::setCaptureDepth(size_t depth) {
+#define SAL_STANDIN_TELEMETRY_DEPTH(topic) _##topic.setDepth(depth);
+#define SAL_STANDIN_EVENT_DEPTH(topic) _logevent_##topic.setDepth(depth);
+
+    SAL_STANDIN_TELEMETRY(SAL_STANDIN_TELEMETRY_DEPTH)
+    SAL_STANDIN_EVENTS(SAL_STANDIN_EVENT_DEPTH)
+}
+
+std::vector<SALStandIn::TopicStatistics> SAL_MTM1M3TS::statistics() {
+    std::vector<SALStandIn::TopicStatistics> ret;
+
+    auto add_topic = [&ret](const char *name, uint64_t published) {
+        if (published > 0) {
+            ret.push_back(SALStandIn::TopicStatistics{name, published, 0, 0, 0});
+        }
+    };
+
+    auto add_command = [&ret](const char *name, uint64_t issued, uint64_t accepted, uint64_t acked) {
+        if (issued > 0) {
+            ret.push_back(SALStandIn::TopicStatistics{name, 0, issued, accepted, acked});
+        }
+    };
+
+#define SAL_STANDIN_TELEMETRY_STATISTICS(topic) add_topic(_##topic.name(), _##topic.count());
+#define SAL_STANDIN_EVENT_STATISTICS(topic) add_topic(_logevent_##topic.name(), _logevent_##topic.count());
+#define SAL_STANDIN_COMMAND_STATISTICS(topic)                                                    \
+    add_command(_command_##topic.name(), _command_##topic.issued(), _command_##topic.accepted(), \
+                _command_##topic.acked());
+
+    SAL_STANDIN_TELEMETRY(SAL_STANDIN_TELEMETRY_STATISTICS)
+    SAL_STANDIN_EVENTS(SAL_STANDIN_EVENT_STATISTICS)
+    SAL_STANDIN_COMMANDS(SAL_STANDIN_COMMAND_STATISTICS)
+
+    return ret;
+}
+
+void SAL_MTM1M3TS::salShutdown() {
+    for (auto &s : statistics()) {
+        if (s.issued > 0) {
+            SPDLOG_DEBUG("SAL stand-in {}: issued {} accepted {} acknowledged {}", s.name, s.issued,
+                         s.accepted, s.acked);
+        } else {
+            SPDLOG_DEBUG("SAL stand-in {}: {} samples", s.name, s.published);
+        }
+    }
+}
+
+std::string SAL_MTM1M3TS::getSALVersion() { return "standin"; }
+
+std::string SAL_MTM1M3TS::getXMLVersion() { return "standin"; }
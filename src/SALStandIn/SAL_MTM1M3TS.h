@@ -0,0 +1,797 @@
+/*
+ * In-process stand-in for the MTM1M3TS SAL library.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TS_SAL_STANDIN_MTM1M3TS_H_
+#define _TS_SAL_STANDIN_MTM1M3TS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <math.h>
+
+/**
+ * @file
+ *
+ * Replaces the generated SAL_MTM1M3TS.h when the CSC is built with
+ * SAL_STANDIN=1. Provides the SAL surface used by the CSC - putSample_*,
+ * logEvent_*, acceptCommand_* and ackCommand_* - backed by in-memory queues,
+ * so the daemon, integration tests and benchmarks run without SAL, Kafka or
+ * any other external service. Topic structures mirror ts_xml only for fields
+ * the CSC uses.
+ *
+ * Published samples are counted and the latest samples are captured for
+ * inspection. Commands are injected with issueCommand_*, the CSC accepts them
+ * with acceptCommand_* and its acknowledgements are available through
+ * waitForCompletion_* - mirroring SAL controller and remote sides.
+ */
+
+typedef int salReturn;
+typedef int32_t salLONG;
+
+#define SAL__OK 0
+#define SAL__ERR -1
+#define SAL__NO_UPDATES -100
+
+#define SAL__CMD_ACK 300
+#define SAL__CMD_INPROGRESS 301
+#define SAL__CMD_STALLED 302
+#define SAL__CMD_COMPLETE 303
+#define SAL__CMD_NOPERM -300
+#define SAL__CMD_NOACK -301
+#define SAL__CMD_FAILED -302
+#define SAL__CMD_ABORTED -303
+#define SAL__CMD_TIMEOUT -304
+
+namespace MTM1M3TS {
+
+enum {
+    MTM1M3TS_shared_SummaryStates_DisabledState = 1,
+    MTM1M3TS_shared_SummaryStates_EnabledState = 2,
+    MTM1M3TS_shared_SummaryStates_FaultState = 3,
+    MTM1M3TS_shared_SummaryStates_OfflineState = 4,
+    MTM1M3TS_shared_SummaryStates_StandbyState = 5
+};
+
+enum {
+    MTM1M3TS_shared_AirNozzle_SuperShort = 1,
+    MTM1M3TS_shared_AirNozzle_Blocked = 2,
+    MTM1M3TS_shared_AirNozzle_Offset = 3,
+    MTM1M3TS_shared_AirNozzle_Installed = 4,
+    MTM1M3TS_shared_AirNozzle_Covered = 5
+};
+
+}  // namespace MTM1M3TS
+
+/**
+ * Fields filled by the stand-in when a sample is captured.
+ */
+#define SAL_STANDIN_PRIVATE    \
+    double private_sndStamp;   \
+    int64_t private_seqNum;    \
+    std::string private_origin;
+
+#define SAL_STANDIN_ARRAY(type, name, size) std::vector<type> name = std::vector<type>(size)
+
+#define SAL_STANDIN_FCU_ARRAY(type, name) SAL_STANDIN_ARRAY(type, name, 96)
+
+struct MTM1M3TS_thermalDataC {
+    SAL_STANDIN_PRIVATE
+    double timestamp;
+    SAL_STANDIN_FCU_ARRAY(bool, ilcFault);
+    SAL_STANDIN_FCU_ARRAY(bool, heaterDisabled);
+    SAL_STANDIN_FCU_ARRAY(bool, heaterBreaker);
+    SAL_STANDIN_FCU_ARRAY(bool, fanBreaker);
+    SAL_STANDIN_FCU_ARRAY(float, differentialTemperature);
+    SAL_STANDIN_FCU_ARRAY(int, fanRPM);
+    SAL_STANDIN_FCU_ARRAY(float, absoluteTemperature);
+};
+
+struct MTM1M3TS_glycolLoopTemperatureC {
+    SAL_STANDIN_PRIVATE
+    double timestamp;
+    float aboveMirrorTemperature;
+    float insideCellTemperature1;
+    float insideCellTemperature2;
+    float insideCellTemperature3;
+    float telescopeCoolantSupplyTemperature;
+    float telescopeCoolantReturnTemperature;
+    float mirrorCoolantSupplyTemperature;
+    float mirrorCoolantReturnTemperature;
+};
+
+struct MTM1M3TS_mixingValveC {
+    SAL_STANDIN_PRIVATE
+    double timestamp;
+    float rawValvePosition;
+    float valvePosition;
+};
+
+struct MTM1M3TS_flowMeterC {
+    SAL_STANDIN_PRIVATE
+    double timestamp;
+    float signalStrength;
+    float flowRate;
+    float netTotalizer;
+    float positiveTotalizer;
+    float negativeTotalizer;
+};
+
+struct MTM1M3TS_glycolPumpC {
+    SAL_STANDIN_PRIVATE
+    double timestamp;
+    float commandedFrequency;
+    float targetFrequency;
+    float outputFrequency;
+    float speedFeedback;
+    float outputCurrent;
+    float busVoltage;
+    float outputVoltage;
+};
+
+struct MTM1M3TS_logevent_airNozzlesC {
+    SAL_STANDIN_PRIVATE
+    SAL_STANDIN_ARRAY(int, nozzlesA, 275);
+    SAL_STANDIN_ARRAY(int, nozzlesB, 275);
+    SAL_STANDIN_ARRAY(int, nozzlesC, 275);
+    SAL_STANDIN_ARRAY(int, nozzlesD, 275);
+    SAL_STANDIN_ARRAY(int, nozzlesE, 275);
+    SAL_STANDIN_ARRAY(int, nozzlesF, 275);
+    SAL_STANDIN_ARRAY(float, orificesDiameterA, 275);
+    SAL_STANDIN_ARRAY(float, orificesDiameterB, 275);
+    SAL_STANDIN_ARRAY(float, orificesDiameterC, 275);
+    SAL_STANDIN_ARRAY(float, orificesDiameterD, 275);
+    SAL_STANDIN_ARRAY(float, orificesDiameterE, 275);
+    SAL_STANDIN_ARRAY(float, orificesDiameterF, 275);
+};
+
+struct MTM1M3TS_logevent_appliedSetpointsC {
+    SAL_STANDIN_PRIVATE
+    float glycolSetpoint;
+    float heatersSetpoint;
+};
+
+struct MTM1M3TS_logevent_driveStatus2C {
+    SAL_STANDIN_PRIVATE
+    bool jogging;
+    bool fluxBreaking;
+    bool motorOverload;
+    bool autoRestartCountdown;
+    bool dcBraking;
+    bool atFrequency;
+    bool autoTuning;
+    bool emBraking;
+    bool currentLimit;
+    bool safetyS1;
+    bool safetyS2;
+    bool f111Status;
+    bool safeTqPermit;
+};
+
+struct MTM1M3TS_logevent_enabledILCC {
+    SAL_STANDIN_PRIVATE
+    SAL_STANDIN_FCU_ARRAY(bool, enabled);
+};
+
+struct MTM1M3TS_logevent_engineeringModeC {
+    SAL_STANDIN_PRIVATE
+    bool engineeringMode;
+};
+
+struct MTM1M3TS_logevent_errorCodeC {
+    SAL_STANDIN_PRIVATE
+    int errorCode;
+    std::string errorReport;
+    std::string traceback;
+};
+
+struct MTM1M3TS_logevent_fcuTargetsC {
+    SAL_STANDIN_PRIVATE
+    SAL_STANDIN_FCU_ARRAY(float, heaterPWM);
+    SAL_STANDIN_FCU_ARRAY(int, fanRPM);
+};
+
+struct MTM1M3TS_logevent_glycolPumpStatusC {
+    SAL_STANDIN_PRIVATE
+    bool ready;
+    bool running;
+    bool forwardCommanded;
+    bool forwardRotating;
+    bool accelerating;
+    bool decelerating;
+    bool faulted;
+    bool mainFrequencyControlled;
+    bool operationCommandControlled;
+    bool parametersLocked;
+    int errorCode;
+};
+
+struct MTM1M3TS_logevent_heartbeatC {
+    SAL_STANDIN_PRIVATE
+    bool heartbeat;
+};
+
+struct MTM1M3TS_logevent_logLevelC {
+    SAL_STANDIN_PRIVATE
+    int level;
+    std::string subsystem;
+};
+
+struct MTM1M3TS_logevent_logMessageC {
+    SAL_STANDIN_PRIVATE
+    std::string name;
+    int level;
+    std::string message;
+    std::string traceback;
+    std::string filePath;
+    std::string functionName;
+    int lineNumber;
+    int process;
+    double timestamp;
+};
+
+struct MTM1M3TS_logevent_mixingValveSettingsC {
+    SAL_STANDIN_PRIVATE
+    float commandingFullyClosed;
+    float commandingFullyOpened;
+    float positionFeedbackFullyClosed;
+    float positionFeedbackFullyOpened;
+    float positionFeedbackA;
+    float positionFeedbackB;
+    float inPosition;
+    float backlashStep;
+    float minimalMove;
+    float maxMovingTime;
+    float clearPIDGlycol;
+    float clearPIDHeaters;
+};
+
+struct MTM1M3TS_logevent_simulationModeC {
+    SAL_STANDIN_PRIVATE
+    int mode;
+};
+
+struct MTM1M3TS_logevent_softwareVersionsC {
+    SAL_STANDIN_PRIVATE
+    std::string salVersion;
+    std::string xmlVersion;
+    std::string openSpliceVersion;
+    std::string cscVersion;
+    std::string subsystemVersions;
+};
+
+struct MTM1M3TS_logevent_summaryStateC {
+    SAL_STANDIN_PRIVATE
+    int summaryState;
+};
+
+struct MTM1M3TS_logevent_thermalInfoC {
+    SAL_STANDIN_PRIVATE
+    SAL_STANDIN_FCU_ARRAY(int, referenceId);
+    SAL_STANDIN_FCU_ARRAY(int, modbusAddress);
+    SAL_STANDIN_FCU_ARRAY(double, xPosition);
+    SAL_STANDIN_FCU_ARRAY(double, yPosition);
+    SAL_STANDIN_FCU_ARRAY(long long, ilcUniqueId);
+    SAL_STANDIN_FCU_ARRAY(int, ilcApplicationType);
+    SAL_STANDIN_FCU_ARRAY(int, networkNodeType);
+    SAL_STANDIN_FCU_ARRAY(int, majorRevision);
+    SAL_STANDIN_FCU_ARRAY(int, minorRevision);
+};
+
+struct MTM1M3TS_logevent_thermalSettingsC {
+    SAL_STANDIN_PRIVATE
+    SAL_STANDIN_FCU_ARRAY(bool, enabledFCU);
+};
+
+struct MTM1M3TS_logevent_thermalWarningC {
+    SAL_STANDIN_PRIVATE
+    bool anyMajorFault;
+    bool anyMinorFault;
+    bool anyFaultOverride;
+    bool anyRefResistorError;
+    bool anyRTDError;
+    bool anyBreakerHeater1Error;
+    bool anyBreakerFan2Error;
+    bool anyUniqueIdCRCError;
+    bool anyApplicationTypeMismatch;
+    bool anyApplicationCRCMismatch;
+    bool anyOneWireMissing;
+    bool anyOneWire1Mismatch;
+    bool anyOneWire2Mismatch;
+    bool anyWatchdogReset;
+    bool anyBrownOut;
+    bool anyEventTrapReset;
+    bool anySSRPowerFault;
+    bool anyAuxPowerFault;
+    SAL_STANDIN_FCU_ARRAY(bool, majorFault);
+    SAL_STANDIN_FCU_ARRAY(bool, minorFault);
+    SAL_STANDIN_FCU_ARRAY(bool, faultOverride);
+    SAL_STANDIN_FCU_ARRAY(bool, refResistorError);
+    SAL_STANDIN_FCU_ARRAY(bool, rtdError);
+    SAL_STANDIN_FCU_ARRAY(bool, breakerHeater1Error);
+    SAL_STANDIN_FCU_ARRAY(bool, breakerFan2Error);
+    SAL_STANDIN_FCU_ARRAY(bool, uniqueIdCRCError);
+    SAL_STANDIN_FCU_ARRAY(bool, applicationTypeMismatch);
+    SAL_STANDIN_FCU_ARRAY(bool, applicationCRCMismatch);
+    SAL_STANDIN_FCU_ARRAY(bool, oneWireMissing);
+    SAL_STANDIN_FCU_ARRAY(bool, oneWire1Mismatch);
+    SAL_STANDIN_FCU_ARRAY(bool, oneWire2Mismatch);
+    SAL_STANDIN_FCU_ARRAY(bool, watchdogReset);
+    SAL_STANDIN_FCU_ARRAY(bool, brownOut);
+    SAL_STANDIN_FCU_ARRAY(bool, eventTrapReset);
+    SAL_STANDIN_FCU_ARRAY(bool, ssrPowerFault);
+    SAL_STANDIN_FCU_ARRAY(bool, auxPowerFault);
+};
+
+#define SAL_STANDIN_COMMAND(command, ...) \
+    struct MTM1M3TS_command_##command##C { \
+        SAL_STANDIN_PRIVATE                \
+        __VA_ARGS__                        \
+    };
+
+SAL_STANDIN_COMMAND(start, std::string configurationOverride;)
+SAL_STANDIN_COMMAND(enable, bool value;)
+SAL_STANDIN_COMMAND(disable, bool value;)
+SAL_STANDIN_COMMAND(standby, bool value;)
+SAL_STANDIN_COMMAND(exitControl, bool value;)
+SAL_STANDIN_COMMAND(setEngineeringMode, bool enableEngineeringMode;)
+SAL_STANDIN_COMMAND(fanCoilsHeatersPower, bool power;)
+SAL_STANDIN_COMMAND(heaterFanDemand, SAL_STANDIN_FCU_ARRAY(int, heaterPWM);
+                    SAL_STANDIN_FCU_ARRAY(int, fanRPM);)
+SAL_STANDIN_COMMAND(setMixingValve, float mixingValveTarget;)
+SAL_STANDIN_COMMAND(coolantPumpPower, bool power;)
+SAL_STANDIN_COMMAND(coolantPumpStart, bool value;)
+SAL_STANDIN_COMMAND(coolantPumpStop, bool value;)
+SAL_STANDIN_COMMAND(coolantPumpFrequency, float targetFrequency;)
+SAL_STANDIN_COMMAND(coolantPumpReset, bool value;)
+SAL_STANDIN_COMMAND(applySetpoints, float glycolSetpoint; float heatersSetpoint;)
+SAL_STANDIN_COMMAND(setLogLevel, int level; std::string subsystem;)
+
+#define SAL_STANDIN_TELEMETRY(X) \
+    X(thermalData)               \
+    X(glycolLoopTemperature)     \
+    X(mixingValve)               \
+    X(flowMeter)                 \
+    X(glycolPump)
+
+#define SAL_STANDIN_EVENTS(X) \
+    X(airNozzles)             \
+    X(appliedSetpoints)       \
+    X(driveStatus2)           \
+    X(enabledILC)             \
+    X(engineeringMode)        \
+    X(errorCode)              \
+    X(fcuTargets)             \
+    X(glycolPumpStatus)       \
+    X(heartbeat)              \
+    X(logLevel)               \
+    X(logMessage)             \
+    X(mixingValveSettings)    \
+    X(simulationMode)         \
+    X(softwareVersions)       \
+    X(summaryState)           \
+    X(thermalInfo)            \
+    X(thermalSettings)        \
+    X(thermalWarning)
+
+#define SAL_STANDIN_COMMANDS(X) \
+    X(start)                    \
+    X(enable)                   \
+    X(disable)                  \
+    X(standby)                  \
+    X(exitControl)              \
+    X(setEngineeringMode)       \
+    X(fanCoilsHeatersPower)     \
+    X(heaterFanDemand)          \
+    X(setMixingValve)           \
+    X(coolantPumpPower)         \
+    X(coolantPumpStart)         \
+    X(coolantPumpStop)          \
+    X(coolantPumpFrequency)     \
+    X(coolantPumpReset)         \
+    X(applySetpoints)           \
+    X(setLogLevel)
+
+namespace SALStandIn {
+
+/**
+ * Returns current TAI time, as SAL getCurrentTime does.
+ */
+double now();
+
+/**
+ * Published topic. Counts all samples written, keeps up to depth latest
+ * samples for inspection. Thread safe.
+ */
+template <typename T>
+class Topic {
+public:
+    Topic(const char *name) : _name(name), _depth(1024), _count(0), _read(0) {}
+
+    const char *name() const { return _name; }
+
+    /**
+     * Counts and captures the sample. Oldest captured sample is discarded
+     * when capture queue holds depth samples.
+     */
+    salReturn put(const T *sample) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _count++;
+        if (_depth == 0) {
+            return SAL__OK;
+        }
+        if (_captured.size() >= _depth) {
+            _captured.pop_front();
+            if (_read > 0) {
+                _read--;
+            }
+        }
+        _captured.push_back(*sample);
+        auto &captured = _captured.back();
+        captured.private_sndStamp = now();
+        captured.private_seqNum = _count;
+        captured.private_origin = "standin";
+        return SAL__OK;
+    }
+
+    /**
+     * Retrieves next captured sample not yet read, as SAL getSample_* /
+     * getEvent_* does.
+     *
+     * @return SAL__OK when sample was copied, SAL__NO_UPDATES if no new sample is available
+     */
+    salReturn get(T *sample) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_read >= _captured.size()) {
+            return SAL__NO_UPDATES;
+        }
+        *sample = _captured[_read++];
+        return SAL__OK;
+    }
+
+    /**
+     * Copies the latest captured sample.
+     *
+     * @return false if no sample was captured
+     */
+    bool last(T &sample) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_captured.empty()) {
+            return false;
+        }
+        sample = _captured.back();
+        return true;
+    }
+
+    /**
+     * Returns copy of captured samples, oldest first.
+     */
+    std::vector<T> captured() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return std::vector<T>(_captured.begin(), _captured.end());
+    }
+
+    /**
+     * Total number of samples written.
+     */
+    uint64_t count() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+
+    /**
+     * Sets number of samples captured. 0 only counts samples.
+     */
+    void setDepth(size_t depth) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _depth = depth;
+        while (_captured.size() > _depth) {
+            _captured.pop_front();
+        }
+        _read = std::min(_read, _captured.size());
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _captured.clear();
+        _count = 0;
+        _read = 0;
+    }
+
+private:
+    const char *_name;
+    mutable std::mutex _mutex;
+    std::deque<T> _captured;
+    size_t _depth;
+    uint64_t _count;
+    size_t _read;
+};
+
+/**
+ * Command topic. Commands issued by a test or benchmark are queued until
+ * accepted by the CSC, acknowledgements are recorded per command ID.
+ */
+template <typename T>
+class CommandQueue {
+public:
+    CommandQueue(const char *name) : _name(name), _next_id(1), _issued(0), _accepted(0), _acked(0) {}
+
+    const char *name() const { return _name; }
+
+    /**
+     * Queues command.
+     *
+     * @return command ID
+     */
+    int32_t issue(const T *data) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        int32_t id = _next_id++;
+        _queue.emplace_back(id, *data);
+        _queue.back().second.private_sndStamp = now();
+        _queue.back().second.private_seqNum = id;
+        _queue.back().second.private_origin = "standin";
+        _acks[id] = Ack{SAL__CMD_NOACK, 0, ""};
+        _issued++;
+        return id;
+    }
+
+    /**
+     * Retrieves oldest queued command.
+     *
+     * @return command ID, 0 when no command is queued
+     */
+    int32_t accept(T *data) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_queue.empty()) {
+            return 0;
+        }
+        auto id = _queue.front().first;
+        *data = _queue.front().second;
+        _queue.pop_front();
+        _accepted++;
+        return id;
+    }
+
+    salReturn ack(int32_t id, salLONG ack, salLONG error, const char *result) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _acks.find(id);
+            if (it == _acks.end()) {
+                return SAL__ERR;
+            }
+            it->second = Ack{ack, error, result == nullptr ? "" : result};
+            _acked++;
+        }
+        _ack_condition.notify_all();
+        return SAL__OK;
+    }
+
+    /**
+     * Waits for final (not SAL__CMD_ACK or SAL__CMD_INPROGRESS)
+     * acknowledgement of a command.
+     *
+     * @param id command ID returned from issue
+     * @param timeout timeout in seconds
+     *
+     * @return final acknowledgement, SAL__CMD_TIMEOUT if none was received in timeout
+     */
+    salReturn waitForCompletion(int32_t id, unsigned int timeout) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto it = _acks.find(id);
+        if (it == _acks.end()) {
+            return SAL__ERR;
+        }
+        if (_ack_condition.wait_for(lock, std::chrono::seconds(timeout), [&it] {
+                return it->second.ack != SAL__CMD_NOACK && it->second.ack != SAL__CMD_ACK &&
+                       it->second.ack != SAL__CMD_INPROGRESS;
+            }) == false) {
+            return SAL__CMD_TIMEOUT;
+        }
+        return it->second.ack;
+    }
+
+    /**
+     * Returns result string of the last acknowledgement.
+     */
+    std::string result(int32_t id) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _acks.find(id);
+        return it == _acks.end() ? "" : it->second.result;
+    }
+
+    uint64_t issued() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _issued;
+    }
+
+    uint64_t accepted() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _accepted;
+    }
+
+    uint64_t acked() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _acked;
+    }
+
+private:
+    struct Ack {
+        salLONG ack;
+        salLONG error;
+        std::string result;
+    };
+
+    const char *_name;
+    mutable std::mutex _mutex;
+    std::condition_variable _ack_condition;
+    std::deque<std::pair<int32_t, T>> _queue;
+    std::map<int32_t, Ack> _acks;
+    int32_t _next_id;
+    uint64_t _issued;
+    uint64_t _accepted;
+    uint64_t _acked;
+};
+
+/**
+ * Per-topic counters, reported by SAL_MTM1M3TS::statistics().
+ */
+struct TopicStatistics {
+    std::string name;
+    uint64_t published;
+    uint64_t issued;
+    uint64_t accepted;
+    uint64_t acked;
+};
+
+}  // namespace SALStandIn
+
+/**
+ * SAL_MTM1M3TS replacement. Telemetry and events are written into
+ * SALStandIn::Topic, commands are passed through SALStandIn::CommandQueue.
+ * Besides SAL controller API, provides remote API (getSample_*, getEvent_*,
+ * issueCommand_* and waitForCompletion_*) and direct access to the topics
+ * through captured<T>() and commands<T>().
+ */
+class SAL_MTM1M3TS {
+public:
+    SAL_MTM1M3TS(int index = 0);
+
+#define SAL_STANDIN_TELEMETRY_API(topic)                                                  \
+    salReturn putSample_##topic(MTM1M3TS_##topic##C *data) { return _##topic.put(data); } \
+    salReturn getSample_##topic(MTM1M3TS_##topic##C *data) { return _##topic.get(data); }
+
+#define SAL_STANDIN_EVENT_API(topic)                                           \
+    salReturn putSample_logevent_##topic(MTM1M3TS_logevent_##topic##C *data) { \
+        return _logevent_##topic.put(data);                                    \
+    }                                                                          \
+    salReturn logEvent_##topic(MTM1M3TS_logevent_##topic##C *data, int) {      \
+        return _logevent_##topic.put(data);                                    \
+    }                                                                          \
+    salReturn getEvent_##topic(MTM1M3TS_logevent_##topic##C *data) {           \
+        return _logevent_##topic.get(data);                                    \
+    }
+
+#define SAL_STANDIN_COMMAND_API(topic)                                                        \
+    int32_t acceptCommand_##topic(MTM1M3TS_command_##topic##C *data) {                        \
+        return _command_##topic.accept(data);                                                 \
+    }                                                                                         \
+    salReturn ackCommand_##topic(int32_t cmdSeqNum, salLONG ack, salLONG error, char *result, \
+                                 double timeout = 0) {                                        \
+        return _command_##topic.ack(cmdSeqNum, ack, error, result);                           \
+    }                                                                                         \
+    int32_t issueCommand_##topic(MTM1M3TS_command_##topic##C *data) {                         \
+        return _command_##topic.issue(data);                                                  \
+    }                                                                                         \
+    salReturn waitForCompletion_##topic(int32_t cmdSeqNum, unsigned int timeout) {            \
+        return _command_##topic.waitForCompletion(cmdSeqNum, timeout);                        \
+    }
+
+    SAL_STANDIN_TELEMETRY(SAL_STANDIN_TELEMETRY_API)
+    SAL_STANDIN_EVENTS(SAL_STANDIN_EVENT_API)
+    SAL_STANDIN_COMMANDS(SAL_STANDIN_COMMAND_API)
+
+#undef SAL_STANDIN_TELEMETRY_API
+#undef SAL_STANDIN_EVENT_API
+#undef SAL_STANDIN_COMMAND_API
+
+    /**
+     * Returns telemetry or event topic holding samples of type T.
+     */
+    template <typename T>
+    SALStandIn::Topic<T> &captured() {
+        return _topic(static_cast<const T *>(nullptr));
+    }
+
+    /**
+     * Returns command queue for command type T.
+     */
+    template <typename T>
+    SALStandIn::CommandQueue<T> &commands() {
+        return _commandQueue(static_cast<const T *>(nullptr));
+    }
+
+    /**
+     * Sets number of samples captured per topic. 0 only counts samples.
+     */
+    void setCaptureDepth(size_t depth);
+
+    /**
+     * Returns counters of all topics with any activity.
+     */
+    std::vector<SALStandIn::TopicStatistics> statistics();
+
+    salReturn salTelemetryPub(char *) { return SAL__OK; }
+    salReturn salTelemetrySub(char *) { return SAL__OK; }
+    salReturn salEventPub(char *) { return SAL__OK; }
+    salReturn salEventSub(char *) { return SAL__OK; }
+    salReturn salProcessor(char *) { return SAL__OK; }
+    salReturn salCommand(char *) { return SAL__OK; }
+
+    double getCurrentTime() { return SALStandIn::now(); }
+    void setDebugLevel(int level) { _debug_level = level; }
+
+    /**
+     * Reports topic counters at debug level.
+     */
+    void salShutdown();
+
+    static std::string getSALVersion();
+    static std::string getXMLVersion();
+
+private:
+#define SAL_STANDIN_TELEMETRY_MEMBER(topic)                                                          \
+    SALStandIn::Topic<MTM1M3TS_##topic##C> _##topic;                                                 \
+    SALStandIn::Topic<MTM1M3TS_##topic##C> &_topic(const MTM1M3TS_##topic##C *) { return _##topic; }
+
+#define SAL_STANDIN_EVENT_MEMBER(topic)                                                             \
+    SALStandIn::Topic<MTM1M3TS_logevent_##topic##C> _logevent_##topic;                              \
+    SALStandIn::Topic<MTM1M3TS_logevent_##topic##C> &_topic(const MTM1M3TS_logevent_##topic##C *) { \
+        return _logevent_##topic;                                                                   \
+    }
+
+#define SAL_STANDIN_COMMAND_MEMBER(topic)                                   \
+    SALStandIn::CommandQueue<MTM1M3TS_command_##topic##C> _command_##topic; \
+    SALStandIn::CommandQueue<MTM1M3TS_command_##topic##C> &_commandQueue(   \
+            const MTM1M3TS_command_##topic##C *) {                          \
+        return _command_##topic;                                            \
+    }
+
+    SAL_STANDIN_TELEMETRY(SAL_STANDIN_TELEMETRY_MEMBER)
+    SAL_STANDIN_EVENTS(SAL_STANDIN_EVENT_MEMBER)
+    SAL_STANDIN_COMMANDS(SAL_STANDIN_COMMAND_MEMBER)
+
+#undef SAL_STANDIN_TELEMETRY_MEMBER
+#undef SAL_STANDIN_EVENT_MEMBER
+#undef SAL_STANDIN_COMMAND_MEMBER
+
+    int _debug_level;
+};
+
+#endif  // !_TS_SAL_STANDIN_MTM1M3TS_H_
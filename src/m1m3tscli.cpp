@@ -20,9 +20,22 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 #include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -35,6 +48,7 @@
 #include <cRIO/ThermalILC.h>
 
 #ifndef SIMULATOR
+#include <Modbus/Buffer.h>
 #include <Transports/FPGASerialDevice.h>
 #endif
 
@@ -56,6 +70,11 @@
 #endif
 #include <MPU/VFD.h>
 
+#include <LiveState.h>
+#include <Settings/FCUApplicationSettings.h>
+#include <Telemetry/Journal.h>
+#include <Telemetry/TelemetryHistory.h>
+
 using namespace LSST::cRIO;
 using namespace LSST::M1M3::TS;
 using namespace std::chrono_literals;
@@ -107,6 +126,12 @@ public:
     int glycolTemperature(command_vec cmds);
     int slot4(command_vec);
     int ilcPower(command_vec);
+    int history(command_vec cmds);
+    int journalExport(command_vec cmds);
+    int liveState(command_vec cmds);
+    int fcuTop(command_vec cmds);
+    int fcuTopLive(command_vec cmds);
+    int busBench(command_vec cmds);
 
 protected:
     virtual FPGA *newFPGA(const char *dir, bool &fpga_singleton) override;
@@ -152,6 +177,127 @@ private:
     void _printTimestamp(std::string prefix, bool nullTimer);
 };
 
+/**
+ * FCU values displayed by fcu-top. NAN (or -1 for fan targets) marks values
+ * not provided by the data source.
+ */
+struct FcuTopFrame {
+    FcuTopFrame() { clear(); }
+
+    void clear();
+
+    bool valid[NUM_TS_ILC];
+    uint8_t status[NUM_TS_ILC];
+    float absoluteTemperature[NUM_TS_ILC];
+    float differentialTemperature[NUM_TS_ILC];
+    int fanRPM[NUM_TS_ILC];
+    float heaterPWM[NUM_TS_ILC];
+    int targetFanRPM[NUM_TS_ILC];
+
+    std::string source;
+    float rate;
+    float bus_time;
+    float age;
+    int errors;
+    std::string last_error;
+};
+
+/**
+ * Collects thermal status replies for fcu-top.
+ */
+class TopThermalILC : public PrintThermalILC {
+public:
+    TopThermalILC(uint8_t bus, FcuTopFrame *frame) : ILCBusList(bus), PrintThermalILC(bus), _frame(frame) {}
+
+protected:
+    void processThermalStatus(uint8_t address, uint8_t status, float differentialTemperature, uint8_t fanRPM,
+                              float absoluteTemperature) override;
+
+private:
+    FcuTopFrame *_frame;
+};
+
+/**
+ * Renders FCUs on terminal, arranged by their position on the mirror
+ * (FCUApplicationSettings::Table).
+ */
+class FcuTop {
+public:
+    FcuTop();
+
+    void render(const FcuTopFrame &frame);
+
+    /**
+     * Waits for refresh period.
+     *
+     * @param period refresh period
+     *
+     * @return false if user requested exit (pressed enter)
+     */
+    static bool wait(std::chrono::milliseconds period);
+
+private:
+    static constexpr int CELL_WIDTH = 6;
+
+    struct Cell {
+        int index;
+        int column;
+    };
+
+    std::vector<std::vector<Cell>> _rows;
+};
+
+/**
+ * ILC used by bus-bench. Doesn't print responses, remembers ILC modes.
+ */
+class BenchThermalILC : public PrintThermalILC {
+public:
+    BenchThermalILC(uint8_t bus) : ILCBusList(bus), PrintThermalILC(bus) {
+        std::fill(mode, mode + NUM_TS_ILC + 1, UNKNOWN_MODE);
+    }
+
+    // 0 is Standby, mode of ILCs which didn't report status must be distinguishable
+    static constexpr uint8_t UNKNOWN_MODE = 0xFF;
+
+    uint8_t mode[NUM_TS_ILC + 1];
+
+protected:
+    void processServerID(uint8_t address, uint64_t uniqueID, uint8_t ilcAppType, uint8_t networkNodeType,
+                         uint8_t ilcSelectedOptions, uint8_t networkNodeOptions, uint8_t majorRev,
+                         uint8_t minorRev, std::string firmwareName) override {}
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override;
+    void processChangeILCMode(uint8_t address, uint16_t mode) override {}
+    void processThermalStatus(uint8_t address, uint8_t status, float differentialTemperature, uint8_t fanRPM,
+                              float absoluteTemperature) override {}
+    void processReHeaterGains(uint8_t address, float proportionalGain, float integralGain) override {}
+};
+
+/**
+ * Transaction statistics of a single bus-bench test.
+ */
+struct BusBenchResult {
+    enum Outcome { OK, TIMEOUT, CRC, ERROR };
+
+    BusBenchResult(std::string _name) : name(_name), total(0) {}
+
+    /**
+     * Runs and times a single transaction.
+     *
+     * @param transaction executes the transaction, throws on failure
+     *
+     * @return transaction outcome
+     */
+    Outcome run(std::function<void()> transaction);
+
+    void print() const;
+
+    std::string name;
+    std::vector<float> latencies;  // successful transactions, in microseconds
+    int counts[4] = {0};
+    float total;  // seconds spent on bus
+    std::string last_error;
+};
+
 #define ILC_ARG "<ILC..>"
 
 M1M3TScli::M1M3TScli(const char *name, const char *description) : FPGACliApp(name, description) {
@@ -204,6 +350,26 @@ M1M3TScli::M1M3TScli(const char *name, const char *description) : FPGACliApp(nam
     addCommand("glycol-temperature", std::bind(&M1M3TScli::glycolTemperature, this, std::placeholders::_1),
                "", NEED_FPGA, NULL, "Primts glycol temperature values");
 
+    addCommand("telemetry-history", std::bind(&M1M3TScli::history, this, std::placeholders::_1), "DSs", 0,
+               "<window (s)> <column> [socket]",
+               "Prints min/max/mean of telemetry column(s) over the window, queried from the running CSC. "
+               "Column is topic, topic.column or topic.column[index], e.g. thermalData.absoluteTemperature");
+    addCommand("journal-export", std::bind(&M1M3TScli::journalExport, this, std::placeholders::_1), "Ss", 0,
+               "<journal> [CSV file]", "Exports telemetry journal to CSV file (or prints it)");
+    addCommand("live-state", std::bind(&M1M3TScli::liveState, this, std::placeholders::_1), "s", 0,
+               "[segment]", "Prints live state exported by the running CSC in the shared memory");
+    addCommand("fcu-top", std::bind(&M1M3TScli::fcuTop, this, std::placeholders::_1), "d", NEED_FPGA,
+               "[period (s)]", "Continuously polls FCUs thermal status and displays them. Enter to quit");
+    addCommand("bus-bench", std::bind(&M1M3TScli::busBench, this, std::placeholders::_1), "IS?", NEED_FPGA,
+               "<cycles> <tests> [CSV file] [" ILC_ARG "]",
+               "Benchmarks ILC bus and MPU transactions. Tests is comma separated list of ILC functions "
+               "(17 server ID, 18 server status, 65 change mode to the current mode - ILCs which didn't "
+               "report their mode are skipped, 88 thermal status, 89 thermal demand - switches heaters and "
+               "fans off) and MPU reads (<mpu>:<register>[:<length>]). ILCs default to all FCUs");
+    addCommand("fcu-top-live", std::bind(&M1M3TScli::fcuTopLive, this, std::placeholders::_1), "ds", 0,
+               "[period (s)] [segment]",
+               "Continuously displays FCUs from the running CSC live state. Enter to quit");
+
     addILC(std::make_shared<PrintThermalILC>(1));
 
     flow_meter_1 = std::make_shared<FlowMeterPrint>();
@@ -386,7 +552,15 @@ int M1M3TScli::printPump(command_vec cmds) {
             }
             vfd->set_frequency(targetFreq);
         } else {
-            fpga->setCoolantPumpPower(onOff(cmds[0]));
+            bool on = onOff(cmds[0]);
+            if (on) {
+                auto power_up = fpga->getCoolantPumpPowerUpTime();
+                if (power_up > std::chrono::steady_clock::now()) {
+                    std::cout << "Waiting for EGW pump power down.." << std::endl;
+                    std::this_thread::sleep_until(power_up);
+                }
+            }
+            fpga->setCoolantPumpPower(on);
             std::cout << "Turned pump " << cmds[0] << std::endl;
             return 0;
         }
@@ -546,6 +720,621 @@ int M1M3TScli::slot4(command_vec) {
     return 0;
 }
 
+int M1M3TScli::history(command_vec cmds) {
+    std::string path = cmds.size() > 2 ? cmds[2] : "/var/lib/M1M3TS/history.sock";
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "Cannot connect to " << path << ": " << strerror(errno) << std::endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+
+    std::string request = cmds[0] + " " + cmds[1] + "\n";
+    if (write(fd, request.c_str(), request.length()) != static_cast<ssize_t>(request.length())) {
+        std::cerr << "Cannot send query: " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    std::string response;
+    char buf[1024];
+    ssize_t len;
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        response.append(buf, len);
+    }
+    close(fd);
+
+    if (response.compare(0, 6, "ERROR ") == 0) {
+        std::cerr << response.substr(6);
+        return -1;
+    }
+
+    std::cout << std::left << std::setw(45) << "Column" << std::right << std::setw(7) << "Count"
+              << std::setw(12) << "Min" << std::setw(12) << "Max" << std::setw(12) << "Mean" << std::endl;
+
+    std::istringstream is(response);
+    std::string name, count, min, max, mean;
+    while (is >> name >> count >> min >> max >> mean) {
+        std::cout << std::left << std::setw(45) << name << std::right << std::setw(7) << count
+                  << std::setw(12) << min << std::setw(12) << max << std::setw(12) << mean << std::endl;
+    }
+
+    return 0;
+}
+
+int M1M3TScli::journalExport(command_vec cmds) {
+    try {
+        Telemetry::JournalReader journal(cmds[0]);
+        if (cmds.size() > 1) {
+            std::ofstream csv(cmds[1]);
+            if (!csv) {
+                std::cerr << "Cannot open " << cmds[1] << " for writing." << std::endl;
+                return -1;
+            }
+            journal.export_csv(csv);
+            std::cout << "Exported " << journal.rows() << " " << journal.topic() << " rows ("
+                      << journal.columns().size() << " columns) to " << cmds[1] << std::endl;
+        } else {
+            journal.export_csv(std::cout);
+        }
+    } catch (std::runtime_error &er) {
+        std::cerr << "Cannot export journal: " << er.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+template <typename T>
+static bool loadLive(const SeqLock<T> &lock, T &value, const char *name, double now) {
+    if (lock.try_load(value, 1000) == false) {
+        std::cout << name << ": inconsistent (writer died?)" << std::endl;
+        return false;
+    }
+    if (lock.version() == 0) {
+        std::cout << name << ": not yet written" << std::endl;
+        return false;
+    }
+    std::cout << fmt::format("{} (age {:.3f} s, {} updates)", name, now - value.timestamp, lock.version())
+              << std::endl;
+    return true;
+}
+
+int M1M3TScli::liveState(command_vec cmds) {
+    try {
+        LiveStateReader live(cmds.empty() ? LiveState::SEGMENT : cmds[0]);
+        double now = Telemetry::TelemetryHistory::now();
+
+        std::cout << fmt::format("CSC PID {}, running for {:.0f} s", live->pid, now - live->started)
+                  << std::endl;
+
+        LiveGlycolLoopTemperature glycol;
+        if (loadLive(live->glycolLoopTemperature, glycol, "Glycol loop temperature", now)) {
+            std::cout << fmt::format(
+                                 "  Above mirror {:.2f} Inside cell {:.2f} {:.2f} {:.2f}\n"
+                                 "  Telescope supply {:.2f} return {:.2f} Mirror supply {:.2f} return {:.2f}",
+                                 glycol.aboveMirrorTemperature, glycol.insideCellTemperature1,
+                                 glycol.insideCellTemperature2, glycol.insideCellTemperature3,
+                                 glycol.telescopeCoolantSupplyTemperature,
+                                 glycol.telescopeCoolantReturnTemperature, glycol.mirrorCoolantSupplyTemperature,
+                                 glycol.mirrorCoolantReturnTemperature)
+                      << std::endl;
+        }
+
+        LiveMixingValve valve;
+        if (loadLive(live->mixingValve, valve, "Mixing valve", now)) {
+            std::cout << fmt::format("  Raw {:.3f} Position {:.2f}%", valve.rawValvePosition, valve.valvePosition)
+                      << std::endl;
+        }
+
+        LiveFlowMeter flow;
+        if (loadLive(live->flowMeter, flow, "Flow meter", now)) {
+            std::cout << fmt::format("  Signal {:.1f} Flow {:.2f} Totalizer net {:.1f} pos {:.1f} neg {:.1f}",
+                                     flow.signalStrength, flow.flowRate, flow.netTotalizer,
+                                     flow.positiveTotalizer, flow.negativeTotalizer)
+                      << std::endl;
+        }
+
+        LiveGlycolPump pump;
+        if (loadLive(live->glycolPump, pump, "Glycol pump", now)) {
+            std::cout << fmt::format(
+                                 "  Commanded {:.2f} Target {:.2f} Output {:.2f} Hz Speed {:.2f}\n"
+                                 "  Current {:.2f} A Bus {:.1f} V Output {:.1f} V",
+                                 pump.commandedFrequency, pump.targetFrequency, pump.outputFrequency,
+                                 pump.speedFeedback, pump.outputCurrent, pump.busVoltage, pump.outputVoltage)
+                      << std::endl;
+        }
+
+        LiveThermalData thermal;
+        LiveFcuTargets targets;
+        bool have_thermal = loadLive(live->thermalData, thermal, "Thermal data", now);
+        bool have_targets = loadLive(live->fcuTargets, targets, "FCU targets", now);
+        if (have_thermal || have_targets) {
+            std::cout << fmt::format("  {:>3s} {:>6s} {:>7s} {:>8s} {:>7s} | {:>8s} {:>7s}", "FCU", "Status",
+                                     "Abs", "Diff", "RPM", "Heater %", "RPM")
+                      << std::endl;
+            for (int i = 0; i < NUM_TS_ILC; i++) {
+                std::string row = fmt::format("  {:3d}", i + 1);
+                if (have_thermal) {
+                    row += fmt::format("   0x{:02x} {:7.2f} {:8.2f} {:7d}", thermal.status[i],
+                                       thermal.absoluteTemperature[i], thermal.differentialTemperature[i],
+                                       thermal.fanRPM[i]);
+                } else {
+                    row += fmt::format("{:32s}", "");
+                }
+                if (have_targets) {
+                    row += fmt::format(" | {:8.1f} {:7d}", targets.heaterPWM[i], targets.fanRPM[i]);
+                }
+                std::cout << row << std::endl;
+            }
+        }
+    } catch (std::runtime_error &er) {
+        std::cerr << "Cannot read live state: " << er.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+void FcuTopFrame::clear() {
+    for (int i = 0; i < NUM_TS_ILC; i++) {
+        valid[i] = false;
+        status[i] = 0;
+        absoluteTemperature[i] = NAN;
+        differentialTemperature[i] = NAN;
+        fanRPM[i] = 0;
+        heaterPWM[i] = NAN;
+        targetFanRPM[i] = -1;
+    }
+}
+
+void TopThermalILC::processThermalStatus(uint8_t address, uint8_t status, float differentialTemperature,
+                                         uint8_t fanRPM, float absoluteTemperature) {
+    if (address < 1 || address > NUM_TS_ILC) {
+        return;
+    }
+    int index = address - 1;
+    _frame->valid[index] = true;
+    _frame->status[index] = status;
+    _frame->differentialTemperature[index] = differentialTemperature;
+    _frame->fanRPM[index] = fanRPM * 10;
+    _frame->absoluteTemperature[index] = absoluteTemperature;
+}
+
+FcuTop::FcuTop() {
+    // rows closer than 8" are displayed on the same line, cell width corresponds to 26.2" (the closest FCUs)
+    const float row_gap = 8 * Settings::IN2M;
+    const float cell_span = 26.2 * Settings::IN2M;
+
+    auto &table = Settings::FCUApplicationSettings::Table;
+
+    std::vector<int> order(NUM_TS_ILC);
+    float x_min = table[0].xPosition;
+    for (int i = 0; i < NUM_TS_ILC; i++) {
+        order[i] = i;
+        x_min = std::min(x_min, table[i].xPosition);
+    }
+    std::sort(order.begin(), order.end(),
+              [&table](int a, int b) { return table[a].yPosition > table[b].yPosition; });
+
+    std::vector<std::vector<int>> rows;
+    float last_y = NAN;
+    for (auto i : order) {
+        if (rows.empty() || last_y - table[i].yPosition > row_gap) {
+            rows.emplace_back();
+        }
+        rows.back().push_back(i);
+        last_y = table[i].yPosition;
+    }
+
+    for (auto &row : rows) {
+        std::sort(row.begin(), row.end(),
+                  [&table](int a, int b) { return table[a].xPosition < table[b].xPosition; });
+        std::vector<Cell> cells;
+        int next = 0;
+        for (auto i : row) {
+            int column = std::lround((table[i].xPosition - x_min) / cell_span * CELL_WIDTH);
+            // FCUs sharing position are displayed next to each other
+            column = std::max(column, next);
+            cells.push_back(Cell{table[i].address - 1, column});
+            next = column + CELL_WIDTH;
+        }
+        _rows.push_back(cells);
+    }
+}
+
+static std::string colour(const char *code, const std::string &text) {
+    return fmt::format("\033[{}m{}\033[0m", code, text);
+}
+
+void FcuTop::render(const FcuTopFrame &frame) {
+    double sum = 0;
+    int valid = 0;
+    for (int i = 0; i < NUM_TS_ILC; i++) {
+        if (frame.valid[i]) {
+            sum += frame.absoluteTemperature[i];
+            valid++;
+        }
+    }
+    float mean = valid > 0 ? sum / valid : NAN;
+
+    std::string out = "\033[H\033[2J";
+    out += fmt::format("fcu-top: {} | {:.1f} Hz | ", frame.source, frame.rate);
+    if (std::isnan(frame.bus_time)) {
+        out += "bus time n/a";
+    } else {
+        out += fmt::format("bus time {:.1f} ms", frame.bus_time);
+    }
+    if (std::isnan(frame.age) == false) {
+        out += fmt::format(" | age {:.2f} s", frame.age);
+    }
+    out += fmt::format(" | {}/{} FCUs | mean {:.2f} \u00b0C | errors {}\n", valid, NUM_TS_ILC, mean,
+                       frame.errors);
+    if (frame.last_error.empty() == false) {
+        out += colour("31", frame.last_error) + "\n";
+    }
+    out += "\n";
+
+    for (auto &row : _rows) {
+        std::string lines[4];
+        int width = 0;
+        for (auto &cell : row) {
+            for (auto &l : lines) {
+                l += std::string(cell.column - width, ' ');
+            }
+            width = cell.column + CELL_WIDTH;
+
+            int i = cell.index;
+            if (frame.valid[i] == false) {
+                lines[0] += colour("2", fmt::format("{:>4d}? ", i + 1));
+                for (int l = 1; l < 4; l++) {
+                    lines[l] += colour("2", fmt::format("{:>5s} ", "-"));
+                }
+                continue;
+            }
+
+            // ILC fault, heater or fan breaker tripped
+            if (frame.status[i] & 0x0D) {
+                lines[0] += colour("1;41", fmt::format("{:>4d}!", i + 1)) + " ";
+            } else if (frame.status[i] & 0x02) {
+                lines[0] += colour("1;33", fmt::format("{:>4d}d", i + 1)) + " ";
+            } else {
+                lines[0] += colour("1", fmt::format("{:>4d} ", i + 1)) + " ";
+            }
+
+            float deviation = fabs(frame.absoluteTemperature[i] - mean);
+            lines[1] += colour(deviation < 0.5 ? "32" : (deviation < 1.5 ? "33" : "31"),
+                               fmt::format("{:>5.1f}", frame.absoluteTemperature[i])) +
+                        " ";
+
+            float heater = frame.heaterPWM[i];
+            if (std::isnan(heater)) {
+                lines[2] += colour("2", fmt::format("{:>5s}", "-")) + " ";
+            } else {
+                lines[2] += colour(heater == 0 ? "2" : (heater >= 95 ? "31" : "32"),
+                                   fmt::format("{:>4.0f}%", heater)) +
+                            " ";
+            }
+
+            int fan = frame.fanRPM[i];
+            int target = frame.targetFanRPM[i];
+            const char *fan_colour = "0";
+            if (target > 0) {
+                fan_colour = abs(fan - target) > std::max(target / 5, 100) ? "31" : "32";
+            } else if (fan == 0) {
+                fan_colour = "2";
+            } else if (target == 0) {
+                fan_colour = "33";
+            }
+            lines[3] += colour(fan_colour, fmt::format("{:>5d}", fan)) + " ";
+        }
+        for (auto &l : lines) {
+            out += l + "\n";
+        }
+    }
+
+    out += "\n" + colour("1;41", "!") + " fault/breaker " + colour("1;33", "d") + " heater disabled " +
+           colour("2", "?") + " no data | rows: address, absolute \u00b0C (vs mean), heater %, fan RPM (vs target)" +
+           "\nPress Enter to quit\n";
+
+    std::cout << out << std::flush;
+}
+
+bool FcuTop::wait(std::chrono::milliseconds period) {
+    pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    if (poll(&pfd, 1, period.count()) > 0) {
+        std::string line;
+        std::getline(std::cin, line);
+        return false;
+    }
+    return true;
+}
+
+int M1M3TScli::fcuTop(command_vec cmds) {
+    auto period = std::chrono::milliseconds(cmds.empty() ? 1000 : std::lround(std::stod(cmds[0]) * 1000));
+
+    FcuTopFrame frame;
+    frame.source = "bus";
+    frame.age = NAN;
+    frame.errors = 0;
+
+    TopThermalILC ilc(1, &frame);
+    FcuTop top;
+
+    auto last = std::chrono::steady_clock::now();
+    do {
+        frame.clear();
+        ilc.clear();
+        for (int i = 0; i < NUM_TS_ILC; i++) {
+            ilc.reportThermalStatus(Settings::FCUApplicationSettings::Table[i].address);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            getFPGA()->ilcCommands(ilc, ilcTimeout);
+        } catch (std::exception &ex) {
+            frame.errors++;
+            frame.last_error = ex.what();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        frame.bus_time = std::chrono::duration<float, std::milli>(end - start).count();
+        frame.rate = 1.0 / std::chrono::duration<float>(end - last).count();
+        last = end;
+
+        top.render(frame);
+    } while (FcuTop::wait(period));
+
+    return 0;
+}
+
+int M1M3TScli::fcuTopLive(command_vec cmds) {
+    auto period = std::chrono::milliseconds(cmds.empty() ? 1000 : std::lround(std::stod(cmds[0]) * 1000));
+
+    try {
+        LiveStateReader live(cmds.size() > 1 ? cmds[1] : LiveState::SEGMENT);
+
+        FcuTopFrame frame;
+        frame.source = "live state";
+        frame.bus_time = NAN;
+        frame.errors = 0;
+
+        FcuTop top;
+
+        uint64_t last_version = live->thermalData.version();
+        auto last = std::chrono::steady_clock::now();
+        do {
+            frame.clear();
+
+            LiveThermalData thermal;
+            if (live->thermalData.try_load(thermal, 1000) && live->thermalData.version() > 0) {
+                for (int i = 0; i < NUM_TS_ILC; i++) {
+                    frame.valid[i] = std::isnan(thermal.absoluteTemperature[i]) == false;
+                    frame.status[i] = thermal.status[i];
+                    frame.absoluteTemperature[i] = thermal.absoluteTemperature[i];
+                    frame.differentialTemperature[i] = thermal.differentialTemperature[i];
+                    frame.fanRPM[i] = thermal.fanRPM[i];
+                }
+                frame.age = Telemetry::TelemetryHistory::now() - thermal.timestamp;
+            } else {
+                frame.errors++;
+                frame.last_error = "Cannot load thermal data";
+                frame.age = NAN;
+            }
+
+            LiveFcuTargets targets;
+            if (live->fcuTargets.try_load(targets, 1000) && live->fcuTargets.version() > 0) {
+                for (int i = 0; i < NUM_TS_ILC; i++) {
+                    frame.heaterPWM[i] = targets.heaterPWM[i];
+                    frame.targetFanRPM[i] = targets.fanRPM[i];
+                }
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            uint64_t version = live->thermalData.version();
+            frame.rate = (version - last_version) / std::chrono::duration<float>(now - last).count();
+            last_version = version;
+            last = now;
+
+            top.render(frame);
+        } while (FcuTop::wait(period));
+    } catch (std::runtime_error &er) {
+        std::cerr << "Cannot read live state: " << er.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+void BenchThermalILC::processServerStatus(uint8_t address, uint8_t _mode, uint16_t status, uint16_t faults) {
+    if (address <= NUM_TS_ILC) {
+        mode[address] = _mode;
+    }
+}
+
+BusBenchResult::Outcome BusBenchResult::run(std::function<void()> transaction) {
+    Outcome outcome = OK;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        transaction();
+    } catch (Modbus::MissingResponse &mr) {
+        outcome = TIMEOUT;
+        last_error = mr.what();
+    } catch (Modbus::CRCError &crc) {
+        outcome = CRC;
+        last_error = crc.what();
+    } catch (std::exception &ex) {
+        outcome = ERROR;
+        last_error = ex.what();
+    }
+    float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+    total += elapsed;
+    counts[outcome]++;
+    if (outcome == OK) {
+        latencies.push_back(elapsed * 1e6);
+    }
+    return outcome;
+}
+
+void BusBenchResult::print() const {
+    int transactions = counts[OK] + counts[TIMEOUT] + counts[CRC] + counts[ERROR];
+    std::cout << fmt::format("{:<16s} {:>7d} {:>9.1f}", name, transactions, counts[OK] / total);
+
+    if (latencies.empty()) {
+        std::cout << fmt::format(" {:>8s} {:>8s} {:>8s} {:>8s}", "-", "-", "-", "-");
+    } else {
+        auto sorted = latencies;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](float p) { return sorted[std::lround(p * (sorted.size() - 1))]; };
+        std::cout << fmt::format(" {:>8.0f} {:>8.0f} {:>8.0f} {:>8.0f}", percentile(0.5), percentile(0.9),
+                                 percentile(0.99), sorted.back());
+    }
+
+    std::cout << fmt::format(" {:>8d} {:>5d} {:>6d}", counts[TIMEOUT], counts[CRC], counts[ERROR]) << std::endl;
+    if (counts[OK] != transactions) {
+        std::cout << "  last error: " << last_error << std::endl;
+    }
+}
+
+int M1M3TScli::busBench(command_vec cmds) {
+    static const char *outcomes[] = {"ok", "timeout", "crc", "error"};
+
+    int cycles = std::stoi(cmds[0]);
+
+    std::ofstream csv;
+    if (cmds.size() > 2 && isdigit(cmds[2][0]) == false) {
+        csv.open(cmds[2]);
+        if (!csv) {
+            std::cerr << "Cannot open " << cmds[2] << " for writing." << std::endl;
+            return -1;
+        }
+        csv << "test,address,cycle,latency_us,outcome" << std::endl;
+        cmds.erase(cmds.begin() + 2);
+    }
+
+    std::vector<uint8_t> addresses;
+    if (cmds.size() > 2) {
+        for (auto u : getILCs(command_vec(cmds.begin() + 2, cmds.end()))) {
+            addresses.push_back(u.second);
+        }
+    } else {
+        for (int address = 1; address <= NUM_TS_ILC; address++) {
+            addresses.push_back(address);
+        }
+    }
+
+    BenchThermalILC ilc(1);
+
+    // learns ILC modes, so function 65 keeps ILCs in their current mode. Each
+    // ILC is asked separately, so a missing ILC doesn't hide the others
+    for (auto address : addresses) {
+        ilc.clear();
+        ilc.reportServerStatus(address);
+        try {
+            getFPGA()->ilcCommands(ilc, ilcTimeout);
+        } catch (std::exception &ex) {
+            std::cerr << "Cannot read ILC " << +address << " status: " << ex.what() << std::endl;
+        }
+    }
+
+    std::cout << fmt::format("{:<16s} {:>7s} {:>9s} {:>8s} {:>8s} {:>8s} {:>8s} {:>8s} {:>5s} {:>6s}", "Test",
+                             "N", "OK/s", "p50 us", "p90 us", "p99 us", "max us", "timeouts", "CRC", "errors")
+              << std::endl;
+
+    std::stringstream tests(cmds[1]);
+    std::string test;
+    while (std::getline(tests, test, ',')) {
+        BusBenchResult result(test);
+
+        auto record = [&](uint8_t address, int cycle, BusBenchResult::Outcome outcome) {
+            if (csv.is_open()) {
+                csv << test << "," << +address << "," << cycle << ","
+                    << (outcome == BusBenchResult::OK ? result.latencies.back() : NAN) << ","
+                    << outcomes[outcome] << "\n";
+            }
+        };
+
+        auto sep = test.find(':');
+        if (sep != std::string::npos) {
+            auto mpu = getMPU(test.substr(0, sep));
+            if (mpu == nullptr) {
+                std::cerr << "Invalid MPU device name " << test.substr(0, sep) << ". List of known devices: "
+                          << std::endl;
+                printMPU();
+                return -1;
+            }
+            auto transport = get_transport(mpu);
+
+            auto reg_spec = test.substr(sep + 1);
+            auto len_sep = reg_spec.find(':');
+            uint16_t reg = std::stoi(reg_spec, nullptr, 0);
+            uint16_t len = len_sep == std::string::npos ? 1 : std::stoi(reg_spec.substr(len_sep + 1), nullptr, 0);
+
+            for (int cycle = 0; cycle < cycles; cycle++) {
+                auto outcome = result.run([&]() {
+                    mpu->clear();
+                    mpu->readHoldingRegisters(reg, len, 255);
+                    transport->commands(*mpu, 2s);
+                });
+                record(0, cycle, outcome);
+            }
+        } else {
+            std::function<void(uint8_t)> call;
+            std::vector<uint8_t> test_addresses = addresses;
+            switch (std::stoi(test)) {
+                case 17:
+                    call = [&ilc](uint8_t address) { ilc.reportServerID(address); };
+                    break;
+                case 18:
+                    call = [&ilc](uint8_t address) { ilc.reportServerStatus(address); };
+                    break;
+                case 65:
+                    call = [&ilc](uint8_t address) { ilc.changeILCMode(address, ilc.mode[address]); };
+                    test_addresses.clear();
+                    for (auto address : addresses) {
+                        if (ilc.mode[address] == BenchThermalILC::UNKNOWN_MODE) {
+                            std::cerr << "Warning: ILC " << +address
+                                      << " mode is unknown, skipping it in change mode test." << std::endl;
+                        } else {
+                            test_addresses.push_back(address);
+                        }
+                    }
+                    break;
+                case 88:
+                    call = [&ilc](uint8_t address) { ilc.reportThermalStatus(address); };
+                    break;
+                case 89:
+                    call = [&ilc](uint8_t address) { ilc.setThermalDemand(address, 0, 0); };
+                    break;
+                default:
+                    std::cerr << "Unsupported test " << test << std::endl;
+                    return -1;
+            }
+
+            for (int cycle = 0; cycle < cycles; cycle++) {
+                for (auto address : test_addresses) {
+                    auto outcome = result.run([&]() {
+                        ilc.clear();
+                        call(address);
+                        getFPGA()->ilcCommands(ilc, ilcTimeout);
+                    });
+                    record(address, cycle, outcome);
+                }
+            }
+        }
+
+        result.print();
+    }
+
+    return 0;
+}
+
 int M1M3TScli::ilcPower(command_vec cmds) {
     uint16_t buf[2] = {FPGAAddress::ILC_POWER, onOff(cmds[0])};
     dynamic_cast<IFPGA *>(getFPGA())->writeCommandFIFO(buf, 2, 10);
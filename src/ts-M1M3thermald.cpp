@@ -47,10 +47,16 @@
 #include "Commands/ReloadConfiguration.h"
 #include "Commands/SAL.h"
 #include "Events/SummaryState.h"
+#include "FilePersister.h"
+#include "LiveState.h"
+#include "PhaseTimer.h"
+#include "PublishQueue.h"
 #include "SALThermalILC.h"
 #include "TSApplication.h"
 #include "TSPublisher.h"
 #include "TSSubscriber.h"
+#include "Telemetry/HistoryServer.h"
+#include "Telemetry/Journal.h"
 
 using namespace std::chrono_literals;
 using namespace LSST::M1M3::TS;
@@ -80,10 +86,13 @@ private:
 SALSinkMacro(MTM1M3TS);
 
 void M1M3thermald::init() {
+    PhaseTimer timer("Initialization");
+
     SPDLOG_INFO("Setting root path {}", getConfigRoot());
     LSST::cRIO::Settings::Path::setRootPath(getConfigRoot());
 
     SPDLOG_INFO("Initializing M1M3TS SAL");
+    timer.start("SAL");
     try {
         _m1m3tsSAL = std::make_shared<SAL_MTM1M3TS>();
     } catch (std::runtime_error &er) {
@@ -105,9 +114,21 @@ void M1M3thermald::init() {
     SPDLOG_INFO("Starting cRIO/real HW version. Version {}", VERSION);
 #endif
 
+    timer.stop("SAL");
+
     SPDLOG_INFO("Creating publisher");
+    timer.start("threads");
     TSPublisher::instance().setSAL(_m1m3tsSAL);
     TSPublisher::instance().setLogLevel(static_cast<int>(getSpdLogLogLevel()) * 10);
+    PublishQueue::instance().start();
+    FilePersister::instance().start();
+    Telemetry::Journal::instance().start();
+
+    try {
+        LiveState::instance().open();
+    } catch (std::runtime_error &er) {
+        SPDLOG_WARN("Live state will not be exported: {}", er.what());
+    }
 
     TSPublisher::instance().startGlycolTemperatureThread();
 
@@ -118,10 +139,15 @@ void M1M3thermald::init() {
     SPDLOG_INFO("Creating subscriber");
     addThread(new TSSubscriber(_m1m3tsSAL));
 
+    addThread(new Telemetry::HistoryServer(std::string(getConfigRoot()) + "/history.sock"));
+
     LSST::cRIO::ControllerThread::instance().enqueue(std::make_shared<Commands::EnterControl>());
 
     signal(SIGUSR1, sig_usr1);
 
+    timer.stop("threads");
+    timer.report();
+
     daemonOK();
 }
 
@@ -132,6 +158,14 @@ void M1M3thermald::done() {
     TSPublisher::instance().stopFlowMeterThread();
     TSPublisher::instance().stopPumpThread();
 
+    SPDLOG_INFO("Flushing SAL publish queue");
+    PublishQueue::instance().stop();
+    SPDLOG_INFO("Writing pending persisted files");
+    FilePersister::instance().stop();
+    Telemetry::Journal::instance().stop();
+    Telemetry::Journal::instance().close();
+    LiveState::instance().close();
+
     SPDLOG_INFO("Shutting down M1M3thermald");
     removeSink();
 
@@ -0,0 +1,193 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests hot path doesn't allocate memory.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <cRIO/Settings/Path.h>
+
+#include <Commands/Update.h>
+#include <Events/AppliedSetpoints.h>
+#include <Events/SummaryState.h>
+#include <IFPGA.h>
+#include <MPU/GlycolTemperatureParser.h>
+#include <SALThermalILC.h>
+#include <SeqLock.h>
+#include <Settings/Controller.h>
+#include <TSApplication.h>
+#include <TSPublisher.h>
+#include <Tasks/HeatersTemperatureControl.h>
+#include <Telemetry/DataAge.h>
+#include <Telemetry/GlycolLoopTemperature.h>
+#include <Telemetry/ThermalData.h>
+
+using namespace LSST::M1M3::TS;
+
+static std::atomic<bool> count_allocations(false);
+static std::atomic<size_t> allocations(0);
+
+void *operator new(size_t size) {
+    if (count_allocations) {
+        allocations++;
+    }
+    void *ret = malloc(size == 0 ? 1 : size);
+    if (ret == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ret;
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+/**
+ * Counts allocations during its lifetime.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter() {
+        allocations = 0;
+        count_allocations = true;
+    }
+
+    ~AllocationCounter() { count_allocations = false; }
+
+    size_t count() {
+        count_allocations = false;
+        return allocations;
+    }
+};
+
+static const std::string LINE =
+        "C01=0020.1000,C02=0022.0000,C03=0021.7000,C04=0022.3000,C05=-005.0000,C06=-003.0000,"
+        "C07=0013.0000,C08=0011.0000\r\n";
+
+TEST_CASE("Glycol temperature parsing doesn't allocate", "[Allocations]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+    size_t parsed = 0;
+
+    AllocationCounter counter;
+
+    for (int i = 0; i < 10000; i++) {
+        // simulate partial reads
+        parser.push(reinterpret_cast<const uint8_t *>(LINE.data()), 30);
+        parser.push(reinterpret_cast<const uint8_t *>(LINE.data()) + 30, LINE.length() - 30);
+        while (parser.next(temperatures)) {
+            parsed++;
+        }
+    }
+
+    REQUIRE(counter.count() == 0);
+    REQUIRE(parsed == 10000);
+}
+
+TEST_CASE("Glycol loop snapshot doesn't allocate", "[Allocations]") {
+    SeqLock<Telemetry::GlycolLoopSnapshot> lock;
+    Telemetry::GlycolLoopSnapshot snapshot;
+    float sum = 0;
+
+    AllocationCounter counter;
+
+    for (int i = 0; i < 10000; i++) {
+        snapshot.frame = i;
+        snapshot.received = std::chrono::steady_clock::now();
+        for (int t = 0; t < 8; t++) {
+            snapshot.temperatures[t] = i + t;
+        }
+        lock.store(snapshot);
+        sum += lock.load().mirror_loop_average(0.95);
+    }
+
+    REQUIRE(counter.count() == 0);
+    REQUIRE(sum > 0);
+}
+
+TEST_CASE("Data age recording doesn't allocate", "[Allocations]") {
+    auto &data_age = Telemetry::DataAge::instance();
+
+    AllocationCounter counter;
+
+    for (int i = 0; i < 10000; i++) {
+        auto now = std::chrono::steady_clock::now();
+        data_age.record(Telemetry::DataAge::FCU_TEMPERATURE, now - std::chrono::milliseconds(i % 100), now);
+    }
+    auto percentiles = data_age.percentiles(Telemetry::DataAge::FCU_TEMPERATURE);
+
+    REQUIRE(counter.count() == 0);
+    REQUIRE(percentiles.samples == Telemetry::DataAge::SAMPLES);
+}
+
+/**
+ * Runs single control cycle against the simulated FPGA - bus polling as in
+ * Commands::Update (without its rate limit), Update itself and heaters
+ * control task.
+ */
+static void control_cycle() {
+    {
+        auto ilc_lock = TSApplication::lock_ilc();
+        Telemetry::ThermalData::instance().reset();
+        TSApplication::ilc()->clear();
+        TSApplication::instance().callFunctionOnAllIlcs([](uint8_t address) {
+            TSApplication::ilc()->reportThermalStatus(address);
+            TSApplication::ilc()->reportServerStatus(address);
+        });
+        IFPGA::get().ilcCommands(*TSApplication::ilc(), 800);
+        Telemetry::ThermalData::instance().send();
+    }
+    Commands::Update().run();
+    Tasks::HeatersTemperatureControl().run();
+}
+
+TEST_CASE("Control cycles don't allocate", "[Allocations]") {
+    std::shared_ptr<SAL_MTM1M3TS> m1m3TSSAL = std::make_shared<SAL_MTM1M3TS>();
+    TSPublisher::instance().setSAL(m1m3TSSAL);
+    TSApplication::instance().setILC(new SALThermalILC(m1m3TSSAL));
+
+    LSST::cRIO::Settings::Path::setRootPath("data");
+    Settings::Controller::instance().load("_init.yaml");
+
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_StandbyState);
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_DisabledState);
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_EnabledState);
+
+    Events::AppliedSetpoints::instance().set_applied_setpoints(10, 11);
+
+    // first cycles size command buffers and initialize function statics
+    for (int i = 0; i < 10; i++) {
+        control_cycle();
+    }
+
+    AllocationCounter counter;
+
+    for (int i = 0; i < 1000; i++) {
+        control_cycle();
+    }
+
+    REQUIRE(counter.count() == 0);
+}
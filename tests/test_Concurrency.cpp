@@ -0,0 +1,200 @@
+/*
+ * This file is part of M1M3 TS test suite. Concurrency stress tests of shared singletons.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <cRIO/Settings/Path.h>
+
+#include "Commands/Update.h"
+#include "Events/AppliedSetpoints.h"
+#include "Events/EnabledILC.h"
+#include "Events/FcuTargets.h"
+#include "Events/SummaryState.h"
+#include "IFPGA.h"
+#include "SALThermalILC.h"
+#include "Settings/Controller.h"
+#include "TSApplication.h"
+#include "TSPublisher.h"
+#include "Tasks/HeatersTemperatureControl.h"
+#include "Telemetry/ThermalData.h"
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+/**
+ * Shared singletons are accessed from the controller thread, SAL subscriber
+ * and MPU threads. Those tests run the production code paths from multiple
+ * threads; they are meant to run under ThreadSanitizer (-fsanitize=thread) in
+ * the simulator build. Every race found shall be reproduced here. Set
+ * STRESS_DURATION environment variable to stress duration in milliseconds
+ * (defaults to 500).
+ */
+
+static void setup() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+
+    std::shared_ptr<SAL_MTM1M3TS> m1m3TSSAL = std::make_shared<SAL_MTM1M3TS>();
+    TSPublisher::instance().setSAL(m1m3TSSAL);
+    TSApplication::instance().setILC(new SALThermalILC(m1m3TSSAL));
+
+    LSST::cRIO::Settings::Path::setRootPath("data");
+    Settings::Controller::instance().load("_init.yaml");
+
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_StandbyState);
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_DisabledState);
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_EnabledState);
+
+    initialized = true;
+}
+
+/**
+ * Calls each function repeatedly from its own thread, till stress duration
+ * expires.
+ *
+ * @return number of exceptions thrown from the functions
+ */
+static int hammer(std::vector<std::function<void(int)>> functions) {
+    const char *env_duration = getenv("STRESS_DURATION");
+    auto duration = std::chrono::milliseconds(env_duration == nullptr ? 500 : atoi(env_duration));
+
+    std::atomic<int> exceptions(0);
+    auto end = std::chrono::steady_clock::now() + duration;
+
+    std::vector<std::thread> threads;
+    for (auto f : functions) {
+        threads.emplace_back([f, end, &exceptions]() {
+            for (int i = 0; std::chrono::steady_clock::now() < end; i++) {
+                try {
+                    f(i);
+                } catch (std::exception &ex) {
+                    exceptions++;
+                }
+            }
+        });
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    return exceptions;
+}
+
+TEST_CASE("Applied setpoints set from controller and glycol temperature threads", "[stress]") {
+    setup();
+
+    auto &setpoints = Events::AppliedSetpoints::instance();
+
+    // SAL applySetpoints command and glycol temperature thread safety limit
+    auto setter = [&setpoints](int i) { setpoints.set_applied_setpoints(10 + i % 5, 11 + i % 5); };
+    // GlycolLoopTemperature and the control tasks
+    auto getter = [&setpoints](int i) {
+        float glycol = setpoints.get_applied_glycol_setpoint();
+        float heaters = setpoints.get_applied_heaters_setpoint();
+        if (glycol < 10 || glycol > 14 || heaters < 11 || heaters > 15) {
+            throw std::runtime_error("Invalid setpoint");
+        }
+    };
+    auto sender = [&setpoints](int i) {
+        setpoints.is_valid();
+        setpoints.send();
+    };
+
+    setpoints.set_applied_setpoints(10, 11);
+
+    REQUIRE(hammer({setter, setter, getter, getter, sender}) == 0);
+    REQUIRE(setpoints.is_valid());
+}
+
+TEST_CASE("Enabled ILC changed while the bus is used", "[stress]") {
+    setup();
+
+    auto &enabled_ilc = Events::EnabledILC::instance();
+
+    // settings load and ILC response processing
+    auto toggle = [&enabled_ilc](int i) { enabled_ilc.setEnabled(i % LSST::cRIO::NUM_TS_ILC, i % 2); };
+    auto problem = [&enabled_ilc](int i) { enabled_ilc.communicationProblem(i % LSST::cRIO::NUM_TS_ILC); };
+    // commands iterating over enabled ILCs
+    auto iterate = [](int i) {
+        int count = 0;
+        TSApplication::instance().callFunctionOnAllIlcs([&count](uint8_t address) { count++; });
+        if (count > LSST::cRIO::NUM_TS_ILC) {
+            throw std::runtime_error("Too many enabled ILCs");
+        }
+    };
+    auto sender = [&enabled_ilc](int i) { enabled_ilc.send(); };
+
+    REQUIRE(hammer({toggle, problem, iterate, iterate, sender}) == 0);
+
+    enabled_ilc.reset();
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        REQUIRE(enabled_ilc.isEnabled(i));
+    }
+}
+
+TEST_CASE("ILC command buffer shared by controller and MPU threads", "[stress]") {
+    setup();
+
+    Events::AppliedSetpoints::instance().set_applied_setpoints(10, 11);
+
+    // controller thread - bus polling as in Commands::Update, but without
+    // its rate limit, Update itself and heaters control task
+    auto controller = [](int i) {
+        {
+            auto ilc_lock = TSApplication::lock_ilc();
+            Telemetry::ThermalData::instance().reset();
+            TSApplication::ilc()->clear();
+            TSApplication::instance().callFunctionOnAllIlcs(
+                    [](uint8_t address) { TSApplication::ilc()->reportThermalStatus(address); });
+            IFPGA::get().ilcCommands(*TSApplication::ilc(), 800);
+            Telemetry::ThermalData::instance().send();
+        }
+        Commands::Update().run();
+        Tasks::HeatersTemperatureControl().run();
+    };
+    // fault raised on MPU thread (IFPGA::panic) sets FCU targets
+    auto fault = [](int i) {
+        std::vector<int> heater(LSST::cRIO::NUM_TS_ILC, i % 256);
+        std::vector<int> fan(LSST::cRIO::NUM_TS_ILC, (i + 100) % 256);
+        Events::FcuTargets::instance().set_FCU_heaters_fans(heater, fan);
+    };
+
+    REQUIRE(hammer({controller, fault, fault}) == 0);
+
+    Events::FcuTargets::instance().set_FCU_heaters_fans(std::vector<int>(LSST::cRIO::NUM_TS_ILC, 0),
+                                                        std::vector<int>(LSST::cRIO::NUM_TS_ILC, 0));
+    auto ilc_lock = TSApplication::lock_ilc();
+    for (auto f : Events::FcuTargets::instance().get_fanRPM()) {
+        REQUIRE(f == 0);
+    }
+}
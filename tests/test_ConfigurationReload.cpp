@@ -0,0 +1,102 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests configuration reload.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <SAL_MTM1M3TS.h>
+
+#include <cRIO/Settings/Path.h>
+
+#include "Settings/Controller.h"
+#include "Settings/Heaters.h"
+#include "Settings/Setpoint.h"
+#include "TSPublisher.h"
+
+using namespace LSST::M1M3::TS;
+using namespace LSST::M1M3::TS::Settings;
+
+void init_sal() {
+    std::shared_ptr<SAL_MTM1M3TS> m1m3TSSAL = std::make_shared<SAL_MTM1M3TS>();
+    m1m3TSSAL->setDebugLevel(2);
+    TSPublisher::instance().setSAL(m1m3TSSAL);
+}
+
+const std::string reload_root = "data/_reload";
+
+void modify_configuration(std::function<void(YAML::Node &)> modify) {
+    auto path = reload_root + "/v1/_init.yaml";
+    YAML::Node doc = YAML::LoadFile(path);
+    modify(doc);
+    std::ofstream ofs(path, std::ostream::out | std::ostream::trunc);
+    ofs << YAML::Dump(doc);
+}
+
+TEST_CASE("Reload only changed sections", "[ConfigurationReload]") {
+    init_sal();
+
+    std::filesystem::remove_all(reload_root);
+    std::filesystem::create_directories(reload_root);
+    std::filesystem::copy("data/v1", reload_root + "/v1", std::filesystem::copy_options::recursive);
+
+    LSST::cRIO::Settings::Path::setRootPath(reload_root);
+    REQUIRE_NOTHROW(Controller::instance().load("_init.yaml"));
+
+    auto &heaters = Heaters::instance();
+    LSST::PID::LimitedPID *pids[LSST::cRIO::NUM_TS_ILC];
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        pids[i] = heaters.heaters_PID[i];
+        REQUIRE(pids[i] != nullptr);
+    }
+    auto saved_setpoints = Setpoint::instance()._saved_setpoints;
+
+    REQUIRE(Controller::instance().reload().empty());
+
+    modify_configuration([](YAML::Node &doc) {
+        doc["Heaters"]["Interval"] = 20;
+        YAML::Node fcu;
+        fcu["Address"] = 12;
+        fcu["P"] = 0.8;
+        doc["Heaters"]["PID"]["FCU"] = fcu;
+    });
+
+    auto changed = Controller::instance().reload();
+    REQUIRE(changed == std::vector<std::string>{"Heaters"});
+    REQUIRE(heaters.interval == 20);
+
+    // PIDs are updated in place
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        REQUIRE(heaters.heaters_PID[i] == pids[i]);
+    }
+
+    modify_configuration([](YAML::Node &doc) { doc["Setpoint"]["Timestep"] = 5; });
+
+    changed = Controller::instance().reload();
+    REQUIRE(changed == std::vector<std::string>{"Setpoint"});
+    REQUIRE(Setpoint::instance().timestep == 5);
+    REQUIRE(Setpoint::instance()._saved_setpoints == saved_setpoints);
+
+    std::filesystem::remove_all(reload_root);
+    LSST::cRIO::Settings::Path::setRootPath("data");
+}
@@ -0,0 +1,137 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests controller state checkpoint.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <time.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/Settings/Path.h>
+
+#include "Settings/ControlCheckpoint.h"
+#include "Tasks/BumplessTransfer.h"
+
+using namespace LSST::M1M3::TS::Settings;
+using namespace LSST::M1M3::TS::Tasks;
+using namespace std::chrono_literals;
+
+TEST_CASE("Test controller checkpoint saving and recovery", "[ControlCheckpoint]") {
+    LSST::cRIO::Settings::Path::setRootPath("data");
+
+    ControlCheckpoint checkpoint("_checkpoint.yaml", 600);
+    std::filesystem::remove(checkpoint.file_path);
+
+    REQUIRE_NOTHROW(checkpoint.load());
+    REQUIRE(checkpoint.is_valid() == false);
+
+    checkpoint.glycol_setpoint = 4;
+    checkpoint.heaters_setpoint = 5;
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        checkpoint.heater_PWM[i] = i / 2.0;
+        checkpoint.fan_RPM[i] = i * 10;
+    }
+    checkpoint.finer_control_state = 2;
+    checkpoint.mixing_valve_target = 35;
+
+    REQUIRE_NOTHROW(checkpoint.save());
+    REQUIRE(checkpoint.is_valid() == true);
+    REQUIRE(std::filesystem::exists(checkpoint.file_path + ".tmp") == false);
+
+    ControlCheckpoint loaded("_checkpoint.yaml", 600);
+    REQUIRE_NOTHROW(loaded.load());
+
+    REQUIRE(loaded.is_valid() == true);
+    REQUIRE(loaded.glycol_setpoint == 4);
+    REQUIRE(loaded.heaters_setpoint == 5);
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        CHECK(loaded.heater_PWM[i] == i / 2.0);
+        CHECK(loaded.fan_RPM[i] == i * 10);
+    }
+    REQUIRE(loaded.finer_control_state == 2);
+    REQUIRE(loaded.mixing_valve_target == 35);
+
+    REQUIRE_NOTHROW(std::filesystem::remove(checkpoint.file_path) == true);
+}
+
+TEST_CASE("Test too old controller checkpoint", "[ControlCheckpoint]") {
+    LSST::cRIO::Settings::Path::setRootPath("data");
+
+    ControlCheckpoint checkpoint("_old_checkpoint.yaml", 600);
+
+    {
+        std::ofstream ofs(checkpoint.file_path, std::ostream::out | std::ostream::trunc);
+        ofs << "Date: 1970-01-01T23:15:18" << std::endl
+            << "Setpoints:" << std::endl
+            << "  Glycol: 10" << std::endl
+            << "  Heaters: 11" << std::endl;
+    }
+
+    REQUIRE_NOTHROW(checkpoint.load());
+    REQUIRE(checkpoint.is_valid() == false);
+
+    REQUIRE_NOTHROW(std::filesystem::remove(checkpoint.file_path) == true);
+}
+
+TEST_CASE("Test checkpoint with wrong number of FCUs", "[ControlCheckpoint]") {
+    LSST::cRIO::Settings::Path::setRootPath("data");
+
+    ControlCheckpoint checkpoint("_short_checkpoint.yaml", 600);
+
+    char dat_buf[80];
+    auto now = time(nullptr);
+    struct tm now_tm;
+    gmtime_r(&now, &now_tm);
+    strftime(dat_buf, 80, "%FT%T", &now_tm);
+
+    {
+        std::ofstream ofs(checkpoint.file_path, std::ostream::out | std::ostream::trunc);
+        ofs << "Date: " << dat_buf << std::endl
+            << "Setpoints: {Glycol: 10, Heaters: 11}" << std::endl
+            << "FCU: {HeaterPWM: [1, 2], FanRPM: [10, 20]}" << std::endl;
+    }
+
+    REQUIRE_NOTHROW(checkpoint.load());
+    REQUIRE(checkpoint.is_valid() == false);
+
+    REQUIRE_NOTHROW(std::filesystem::remove(checkpoint.file_path) == true);
+}
+
+TEST_CASE("Test bumpless transfer of resumed PID output", "[ControlCheckpoint]") {
+    BumplessTransfer transfer;
+
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(transfer.active() == false);
+    REQUIRE(transfer.apply(20, start) == 20);
+
+    transfer.seed(100, 10);
+    REQUIRE(transfer.active() == true);
+
+    // first output is the restored one
+    REQUIRE(transfer.apply(20, start) == 100);
+    REQUIRE(transfer.apply(30, start + 5s) == 30 + 40);
+    REQUIRE(transfer.active() == true);
+
+    REQUIRE(transfer.apply(30, start + 10s) == 30);
+    REQUIRE(transfer.active() == false);
+    REQUIRE(transfer.apply(40, start + 5s) == 40);
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests FCU anomaly detection.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+#include <Settings/FcuAnomaly.h>
+#include <Telemetry/FcuAnomalyDetector.h>
+
+using namespace LSST::M1M3::TS;
+using namespace LSST::M1M3::TS::Telemetry;
+
+constexpr int NUM = LSST::cRIO::NUM_TS_ILC;
+
+/**
+ * Runs cycles with all FCUs healthy - heaters at 60 %, fans at 800 RPM -
+ * except FCUs modified by the fault function.
+ */
+template <typename F>
+void run_cycles(int cycles, F fault) {
+    auto &detector = FcuAnomalyDetector::instance();
+    for (int c = 0; c < cycles; c++) {
+        for (int i = 0; i < NUM; i++) {
+            float differential = 1.5;
+            int fan = 800;
+            float absolute = 10 + (i % 5) * 0.1;
+            fault(i, differential, fan, absolute);
+            detector.update(i, 60, 800, differential, fan, absolute);
+        }
+        detector.tick();
+    }
+}
+
+TEST_CASE("Anomaly detection", "[FcuAnomalyDetector]") {
+    auto &settings = Settings::FcuAnomaly::instance();
+    settings.enabled = true;
+    settings.smoothing = 0.2;
+    settings.persistence = 5;
+
+    auto &detector = FcuAnomalyDetector::instance();
+    detector.reset();
+
+    auto healthy = [](int, float &, int &, float &) {};
+
+    SECTION("Healthy FCUs") {
+        run_cycles(50, healthy);
+        REQUIRE(detector.tick() == 0);
+    }
+
+    SECTION("Stuck fan") {
+        run_cycles(20, healthy);
+        run_cycles(3, [](int i, float &, int &fan, float &) {
+            if (i == 7) fan = 0;
+        });
+        // not persistent yet
+        REQUIRE(detector.has_anomaly(7, FcuAnomalyDetector::FAN_STUCK) == false);
+
+        run_cycles(20, [](int i, float &, int &fan, float &) {
+            if (i == 7) fan = 0;
+        });
+        REQUIRE(detector.has_anomaly(7, FcuAnomalyDetector::FAN_STUCK));
+        REQUIRE(detector.has_anomaly(7, FcuAnomalyDetector::HEATER_DEAD) == false);
+        REQUIRE(detector.has_anomaly(8, FcuAnomalyDetector::FAN_STUCK) == false);
+        REQUIRE(detector.tick() == 1);
+
+        // recovers
+        run_cycles(50, healthy);
+        REQUIRE(detector.has_anomaly(7, FcuAnomalyDetector::FAN_STUCK) == false);
+        REQUIRE(detector.tick() == 0);
+    }
+
+    SECTION("Dead heater") {
+        run_cycles(50, [](int i, float &differential, int &, float &) {
+            if (i == 12) differential = 0.1;
+        });
+        REQUIRE(detector.has_anomaly(12, FcuAnomalyDetector::HEATER_DEAD));
+        REQUIRE(detector.tick() == 1);
+    }
+
+    SECTION("Drifting RTD") {
+        run_cycles(50, [](int i, float &, int &, float &absolute) {
+            if (i == 90) absolute += 5;
+        });
+        REQUIRE(detector.has_anomaly(90, FcuAnomalyDetector::RTD_DRIFT));
+        REQUIRE(detector.has_anomaly(89, FcuAnomalyDetector::RTD_DRIFT) == false);
+    }
+
+    SECTION("Missing data are ignored") {
+        run_cycles(50, [](int i, float &differential, int &fan, float &absolute) {
+            if (i == 3) {
+                differential = NAN;
+                absolute = NAN;
+                fan = -1;
+            }
+        });
+        REQUIRE(detector.tick() == 0);
+    }
+
+    detector.reset();
+}
+
+TEST_CASE("Anomaly detection benchmark", "[.][benchmark]") {
+    auto &settings = Settings::FcuAnomaly::instance();
+    settings.enabled = true;
+
+    auto &detector = FcuAnomalyDetector::instance();
+    detector.reset();
+
+    BENCHMARK("Single FCU update") { detector.update(5, 60, 800, 1.5, 790, 10.2); };
+
+    BENCHMARK("Control cycle - all FCUs and tick") {
+        for (int i = 0; i < NUM; i++) {
+            detector.update(i, 60, 800, 1.5, 790, 10 + i * 0.01);
+        }
+        return detector.tick();
+    };
+}
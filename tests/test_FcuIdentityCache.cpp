@@ -0,0 +1,163 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests FCU identity cache.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/Settings/Path.h>
+
+#include "Settings/FcuIdentityCache.h"
+
+using namespace LSST::M1M3::TS::Settings;
+
+class IdentityILC : public LSST::cRIO::ThermalILC {
+public:
+    IdentityILC() : ILC::ILCBusList::ILCBusList(1), ThermalILC(1) {}
+
+protected:
+    void processServerID(uint8_t address, uint64_t uniqueID, uint8_t ilcAppType, uint8_t networkNodeType,
+                         uint8_t ilcSelectedOptions, uint8_t networkNodeOptions, uint8_t majorRev,
+                         uint8_t minorRev, std::string firmwareName) override {}
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override {}
+    void processChangeILCMode(uint8_t address, uint16_t mode) override {}
+    void processSetTempILCAddress(uint8_t address, uint8_t newAddress) override {}
+    void processResetServer(uint8_t address) override {}
+    void processThermalStatus(uint8_t address, uint8_t status, float differentialTemperature, uint8_t fanRPM,
+                              float absoluteTemperature) override {}
+    void processReHeaterGains(uint8_t address, float proportionalGain, float integralGain) override {}
+};
+
+TEST_CASE("Test FCU identity cache persistence", "[FcuIdentityCache]") {
+    LSST::cRIO::Settings::Path::setRootPath("data");
+
+    auto &cache = FcuIdentityCache::instance();
+
+    YAML::Node config = YAML::Load("{Filename: _fcu_identity.yaml, MaxAge: 600}");
+
+    cache.disable();
+    std::filesystem::remove(LSST::cRIO::Settings::Path::getFilePath("v1/_fcu_identity.yaml"));
+
+    REQUIRE_NOTHROW(cache.load(config));
+    REQUIRE(cache.get(1).known == false);
+    REQUIRE(cache.get(96).known == false);
+
+    cache.update(1, {true, 0x010203040506, 2, 3, 4, 5, 1, 2, "FCU firmware"});
+    cache.update(96, {true, 0x0A0B0C0D0E0F, 2, 3, 4, 5, 1, 3, "FCU firmware"});
+
+    REQUIRE_NOTHROW(cache.apply());
+    REQUIRE(cache.cached() == 0);
+    REQUIRE(std::filesystem::exists(cache.file_path) == true);
+
+    cache.invalidate();
+    REQUIRE(cache.get(1).known == false);
+
+    // reload from the file
+    cache.disable();
+    REQUIRE_NOTHROW(cache.load(config));
+
+    auto identity = cache.get(1);
+    REQUIRE(identity.known == true);
+    REQUIRE(identity.uniqueID == 0x010203040506);
+    REQUIRE(identity.ilcAppType == 2);
+    REQUIRE(identity.networkNodeType == 3);
+    REQUIRE(identity.ilcSelectedOptions == 4);
+    REQUIRE(identity.networkNodeOptions == 5);
+    REQUIRE(identity.majorRev == 1);
+    REQUIRE(identity.minorRev == 2);
+    REQUIRE(identity.firmwareName == "FCU firmware");
+
+    REQUIRE(cache.get(2).known == false);
+    REQUIRE(cache.get(96).uniqueID == 0x0A0B0C0D0E0F);
+    REQUIRE(cache.get(96).minorRev == 3);
+
+    cache.disable();
+    REQUIRE_NOTHROW(std::filesystem::remove(cache.file_path) == true);
+}
+
+TEST_CASE("Test too old FCU identity cache", "[FcuIdentityCache]") {
+    LSST::cRIO::Settings::Path::setRootPath("data");
+
+    auto &cache = FcuIdentityCache::instance();
+    cache.disable();
+
+    {
+        std::ofstream ofs(LSST::cRIO::Settings::Path::getFilePath("v1/_old_fcu_identity.yaml"),
+                          std::ostream::out | std::ostream::trunc);
+        ofs << "Date: 1970-01-01T23:15:18" << std::endl
+            << "ILCs:" << std::endl
+            << "  - {Address: 1, UniqueID: 10, ILCAppType: 2, NetworkNodeType: 3, ILCSelectedOptions: 4, "
+               "NetworkNodeOptions: 5, MajorRev: 1, MinorRev: 2, FirmwareName: FCU}"
+            << std::endl;
+    }
+
+    REQUIRE_NOTHROW(cache.load(YAML::Load("{Filename: _old_fcu_identity.yaml, MaxAge: 600}")));
+    REQUIRE(cache.get(1).known == false);
+
+    cache.disable();
+    REQUIRE_NOTHROW(std::filesystem::remove(cache.file_path) == true);
+}
+
+TEST_CASE("Test FCU identity verification", "[FcuIdentityCache]") {
+    LSST::cRIO::Settings::Path::setRootPath("data");
+
+    auto &cache = FcuIdentityCache::instance();
+    IdentityILC ilc;
+
+    cache.disable();
+    std::filesystem::remove(LSST::cRIO::Settings::Path::getFilePath("v1/_verify_fcu_identity.yaml"));
+
+    REQUIRE_NOTHROW(
+            cache.load(YAML::Load("{Filename: _verify_fcu_identity.yaml, MaxAge: 600, RefreshCount: 8}")));
+
+    // first round discovers all ILCs, refresh window moves to 9-16
+    for (uint8_t address = 1; address <= LSST::cRIO::NUM_TS_ILC; address++) {
+        cache.request_identity(ilc, address, 1);
+        cache.update(address, {true, address, 2, 3, 4, 5, 1, 2, "FCU firmware"});
+    }
+    cache.apply();
+    REQUIRE(cache.cached() == 0);
+
+    // ILC 20 replies in wrong mode, ILC 30 doesn't reply, 9-16 are asked for ServerID
+    for (uint8_t address = 1; address <= LSST::cRIO::NUM_TS_ILC; address++) {
+        cache.request_identity(ilc, address, 1);
+        if (address == 30) {
+            continue;
+        }
+        cache.status(address, address == 20 ? 0 : 1);
+    }
+    cache.apply();
+    REQUIRE(cache.cached() == 86);
+    REQUIRE(cache.unconfirmed() == 2);
+    REQUIRE(cache.get(9).known == true);
+    REQUIRE(cache.get(20).known == false);
+    REQUIRE(cache.get(30).known == false);
+
+    // transaction failed before the status of ILC 1 was received, the round isn't applied
+    cache.request_identity(ilc, 1, 1);
+    cache.request_identity(ilc, 1, 1);
+    REQUIRE(cache.get(1).known == false);
+
+    cache.disable();
+    REQUIRE_NOTHROW(std::filesystem::remove(cache.file_path) == true);
+}
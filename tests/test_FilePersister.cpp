@@ -0,0 +1,94 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests background file persister.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "FilePersister.h"
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+std::string read_file(const std::string &path) {
+    std::ifstream ifs(path);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+TEST_CASE("Write file atomically", "[FilePersister]") {
+    std::string path = "data/_persister.txt";
+    std::filesystem::remove(path);
+
+    REQUIRE(FilePersister::write_atomically(path, "first"));
+    REQUIRE(read_file(path) == "first");
+
+    REQUIRE(FilePersister::write_atomically(path, "second"));
+    REQUIRE(read_file(path) == "second");
+    REQUIRE(std::filesystem::exists(path + ".tmp") == false);
+
+    REQUIRE(FilePersister::write_atomically("data/non-existing-dir/file.txt", "fail") == false);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Persist without running thread", "[FilePersister]") {
+    std::string path = "data/_persister_sync.txt";
+    std::filesystem::remove(path);
+
+    FilePersister::instance().persist(path, []() { return std::string("sync"); });
+    REQUIRE(read_file(path) == "sync");
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Coalesce rapid writes", "[FilePersister]") {
+    std::string path = "data/_persister_async.txt";
+    std::filesystem::remove(path);
+
+    auto &persister = FilePersister::instance();
+    persister.start();
+
+    auto before = persister.get_statistics();
+
+    for (int i = 0; i < 10; i++) {
+        persister.persist(path, [i]() { return std::to_string(i); });
+    }
+
+    REQUIRE(persister.flush(2s));
+    REQUIRE(read_file(path) == "9");
+
+    auto after = persister.get_statistics();
+    CHECK(after.requested - before.requested == 10);
+    CHECK(after.written - before.written < 10);
+    CHECK(after.coalesced - before.coalesced > 0);
+    CHECK(after.failed == before.failed);
+
+    persister.persist(path, []() { return std::string("on stop"); });
+    persister.stop();
+    REQUIRE(read_file(path) == "on stop");
+
+    std::filesystem::remove(path);
+}
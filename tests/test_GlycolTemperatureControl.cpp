@@ -20,6 +20,7 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
@@ -28,6 +29,7 @@
 #include <cRIO/Settings/Path.h>
 
 #include "Settings/Controller.h"
+#include "Settings/Heaters.h"
 #include "Settings/MixingValve.h"
 #include "Tasks/GlycolTemperatureControl.h"
 #include "Telemetry/FinerControl.h"
@@ -58,3 +60,29 @@ TEST_CASE("Finer Controller", "[FinerControl]") {
     REQUIRE(Telemetry::FinerControl::instance().get_target(4) == 20.0);
     REQUIRE(Telemetry::FinerControl::instance().get_target(4) == 20.0);
 }
+
+TEST_CASE("Control benchmark", "[.][benchmark]") {
+    init();
+
+    BENCHMARK("Settings::Controller::load") { Settings::Controller::instance().load("_init.yaml"); };
+
+    auto &finer_control = Telemetry::FinerControl::instance();
+    finer_control.set_target(20);
+
+    float valve = 4;
+    BENCHMARK("FinerControl::get_target") {
+        valve = valve > 90 ? 4 : valve + 0.1;
+        return finer_control.get_target(valve);
+    };
+
+    auto &heaters = Settings::Heaters::instance();
+    float temperature = 10;
+    BENCHMARK("Heaters LimitedPID::process - all FCUs") {
+        temperature = temperature > 30 ? 10 : temperature + 0.01;
+        double sum = 0;
+        for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+            sum += heaters.heaters_PID[i]->process(20, temperature + i * 0.01);
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,240 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests glycol temperature parser.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <MPU/GlycolTemperatureParser.h>
+
+using namespace LSST::M1M3::TS;
+using Catch::Matchers::WithinAbs;
+
+static const float GOOD[8] = {20.1, 22.0, 21.7, 22.3, -5.0, -3.0, 13.0, 11.0};
+
+static const std::string GOOD_LINE =
+        "C01=0020.1000,C02=0022.0000,C03=0021.7000,C04=0022.3000,C05=-005.0000,C06=-003.0000,"
+        "C07=0013.0000,C08=0011.0000";
+
+std::vector<uint8_t> read_corpus(const std::string &name) {
+    std::ifstream in("data/glycol_temperature/" + name, std::ios::binary);
+    REQUIRE(in.good());
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void push_string(GlycolTemperatureParser &parser, const std::string &data) {
+    parser.push(reinterpret_cast<const uint8_t *>(data.data()), data.length());
+}
+
+void check_good(const float temperatures[8]) {
+    for (int i = 0; i < 8; i++) {
+        CHECK_THAT(temperatures[i], WithinAbs(GOOD[i], 0.0001));
+    }
+}
+
+TEST_CASE("Parse single line", "[GlycolTemperatureParser]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    REQUIRE(parser.next(temperatures) == false);
+
+    push_string(parser, GOOD_LINE + "\r\n");
+    REQUIRE(parser.next(temperatures) == true);
+    check_good(temperatures);
+    REQUIRE(parser.last_line() == GOOD_LINE);
+
+    REQUIRE(parser.next(temperatures) == false);
+    REQUIRE(parser.size() == 0);
+    REQUIRE(parser.frames == 1);
+    REQUIRE(parser.garbage == 0);
+}
+
+TEST_CASE("Bare CR terminator doesn't drop data", "[GlycolTemperatureParser]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    push_string(parser, GOOD_LINE + "\r" + GOOD_LINE + "\r");
+    REQUIRE(parser.next(temperatures) == true);
+    check_good(temperatures);
+    REQUIRE(parser.next(temperatures) == true);
+    check_good(temperatures);
+    REQUIRE(parser.frames == 2);
+    REQUIRE(parser.garbage == 0);
+}
+
+TEST_CASE("Partial frame", "[GlycolTemperatureParser]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    push_string(parser, GOOD_LINE.substr(0, 20));
+    REQUIRE(parser.next(temperatures) == false);
+    REQUIRE(parser.size() == 20);
+
+    push_string(parser, GOOD_LINE.substr(20));
+    REQUIRE(parser.next(temperatures) == false);
+
+    push_string(parser, "\r");
+    REQUIRE(parser.next(temperatures) == true);
+    check_good(temperatures);
+
+    push_string(parser, "\n");
+    REQUIRE(parser.next(temperatures) == false);
+    REQUIRE(parser.size() == 0);
+}
+
+TEST_CASE("Missing sensors and channels", "[GlycolTemperatureParser]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    push_string(parser, "C01=0020.1000,C02=0999.9000,C03=\r\n");
+    REQUIRE(parser.next(temperatures) == true);
+    CHECK_THAT(temperatures[0], WithinAbs(20.1, 0.0001));
+    for (int i = 1; i < 8; i++) {
+        CHECK(std::isnan(temperatures[i]));
+    }
+    REQUIRE(parser.partial == 1);
+}
+
+TEST_CASE("Garbage doesn't overwrite values", "[GlycolTemperatureParser]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    push_string(parser, GOOD_LINE + "\r\n" + "garbage\r\n");
+    REQUIRE(parser.next(temperatures) == true);
+    REQUIRE(parser.next(temperatures) == false);
+    check_good(temperatures);
+    REQUIRE(parser.garbage == 1);
+}
+
+TEST_CASE("Overflow resynchronizes", "[GlycolTemperatureParser]") {
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    std::string noise(GlycolTemperatureParser::CAPACITY + 10, 'x');
+    REQUIRE(parser.push(reinterpret_cast<const uint8_t *>(noise.data()), noise.length()) == 10);
+    REQUIRE(parser.size() <= GlycolTemperatureParser::CAPACITY);
+    REQUIRE(parser.next(temperatures) == false);
+
+    push_string(parser, GOOD_LINE.substr(10) + "\r\n");
+    REQUIRE(parser.next(temperatures) == false);
+
+    push_string(parser, GOOD_LINE + "\r\n");
+    REQUIRE(parser.next(temperatures) == true);
+    check_good(temperatures);
+}
+
+struct corpus_entry {
+    const char *name;
+    uint64_t frames;
+    bool good;
+};
+
+TEST_CASE("Fuzz corpus", "[GlycolTemperatureParser]") {
+    const corpus_entry corpus[] = {
+            {"valid_crlf.txt", 4, true},       {"valid_cr.txt", 4, true},
+            {"valid_lf.txt", 4, true},         {"missing_sensor.txt", 2, false},
+            {"partial_frame.txt", 1, true},    {"leading_garbage.txt", 2, true},
+            {"truncated_fields.txt", 2, true}, {"wrong_order.txt", 2, true},
+            {"long_line.txt", 1, true},        {"binary_noise.txt", 1, true},
+            {"plus_sign.txt", 1, true},        {"empty_lines.txt", 1, true},
+    };
+
+    for (auto entry : corpus) {
+        auto data = read_corpus(entry.name);
+
+        // replay the corpus split into different chunk sizes
+        for (size_t chunk : {size_t(1), size_t(2), size_t(3), size_t(7), size_t(64), data.size()}) {
+            INFO("Corpus " << entry.name << " chunk " << chunk);
+
+            GlycolTemperatureParser parser;
+            float temperatures[8];
+
+            for (size_t i = 0; i < data.size(); i += chunk) {
+                parser.push(data.data() + i, std::min(chunk, data.size() - i));
+                REQUIRE(parser.size() <= GlycolTemperatureParser::CAPACITY);
+                while (parser.next(temperatures)) {
+                    for (int t = 0; t < 8; t++) {
+                        CHECK((std::isnan(temperatures[t]) || temperatures[t] < 900));
+                    }
+                }
+            }
+
+            CHECK(parser.frames == entry.frames);
+            if (entry.good) {
+                check_good(temperatures);
+            }
+        }
+    }
+}
+
+TEST_CASE("Random data", "[GlycolTemperatureParser]") {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<size_t> length(0, 300);
+
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    for (int i = 0; i < 1000; i++) {
+        uint8_t noise[300];
+        size_t len = length(gen);
+        for (size_t n = 0; n < len; n++) {
+            noise[n] = byte(gen);
+        }
+        parser.push(noise, len);
+        while (parser.next(temperatures)) {
+        }
+        REQUIRE(parser.size() <= GlycolTemperatureParser::CAPACITY);
+
+        // valid line after line terminator shall always be parsed
+        push_string(parser, "\r\n" + GOOD_LINE + "\r\n");
+        bool parsed = false;
+        while (parser.next(temperatures)) {
+            parsed = true;
+        }
+        REQUIRE(parsed);
+        check_good(temperatures);
+    }
+}
+
+TEST_CASE("Parser benchmark", "[.][benchmark]") {
+    std::string line = GOOD_LINE + "\r\n";
+    GlycolTemperatureParser parser;
+    float temperatures[8];
+
+    BENCHMARK("Push and parse line") {
+        push_string(parser, line);
+        return parser.next(temperatures);
+    };
+
+    BENCHMARK("Parse line only") {
+        return GlycolTemperatureParser::parse_line(GOOD_LINE.data(), GOOD_LINE.data() + GOOD_LINE.length(),
+                                                   temperatures);
+    };
+}
@@ -0,0 +1,164 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests ILC mode sequencer.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ILCModeSequencer.h>
+#include <SimulatedFPGA.h>
+#include <cRIO/ThermalILC.h>
+
+using namespace LSST::cRIO;
+using namespace LSST::M1M3::TS;
+
+/**
+ * Forwards mode changes to the sequencer. Ignores responses from the
+ * dropped address for the given number of transactions. Response from the
+ * throwing address interrupts the transaction for the given number of
+ * transactions, as a missing response does.
+ */
+class SequencedILC : public ThermalILC {
+public:
+    SequencedILC() : ILC::ILCBusList::ILCBusList(1), ThermalILC(1) {}
+
+    ILCModeSequencer *sequencer = nullptr;
+    uint8_t dropped_address = 0;
+    int drop_count = 0;
+    uint8_t throwing_address = 0;
+    int throw_count = 0;
+    int mode_changes = 0;
+
+protected:
+    void processServerID(uint8_t address, uint64_t uniqueID, uint8_t ilcAppType, uint8_t networkNodeType,
+                         uint8_t ilcSelectedOptions, uint8_t networkNodeOptions, uint8_t majorRev,
+                         uint8_t minorRev, std::string firmwareName) override {}
+
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override {}
+
+    void processChangeILCMode(uint8_t address, uint16_t mode) override {
+        mode_changes++;
+        if (address == dropped_address && drop_count > 0) {
+            drop_count--;
+            return;
+        }
+        if (address == throwing_address && throw_count > 0) {
+            throw_count--;
+            throw std::runtime_error("Simulated missing response");
+        }
+        sequencer->mode_changed(address, mode);
+    }
+
+    void processSetTempILCAddress(uint8_t address, uint8_t newAddress) override {}
+
+    void processResetServer(uint8_t address) override {}
+
+    void processThermalStatus(uint8_t address, uint8_t status, float differentialTemperature, uint8_t fanRPM,
+                              float absoluteTemperature) override {}
+
+    void processReHeaterGains(uint8_t address, float proportionalGain, float integralGain) override {}
+};
+
+static std::vector<uint8_t> all_addresses() {
+    std::vector<uint8_t> addresses;
+    for (int address = 1; address <= NUM_TS_ILC; address++) {
+        addresses.push_back(address);
+    }
+    return addresses;
+}
+
+TEST_CASE("Test ILC mode sequence", "[ILCModeSequencer]") {
+    SimulatedFPGA simulated;
+    SequencedILC ilc;
+
+    ILCModeSequencer sequencer(ilc, [&]() { simulated.ilcCommands(ilc, 10); });
+    ilc.sequencer = &sequencer;
+
+    REQUIRE(sequencer.run(all_addresses(), {ILC::Mode::ClearFaults, ILC::Mode::Standby}) == true);
+    REQUIRE(sequencer.transactions() == 2);
+    REQUIRE(sequencer.failed().empty());
+    REQUIRE(ilc.mode_changes == 2 * NUM_TS_ILC);
+
+    ilc.mode_changes = 0;
+    REQUIRE(sequencer.run(all_addresses(), {ILC::Mode::Disabled, ILC::Mode::Enabled}) == true);
+    REQUIRE(sequencer.transactions() == 2);
+    REQUIRE(ilc.mode_changes == 2 * NUM_TS_ILC);
+}
+
+TEST_CASE("Test ILC mode sequence retries", "[ILCModeSequencer]") {
+    SimulatedFPGA simulated;
+    SequencedILC ilc;
+
+    ILCModeSequencer sequencer(ilc, [&]() { simulated.ilcCommands(ilc, 10); }, 2);
+    ilc.sequencer = &sequencer;
+
+    SECTION("Recovered address") {
+        ilc.dropped_address = 17;
+        ilc.drop_count = 2;
+
+        REQUIRE(sequencer.run(all_addresses(), {ILC::Mode::Disabled}) == true);
+        REQUIRE(sequencer.transactions() == 3);
+        // only the failed address is retried
+        REQUIRE(ilc.mode_changes == NUM_TS_ILC + 2);
+    }
+
+    SECTION("Failed address") {
+        ilc.dropped_address = 33;
+        ilc.drop_count = 100;
+
+        REQUIRE(sequencer.run(all_addresses(), {ILC::Mode::Disabled, ILC::Mode::Enabled}) == false);
+        REQUIRE(sequencer.failed() == std::vector<uint8_t>({33}));
+        // failed address is excluded from the following step
+        REQUIRE(sequencer.transactions() == 4);
+        REQUIRE(ilc.mode_changes == NUM_TS_ILC + 2 + NUM_TS_ILC - 1);
+    }
+}
+
+TEST_CASE("Test ILC mode sequence with interrupted transaction", "[ILCModeSequencer]") {
+    SimulatedFPGA simulated;
+    SequencedILC ilc;
+
+    ILCModeSequencer sequencer(ilc, [&]() { simulated.ilcCommands(ilc, 10); }, 2);
+    ilc.sequencer = &sequencer;
+
+    ilc.throwing_address = 50;
+
+    SECTION("Recovered address") {
+        ilc.throw_count = 1;
+
+        REQUIRE(sequencer.run(all_addresses(), {ILC::Mode::Disabled}) == true);
+        REQUIRE(sequencer.failed().empty());
+        // addresses following the interrupted slot are retried first, together with the failed one
+        REQUIRE(sequencer.transactions() == 2);
+        REQUIRE(ilc.mode_changes == NUM_TS_ILC + 1);
+    }
+
+    SECTION("Failed address") {
+        ilc.throw_count = 100;
+
+        REQUIRE(sequencer.run(all_addresses(), {ILC::Mode::Disabled, ILC::Mode::Enabled}) == false);
+        // only the address in the interrupted slot fails, the following addresses aren't excluded
+        REQUIRE(sequencer.failed() == std::vector<uint8_t>({50}));
+        REQUIRE(sequencer.transactions() == 4);
+        REQUIRE(ilc.mode_changes == NUM_TS_ILC + 2 + NUM_TS_ILC - 1);
+    }
+}
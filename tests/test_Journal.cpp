@@ -0,0 +1,287 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests telemetry journal.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Settings/Journal.h>
+#include <Telemetry/Journal.h>
+
+using namespace LSST::M1M3::TS;
+using namespace LSST::M1M3::TS::Telemetry;
+
+static std::vector<std::string> list_directory(const std::string &path) {
+    std::vector<std::string> ret;
+    DIR *dir = opendir(path.c_str());
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] != '.') {
+            ret.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    return ret;
+}
+
+TEST_CASE("Write and read journal file", "[Journal]") {
+    char tmpdir[] = "/tmp/M1M3TS_journal_XXXXXX";
+    REQUIRE(mkdtemp(tmpdir) != nullptr);
+    std::string path = std::string(tmpdir) + "/test.journal";
+
+    std::vector<std::string> columns = {"a", "b[0]", "b[1]"};
+    size_t capacity = 0;
+
+    {
+        // space for two blocks
+        JournalFile file(path, "test", columns, 4096 + 2 * JournalFile::block_size(3), 1000);
+
+        float values[3];
+        for (int r = 0;; r++) {
+            values[0] = r;
+            values[1] = -r;
+            values[2] = r == 3 ? NAN : r * 0.5;
+            if (file.append(1000 + r, values) == false) {
+                break;
+            }
+            capacity++;
+        }
+        REQUIRE(capacity == 2 * JournalFile::BLOCK_ROWS);
+        REQUIRE(file.rows() == capacity);
+
+        REQUIRE_THROWS(JournalFile(path, "test", columns, 4096, 1000));
+    }
+
+    JournalReader reader(path);
+    REQUIRE(reader.topic() == "test");
+    REQUIRE(reader.columns() == columns);
+    REQUIRE(reader.rows() == capacity);
+
+    for (uint64_t r = 0; r < reader.rows(); r++) {
+        REQUIRE(reader.timestamp(r) == 1000 + r);
+        REQUIRE(reader.value(r, 0) == r);
+        REQUIRE(reader.value(r, 1) == -static_cast<float>(r));
+        if (r == 3) {
+            REQUIRE(std::isnan(reader.value(r, 2)));
+        } else {
+            REQUIRE(reader.value(r, 2) == r * 0.5f);
+        }
+    }
+
+    std::ostringstream csv;
+    reader.export_csv(csv);
+    std::istringstream lines(csv.str());
+    std::string line;
+    std::getline(lines, line);
+    REQUIRE(line == "timestamp,test.a,test.b[0],test.b[1]");
+    std::getline(lines, line);
+    REQUIRE(line == "1000.000000,0,0,0");
+    std::getline(lines, line);
+    REQUIRE(line == "1001.000000,1,-1,0.5");
+
+    unlink(path.c_str());
+    rmdir(tmpdir);
+}
+
+TEST_CASE("Journal rotation", "[Journal]") {
+    char tmpdir[] = "/tmp/M1M3TS_journal_XXXXXX";
+    REQUIRE(mkdtemp(tmpdir) != nullptr);
+
+    auto &settings = Settings::Journal::instance();
+    settings.enabled = true;
+    settings.directory = tmpdir;
+    settings.fileSize = 1024 * 1024;
+    settings.rotationInterval = 10;
+    settings.keep = 2;
+
+    std::vector<std::string> columns = {"x"};
+    float value = 1;
+
+    // rotated every 10 seconds
+    for (int t = 0; t < 35; t++) {
+        Journal::instance().append("test", columns, 1700000000 + t, &value);
+    }
+    Journal::instance().close();
+
+    auto files = list_directory(tmpdir);
+    REQUIRE(files.size() == 2);
+
+    std::sort(files.begin(), files.end());
+    REQUIRE(files[0] == "test_20231114T221340.journal");
+    REQUIRE(files[1] == "test_20231114T221350.journal");
+
+    JournalReader reader(std::string(tmpdir) + "/" + files[0]);
+    REQUIRE(reader.rows() == 10);
+    REQUIRE(reader.timestamp(0) == 1700000020);
+
+    settings.enabled = false;
+
+    for (auto &f : files) {
+        unlink((std::string(tmpdir) + "/" + f).c_str());
+    }
+    rmdir(tmpdir);
+}
+
+TEST_CASE("Journal rotation within the same second", "[Journal]") {
+    char tmpdir[] = "/tmp/M1M3TS_journal_XXXXXX";
+    REQUIRE(mkdtemp(tmpdir) != nullptr);
+
+    auto &settings = Settings::Journal::instance();
+    settings.enabled = true;
+    settings.directory = tmpdir;
+    // single block per file
+    settings.fileSize = 4096 + JournalFile::block_size(1);
+    settings.rotationInterval = 10;
+    settings.keep = 10;
+
+    std::vector<std::string> columns = {"x"};
+    float value = 1;
+
+    for (uint32_t r = 0; r < 3 * JournalFile::BLOCK_ROWS; r++) {
+        Journal::instance().append("test", columns, 1700000000 + r / 1000.0, &value);
+    }
+    Journal::instance().close();
+
+    auto files = list_directory(tmpdir);
+    std::sort(files.begin(), files.end());
+    REQUIRE(files.size() == 3);
+    REQUIRE(files[0] == "test_20231114T221320.journal");
+    REQUIRE(files[1] == "test_20231114T221320_001.journal");
+    REQUIRE(files[2] == "test_20231114T221320_002.journal");
+
+    for (auto &f : files) {
+        JournalReader reader(std::string(tmpdir) + "/" + f);
+        REQUIRE(reader.rows() == JournalFile::BLOCK_ROWS);
+        unlink((std::string(tmpdir) + "/" + f).c_str());
+    }
+
+    settings.enabled = false;
+    rmdir(tmpdir);
+}
+
+TEST_CASE("Journal rotation with spare files created on the journal thread", "[Journal]") {
+    char tmpdir[] = "/tmp/M1M3TS_journal_XXXXXX";
+    REQUIRE(mkdtemp(tmpdir) != nullptr);
+
+    auto &settings = Settings::Journal::instance();
+    settings.enabled = true;
+    settings.directory = tmpdir;
+    settings.fileSize = 1024 * 1024;
+    settings.rotationInterval = 10;
+    settings.keep = 2;
+
+    auto &journal = Journal::instance();
+    journal.start();
+
+    std::vector<std::string> columns = {"x"};
+    float value = 1;
+
+    for (int t = 0; t < 35; t++) {
+        journal.append("test", columns, 1700000000 + t, &value);
+        // spare is created before the next rotation
+        REQUIRE(journal.flush(std::chrono::seconds(5)));
+    }
+
+    journal.stop();
+    journal.close();
+
+    // spare files are removed on close
+    auto files = list_directory(tmpdir);
+    std::sort(files.begin(), files.end());
+    REQUIRE(files.size() == 2);
+    REQUIRE(files[0] == "test_20231114T221340.journal");
+    REQUIRE(files[1] == "test_20231114T221350.journal");
+
+    JournalReader reader(std::string(tmpdir) + "/" + files[1]);
+    REQUIRE(reader.rows() == 5);
+    REQUIRE(reader.timestamp(0) == 1700000030);
+
+    settings.enabled = false;
+
+    for (auto &f : files) {
+        unlink((std::string(tmpdir) + "/" + f).c_str());
+    }
+    REQUIRE(rmdir(tmpdir) == 0);
+}
+
+TEST_CASE("Journal retries failed open only after the retry interval", "[Journal]") {
+    char tmpdir[] = "/tmp/M1M3TS_journal_XXXXXX";
+    REQUIRE(mkdtemp(tmpdir) != nullptr);
+
+    // journal directory is a regular file, so the journal cannot be opened
+    std::string directory = std::string(tmpdir) + "/journal";
+    FILE *blocker = fopen(directory.c_str(), "w");
+    REQUIRE(blocker != nullptr);
+    fclose(blocker);
+
+    auto &settings = Settings::Journal::instance();
+    settings.enabled = true;
+    settings.directory = directory;
+    settings.fileSize = 1024 * 1024;
+    settings.rotationInterval = 100;
+    settings.keep = 2;
+
+    auto &journal = Journal::instance();
+    journal.start();
+
+    std::vector<std::string> columns = {"x"};
+    float value = 1;
+
+    journal.append("test", columns, 1700000000, &value);
+    REQUIRE(journal.flush(std::chrono::seconds(5)));
+
+    REQUIRE(unlink(directory.c_str()) == 0);
+    REQUIRE(mkdir(directory.c_str(), 0755) == 0);
+
+    // nothing is attempted - not even the spare - till the retry interval passes
+    for (int t = 1; t < 60; t++) {
+        journal.append("test", columns, 1700000000 + t, &value);
+    }
+    REQUIRE(journal.flush(std::chrono::seconds(5)));
+    REQUIRE(access((directory + "/.test.spare").c_str(), F_OK) != 0);
+    REQUIRE(list_directory(directory).empty());
+
+    journal.append("test", columns, 1700000060, &value);
+    REQUIRE(journal.flush(std::chrono::seconds(5)));
+
+    journal.stop();
+    journal.close();
+
+    auto files = list_directory(directory);
+    REQUIRE(files == std::vector<std::string>({"test_20231114T221420.journal"}));
+
+    settings.enabled = false;
+
+    for (auto &f : files) {
+        unlink((directory + "/" + f).c_str());
+    }
+    REQUIRE(rmdir(directory.c_str()) == 0);
+    REQUIRE(rmdir(tmpdir) == 0);
+}
@@ -0,0 +1,264 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests command to telemetry latency in the simulator.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <cRIO/ControllerThread.h>
+#include <cRIO/Settings/Path.h>
+#include <cRIO/Task.h>
+
+#include "Commands/SAL.h"
+#include "Commands/Update.h"
+#include "Events/SummaryState.h"
+#include "IFPGA.h"
+#include "LatencyProbe.h"
+#include "PublishQueue.h"
+#include "SALThermalILC.h"
+#include "Settings/Controller.h"
+#include "TSApplication.h"
+#include "TSPublisher.h"
+#include "Telemetry/MixingValve.h"
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+TEST_CASE("Latency probe", "[LatencyProbe]") {
+    auto &probe = LatencyProbe::instance();
+
+    probe.disarm();
+    probe.mark(LatencyProbe::COMMAND_ACCEPTED, 1);
+    probe.arm(1);
+    REQUIRE(std::isnan(probe.since_accepted(LatencyProbe::COMMAND_ACCEPTED)));
+
+    // marks of other commands and untraced threads are discarded
+    probe.mark(LatencyProbe::COMMAND_ACCEPTED, 2);
+    probe.mark(LatencyProbe::COMMAND_ACCEPTED);
+    REQUIRE(std::isnan(probe.since_accepted(LatencyProbe::COMMAND_ACCEPTED)));
+    REQUIRE(probe.discarded() == 2);
+
+    probe.mark(LatencyProbe::COMMAND_ACCEPTED, 1);
+    REQUIRE(probe.since_accepted(LatencyProbe::COMMAND_ACCEPTED) == 0);
+    REQUIRE(std::isnan(probe.since_accepted(LatencyProbe::FIFO_WRITE)));
+    REQUIRE(probe.wait(LatencyProbe::FIFO_WRITE, 1ms) == false);
+
+    int32_t writer_trace = 0;
+    std::thread writer([&probe, &writer_trace]() {
+        std::this_thread::sleep_for(2ms);
+        probe.mark(LatencyProbe::FIFO_WRITE);
+        LatencyProbe::Scope scope(1);
+        writer_trace = LatencyProbe::current();
+        probe.mark(LatencyProbe::FIFO_WRITE);
+    });
+    REQUIRE(probe.wait(LatencyProbe::FIFO_WRITE, 1s));
+    writer.join();
+
+    REQUIRE(writer_trace == 1);
+    REQUIRE(LatencyProbe::current() == 0);
+    REQUIRE(probe.discarded() == 3);
+    REQUIRE(probe.since_accepted(LatencyProbe::DEQUEUED) >= 2000);
+
+    float first = probe.since_accepted(LatencyProbe::FIFO_WRITE);
+    REQUIRE(first >= 2000);
+
+    // only the first occurrence is recorded
+    std::this_thread::sleep_for(1ms);
+    probe.mark(LatencyProbe::FIFO_WRITE, 1);
+    REQUIRE(probe.since_accepted(LatencyProbe::FIFO_WRITE) == first);
+
+    probe.disarm();
+}
+
+/**
+ * Polls the mixing valve, as Commands::Update does, without Update's rate limit.
+ */
+class PollMixingValve : public LSST::cRIO::Task {
+public:
+    LSST::cRIO::task_return_t run() override {
+        Telemetry::MixingValve::instance().sendPosition(IFPGA::get().getMixingValvePosition());
+        return Task::DONT_RESCHEDULE;
+    }
+};
+
+/**
+ * Runs task as part of the traced command, so its marks aren't discarded.
+ */
+class TracedTask : public LSST::cRIO::Task {
+public:
+    TracedTask(std::shared_ptr<LSST::cRIO::Task> task, int32_t trace) : _task(task), _trace(trace) {}
+
+    LSST::cRIO::task_return_t run() override {
+        LatencyProbe::Scope scope(_trace);
+        _task->run();
+        return Task::DONT_RESCHEDULE;
+    }
+
+private:
+    std::shared_ptr<LSST::cRIO::Task> _task;
+    int32_t _trace;
+};
+
+/**
+ * Latency distribution of all stages of a command.
+ */
+class StageLatencies {
+public:
+    StageLatencies(const std::string &name) : _name(name) {}
+
+    void record() {
+        auto &probe = LatencyProbe::instance();
+        _discarded += probe.discarded();
+        for (int s = 0; s < LatencyProbe::STAGES; s++) {
+            float t = probe.since_accepted(static_cast<LatencyProbe::Stage>(s));
+            if (std::isnan(t)) {
+                _missing[s]++;
+            } else {
+                _latencies[s].push_back(t);
+            }
+        }
+    }
+
+    void print() {
+        std::cout << fmt::format("{} - microseconds since command acceptance", _name) << std::endl
+                  << fmt::format("  {:<10s} {:>6s} {:>9s} {:>9s} {:>9s} {:>9s} {:>9s}", "Stage", "N",
+                                 "p50", "p90", "p99", "max", "missing")
+                  << std::endl;
+        for (int s = 1; s < LatencyProbe::STAGES; s++) {
+            auto &l = _latencies[s];
+            std::sort(l.begin(), l.end());
+            auto percentile = [&l](float p) { return l.empty() ? NAN : l[std::lround(p * (l.size() - 1))]; };
+            std::cout << fmt::format("  {:<10s} {:>6d} {:>9.0f} {:>9.0f} {:>9.0f} {:>9.0f} {:>9d}",
+                                     LatencyProbe::stage_name(static_cast<LatencyProbe::Stage>(s)), l.size(),
+                                     percentile(0.5), percentile(0.9), percentile(0.99),
+                                     l.empty() ? NAN : l.back(), _missing[s])
+                      << std::endl;
+        }
+        std::cout << fmt::format("  discarded {} marks of untraced tasks and other commands", _discarded)
+                  << std::endl;
+    }
+
+private:
+    std::string _name;
+    uint64_t _discarded = 0;
+    std::vector<float> _latencies[LatencyProbe::STAGES];
+    int _missing[LatencyProbe::STAGES] = {0};
+};
+
+/**
+ * Drives a command through the controller thread, as TSSubscriber does. Only
+ * marks tagged with the command ID are recorded - periodic control tasks keep
+ * writing to the FIFO and publishing in between.
+ *
+ * @param command_id traced command ID
+ * @param command command to enqueue
+ * @param follow_up task enqueued after command, simulating outer loop poll. Runs as part of the command
+ * trace
+ * @param last stage expected to be reached
+ */
+static void trace(int32_t command_id, std::shared_ptr<LSST::cRIO::Task> command,
+                  std::shared_ptr<LSST::cRIO::Task> follow_up, LatencyProbe::Stage last) {
+    auto &probe = LatencyProbe::instance();
+    probe.arm(command_id);
+    probe.mark(LatencyProbe::COMMAND_ACCEPTED, command_id);
+    LSST::cRIO::ControllerThread::instance().enqueue(command);
+    if (follow_up != nullptr) {
+        LSST::cRIO::ControllerThread::instance().enqueue(std::make_shared<TracedTask>(follow_up, command_id));
+    }
+    probe.wait(last, 100ms);
+    probe.disarm();
+}
+
+TEST_CASE("Closed loop latency", "[.][benchmark][latency]") {
+    const char *env_iterations = getenv("LATENCY_ITERATIONS");
+    int iterations = env_iterations == nullptr ? 1000 : atoi(env_iterations);
+
+    std::shared_ptr<SAL_MTM1M3TS> m1m3TSSAL = std::make_shared<SAL_MTM1M3TS>();
+    TSPublisher::instance().setSAL(m1m3TSSAL);
+    TSApplication::instance().setILC(new SALThermalILC(m1m3TSSAL));
+
+    LSST::cRIO::Settings::Path::setRootPath("data");
+    Settings::Controller::instance().load("_init.yaml");
+
+    PublishQueue::instance().start();
+    LSST::cRIO::ControllerThread::instance().start(500ms);
+
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_StandbyState);
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_DisabledState);
+    Events::SummaryState::set_state(MTM1M3TS::MTM1M3TS_shared_SummaryStates_EnabledState);
+
+    int32_t command_id = 1;
+
+    // fills thermal data, so heaters control has temperatures to act on
+    trace(command_id, std::make_shared<TracedTask>(std::make_shared<Commands::Update>(), command_id),
+          nullptr, LatencyProbe::PUBLISHED);
+    command_id++;
+
+    StageLatencies demand("heaterFanDemand");
+    for (int i = 0; i < iterations; i++) {
+        MTM1M3TS_command_heaterFanDemandC data;
+        for (int f = 0; f < LSST::cRIO::NUM_TS_ILC; f++) {
+            data.heaterPWM[f] = i % 2 ? 10 : 20;
+            data.fanRPM[f] = i % 2 ? 100 : 110;
+        }
+        trace(command_id, std::make_shared<Commands::SAL_heaterFanDemand>(command_id, &data), nullptr,
+              LatencyProbe::PUBLISHED);
+        command_id++;
+        demand.record();
+    }
+
+    StageLatencies valve("setMixingValve");
+    auto poll_valve = std::make_shared<PollMixingValve>();
+    for (int i = 0; i < iterations; i++) {
+        MTM1M3TS_command_setMixingValveC data;
+        data.mixingValveTarget = i % 2 ? 30 : 40;
+        trace(command_id, std::make_shared<Commands::SAL_setMixingValve>(command_id, &data), poll_valve,
+              LatencyProbe::PUBLISHED);
+        command_id++;
+        valve.record();
+    }
+
+    StageLatencies setpoints("applySetpoints");
+    for (int i = 0; i < iterations; i++) {
+        MTM1M3TS_command_applySetpointsC data;
+        data.glycolSetpoint = i % 2 ? 10 : 10.5;
+        data.heatersSetpoint = i % 2 ? 11 : 11.5;
+        trace(command_id, std::make_shared<Commands::SAL_applySetpoints>(command_id, &data), nullptr,
+              LatencyProbe::PUBLISHED);
+        command_id++;
+        setpoints.record();
+    }
+
+    LSST::cRIO::ControllerThread::instance().stop();
+    PublishQueue::instance().stop();
+
+    demand.print();
+    valve.print();
+    setpoints.print();
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests shared memory live state.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include <LiveState.h>
+
+using namespace LSST::M1M3::TS;
+
+TEST_CASE("Write and read live state", "[LiveState]") {
+    std::string name = "/M1M3TS_test_live_" + std::to_string(getpid());
+
+    REQUIRE_THROWS_AS(LiveStateReader(name), std::runtime_error);
+
+    LiveState::instance().open(name);
+
+    LiveStateReader reader(name);
+    CHECK(reader->pid == getpid());
+
+    LiveMixingValve valve;
+    CHECK(reader->mixingValve.version() == 0);
+
+    MTM1M3TS_mixingValveC mixing_valve;
+    mixing_valve.rawValvePosition = 3.5;
+    mixing_valve.valvePosition = 42.0;
+    LiveState::instance().update(mixing_valve);
+
+    CHECK(reader->mixingValve.version() == 1);
+    REQUIRE(reader->mixingValve.try_load(valve, 10));
+    CHECK(valve.rawValvePosition == 3.5);
+    CHECK(valve.valvePosition == 42.0);
+    CHECK(valve.timestamp > 0);
+
+    MTM1M3TS_thermalDataC thermal_data;
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        thermal_data.ilcFault[i] = i == 5;
+        thermal_data.heaterDisabled[i] = false;
+        thermal_data.heaterBreaker[i] = false;
+        thermal_data.fanBreaker[i] = i == 7;
+        thermal_data.differentialTemperature[i] = i * 0.1;
+        thermal_data.fanRPM[i] = i * 10;
+        thermal_data.absoluteTemperature[i] = 20 + i * 0.1;
+    }
+    LiveState::instance().update(thermal_data);
+
+    LiveThermalData thermal;
+    REQUIRE(reader->thermalData.try_load(thermal, 10));
+    CHECK(thermal.status[4] == 0);
+    CHECK(thermal.status[5] == 0x01);
+    CHECK(thermal.status[7] == 0x08);
+    CHECK(thermal.fanRPM[95] == 950);
+    CHECK(thermal.absoluteTemperature[10] == 21.0f);
+
+    CHECK(reader->flowMeter.version() == 0);
+
+    LiveState::instance().close();
+
+    REQUIRE_THROWS_AS(LiveStateReader(name), std::runtime_error);
+
+    // updates after close are ignored
+    LiveState::instance().update(mixing_valve);
+}
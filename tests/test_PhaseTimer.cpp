@@ -0,0 +1,78 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests startup phase timer.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "PhaseTimer.h"
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+TEST_CASE("Sequential and concurrent phases", "[PhaseTimer]") {
+    PhaseTimer timer("Test");
+
+    {
+        PhaseTimer::Phase phase(timer, "first");
+        std::this_thread::sleep_for(20ms);
+    }
+
+    std::thread concurrent([&timer]() {
+        PhaseTimer::Phase phase(timer, "concurrent");
+        std::this_thread::sleep_for(30ms);
+    });
+
+    timer.start("second");
+    std::this_thread::sleep_for(10ms);
+    timer.stop("second");
+
+    timer.start("unfinished");
+
+    concurrent.join();
+
+    // stop of not started phase is ignored
+    timer.stop("not started");
+
+    auto records = timer.records();
+    REQUIRE(records.size() == 4);
+
+    REQUIRE(records[0].phase == "first");
+    REQUIRE(records[0].finished);
+    REQUIRE(records[0].duration >= 20ms);
+
+    auto second = records[1].phase == "second" ? records[1] : records[2];
+    auto concurrent_r = records[1].phase == "concurrent" ? records[1] : records[2];
+
+    REQUIRE(second.phase == "second");
+    REQUIRE(concurrent_r.phase == "concurrent");
+    REQUIRE(second.offset >= records[0].duration);
+    REQUIRE(concurrent_r.duration >= 30ms);
+    // phases overlapped
+    REQUIRE(concurrent_r.offset < second.offset + second.duration);
+
+    REQUIRE(records[3].phase == "unfinished");
+    REQUIRE(records[3].finished == false);
+
+    REQUIRE(timer.elapsed() >= 50ms);
+    REQUIRE_NOTHROW(timer.report());
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests SAL publish queue.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <PublishQueue.h>
+
+using namespace LSST::M1M3::TS;
+using namespace std::chrono_literals;
+
+struct TestSample {
+    int producer;
+    int counter;
+};
+
+static std::vector<TestSample> published;
+
+struct ThrowingSample {
+    int counter;
+    bool raise;
+};
+
+static std::vector<int> published_throwing;
+
+namespace LSST {
+namespace M1M3 {
+namespace TS {
+
+template <>
+struct PublishTopic<TestSample> {
+    static constexpr const char *name = "testSample";
+    static salReturn put(SAL_MTM1M3TS *, TestSample *data) {
+        published.push_back(*data);
+        return SAL__OK;
+    }
+};
+
+template <>
+struct PublishTopic<ThrowingSample> {
+    static constexpr const char *name = "throwingSample";
+    static salReturn put(SAL_MTM1M3TS *, ThrowingSample *data) {
+        if (data->raise) {
+            throw std::runtime_error("cannot publish");
+        }
+        published_throwing.push_back(data->counter);
+        return SAL__OK;
+    }
+};
+
+}  // namespace TS
+}  // namespace M1M3
+}  // namespace LSST
+
+TEST_CASE("Drop oldest, publish and flush", "[PublishQueue]") {
+    auto &queue = PublishQueue::instance();
+
+    for (int i = 0; i < 10; i++) {
+        queue.enqueue(TestSample{0, i});
+    }
+
+    REQUIRE(queue.depth() == PublishQueue::DEPTH);
+
+    auto stats = queue.get_statistics();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].depth == PublishQueue::DEPTH);
+    REQUIRE(stats[0].high_water == PublishQueue::DEPTH);
+    REQUIRE(stats[0].dropped == 2);
+    REQUIRE(stats[0].published == 0);
+
+    queue.start();
+
+    REQUIRE(queue.flush(2s));
+    REQUIRE(queue.depth() == 0);
+
+    REQUIRE(published.size() == PublishQueue::DEPTH);
+    for (size_t i = 0; i < PublishQueue::DEPTH; i++) {
+        REQUIRE(published[i].counter == static_cast<int>(i + 2));
+    }
+
+    published.clear();
+
+    // producers shall keep per-producer order; some samples can be dropped
+    auto producer = [&queue](int id) {
+        for (int i = 0; i < 1000; i++) {
+            queue.enqueue(TestSample{id, i});
+        }
+    };
+
+    std::thread p1(producer, 1);
+    std::thread p2(producer, 2);
+    p1.join();
+    p2.join();
+
+    // samples left in the queue are published on stop
+    queue.stop();
+
+    REQUIRE(queue.depth() == 0);
+
+    stats = queue.get_statistics();
+    REQUIRE(stats[0].published + stats[0].dropped == 2010);
+    REQUIRE(stats[0].failed == 0);
+    REQUIRE(published.size() == stats[0].published - PublishQueue::DEPTH);
+
+    int last[3] = {-1, -1, -1};
+    for (auto s : published) {
+        REQUIRE(s.counter > last[s.producer]);
+        last[s.producer] = s.counter;
+    }
+    // the newest sample is never dropped
+    REQUIRE(published.back().counter == 999);
+}
+
+TEST_CASE("Publisher survives throwing topic", "[PublishQueue]") {
+    auto &queue = PublishQueue::instance();
+
+    auto throwing_statistics = [&queue]() {
+        for (auto s : queue.get_statistics()) {
+            if (std::string(s.name) == "throwingSample") {
+                return s;
+            }
+        }
+        FAIL("throwingSample statistics not found");
+        return PublishQueue::TopicStatistics{};
+    };
+
+    queue.enqueue(ThrowingSample{1, false});
+    queue.enqueue(ThrowingSample{2, true});
+    queue.enqueue(ThrowingSample{3, false});
+
+    queue.start();
+
+    REQUIRE(queue.flush(2s));
+
+    auto stats = throwing_statistics();
+    REQUIRE(stats.published == 2);
+    REQUIRE(stats.failed == 1);
+    REQUIRE(published_throwing == std::vector<int>{1, 3});
+
+    // publisher thread keeps running after the exception
+    queue.enqueue(ThrowingSample{4, true});
+    queue.enqueue(ThrowingSample{5, false});
+
+    REQUIRE(queue.flush(2s));
+
+    queue.stop();
+
+    stats = throwing_statistics();
+    REQUIRE(stats.depth == 0);
+    REQUIRE(stats.published == 3);
+    REQUIRE(stats.failed == 2);
+    REQUIRE(published_throwing == std::vector<int>{1, 3, 5});
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests in-process SAL stand-in.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+#include <SAL_MTM1M3TS.h>
+
+#include "TSSubscriber.h"
+
+using namespace std::chrono_literals;
+using namespace LSST::M1M3::TS;
+
+TEST_CASE("SAL stand-in topics", "[SALStandIn]") {
+    SAL_MTM1M3TS sal;
+
+    MTM1M3TS_mixingValveC valve;
+    CHECK(sal.getSample_mixingValve(&valve) == SAL__NO_UPDATES);
+
+    for (int i = 0; i < 3; i++) {
+        valve.timestamp = i;
+        valve.valvePosition = 10 * i;
+        REQUIRE(sal.putSample_mixingValve(&valve) == SAL__OK);
+    }
+
+    auto &topic = sal.captured<MTM1M3TS_mixingValveC>();
+    CHECK(topic.count() == 3);
+
+    MTM1M3TS_mixingValveC last;
+    REQUIRE(topic.last(last));
+    CHECK(last.valvePosition == 20);
+    CHECK(last.private_seqNum == 3);
+
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(sal.getSample_mixingValve(&valve) == SAL__OK);
+        CHECK(valve.timestamp == i);
+    }
+    CHECK(sal.getSample_mixingValve(&valve) == SAL__NO_UPDATES);
+
+    sal.setCaptureDepth(2);
+    for (int i = 3; i < 6; i++) {
+        valve.timestamp = i;
+        sal.putSample_mixingValve(&valve);
+    }
+    CHECK(topic.count() == 6);
+    auto captured = topic.captured();
+    REQUIRE(captured.size() == 2);
+    CHECK(captured[0].timestamp == 4);
+    CHECK(captured[1].timestamp == 5);
+
+    MTM1M3TS_logevent_appliedSetpointsC setpoints;
+    setpoints.glycolSetpoint = 12.5;
+    setpoints.heatersSetpoint = 13.5;
+    sal.logEvent_appliedSetpoints(&setpoints, 0);
+    REQUIRE(sal.getEvent_appliedSetpoints(&setpoints) == SAL__OK);
+    CHECK(setpoints.heatersSetpoint == 13.5);
+
+    auto statistics = sal.statistics();
+    REQUIRE(statistics.size() == 2);
+    CHECK(statistics[0].name == "mixingValve");
+    CHECK(statistics[0].published == 6);
+    CHECK(statistics[1].name == "logevent_appliedSetpoints");
+    CHECK(statistics[1].published == 1);
+}
+
+TEST_CASE("SAL stand-in commands", "[SALStandIn]") {
+    SAL_MTM1M3TS sal;
+
+    MTM1M3TS_command_setMixingValveC data;
+    CHECK(sal.acceptCommand_setMixingValve(&data) == 0);
+
+    data.mixingValveTarget = 20;
+    int32_t first = sal.issueCommand_setMixingValve(&data);
+    data.mixingValveTarget = 30;
+    int32_t second = sal.issueCommand_setMixingValve(&data);
+    CHECK(first > 0);
+    CHECK(second > first);
+
+    REQUIRE(sal.acceptCommand_setMixingValve(&data) == first);
+    CHECK(data.mixingValveTarget == 20);
+    sal.ackCommand_setMixingValve(first, SAL__CMD_INPROGRESS, 0, (char *)"In progress", 10);
+    CHECK(sal.waitForCompletion_setMixingValve(first, 0) == SAL__CMD_TIMEOUT);
+    sal.ackCommand_setMixingValve(first, SAL__CMD_COMPLETE, 0, (char *)"Complete");
+    CHECK(sal.waitForCompletion_setMixingValve(first, 1) == SAL__CMD_COMPLETE);
+
+    REQUIRE(sal.acceptCommand_setMixingValve(&data) == second);
+    CHECK(data.mixingValveTarget == 30);
+    sal.ackCommand_setMixingValve(second, SAL__CMD_FAILED, 0, (char *)"Not allowed");
+    CHECK(sal.waitForCompletion_setMixingValve(second, 1) == SAL__CMD_FAILED);
+    CHECK(sal.commands<MTM1M3TS_command_setMixingValveC>().result(second) == "Not allowed");
+
+    CHECK(sal.ackCommand_setMixingValve(second + 1, SAL__CMD_COMPLETE, 0, (char *)"Complete") == SAL__ERR);
+
+    auto &queue = sal.commands<MTM1M3TS_command_setMixingValveC>();
+    CHECK(queue.issued() == 2);
+    CHECK(queue.accepted() == 2);
+    CHECK(queue.acked() == 3);
+}
+
+TEST_CASE("SAL stand-in subscriber", "[SALStandIn]") {
+    auto sal = std::make_shared<SAL_MTM1M3TS>();
+    auto level = spdlog::get_level();
+
+    TSSubscriber subscriber(sal);
+    subscriber.start();
+
+    MTM1M3TS_command_setLogLevelC data;
+    data.level = 20;
+    int32_t id = sal->issueCommand_setLogLevel(&data);
+    CHECK(sal->waitForCompletion_setLogLevel(id, 2) == SAL__CMD_COMPLETE);
+
+    subscriber.stop();
+
+    MTM1M3TS_logevent_logLevelC log_level;
+    REQUIRE(sal->getEvent_logLevel(&log_level) == SAL__OK);
+    CHECK(log_level.level == 20);
+    CHECK(spdlog::get_level() == spdlog::level::info);
+
+    spdlog::set_level(level);
+}
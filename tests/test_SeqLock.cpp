@@ -0,0 +1,89 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests sequence lock.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include <SeqLock.h>
+
+using namespace LSST::M1M3::TS;
+
+struct TestValue {
+    uint64_t counter;
+    float values[7];
+};
+
+TEST_CASE("Store and load", "[SeqLock]") {
+    SeqLock<TestValue> lock;
+
+    REQUIRE(lock.version() == 0);
+
+    TestValue v = {1, {1, 2, 3, 4, 5, 6, 7}};
+    lock.store(v);
+
+    REQUIRE(lock.version() == 1);
+
+    auto r = lock.load();
+    REQUIRE(r.counter == 1);
+    for (int i = 0; i < 7; i++) {
+        REQUIRE(r.values[i] == i + 1);
+    }
+}
+
+TEST_CASE("Concurrent readers see consistent values", "[SeqLock]") {
+    TestValue initial = {0, {0, 1, 2, 3, 4, 5, 6}};
+    SeqLock<TestValue> lock(initial);
+    std::atomic<bool> run(true);
+    std::atomic<int> inconsistent(0);
+
+    auto reader = [&]() {
+        while (run) {
+            auto r = lock.load();
+            for (int i = 0; i < 7; i++) {
+                if (r.values[i] != static_cast<float>(r.counter + i)) {
+                    inconsistent++;
+                }
+            }
+        }
+    };
+
+    std::thread r1(reader);
+    std::thread r2(reader);
+
+    for (uint64_t c = 1; c <= 100000; c++) {
+        TestValue v;
+        v.counter = c;
+        for (int i = 0; i < 7; i++) {
+            v.values[i] = c + i;
+        }
+        lock.store(v);
+    }
+
+    run = false;
+    r1.join();
+    r2.join();
+
+    REQUIRE(inconsistent == 0);
+    REQUIRE(lock.version() == 100001);
+}
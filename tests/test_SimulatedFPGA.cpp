@@ -20,6 +20,7 @@
  * this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <SimulatedFPGA.h>
@@ -92,3 +93,47 @@ TEST_CASE("Test simulated FPGA responses", "[SimulatedFPGA]") {
 
     simulated.ilcCommands(testILC, 10);
 }
+
+/**
+ * Accepts responses from any ILC.
+ */
+class BenchmarkILC : public TestILC {
+public:
+    BenchmarkILC() : ILC::ILCBusList::ILCBusList(1), TestILC() {}
+
+    int responses = 0;
+
+protected:
+    void processServerStatus(uint8_t address, uint8_t mode, uint16_t status, uint16_t faults) override {
+        responses++;
+    }
+
+    void processThermalStatus(uint8_t address, uint8_t status, float differentialTemperature, uint8_t fanRPM,
+                              float absoluteTemperature) override {
+        responses++;
+    }
+};
+
+TEST_CASE("Simulated FPGA benchmark", "[.][benchmark]") {
+    SimulatedFPGA simulated;
+    BenchmarkILC ilc;
+
+    BENCHMARK("Thermal status - all FCUs") {
+        ilc.clear();
+        for (int address = 1; address <= NUM_TS_ILC; address++) {
+            ilc.reportThermalStatus(address);
+        }
+        simulated.ilcCommands(ilc, 10);
+        return ilc.responses;
+    };
+
+    BENCHMARK("Server and thermal status - all FCUs") {
+        ilc.clear();
+        for (int address = 1; address <= NUM_TS_ILC; address++) {
+            ilc.reportServerStatus(address);
+            ilc.reportThermalStatus(address);
+        }
+        simulated.ilcCommands(ilc, 10);
+        return ilc.responses;
+    };
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests telemetry history.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+#include <Telemetry/HistoryServer.h>
+#include <Telemetry/TelemetryHistory.h>
+
+using namespace LSST::M1M3::TS::Telemetry;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Column ring buffer", "[TelemetryHistory]") {
+    HistoryTable table("test");
+    table.add_column("a[0]");
+    table.add_column("a[1]");
+    table.add_column("b");
+    table.resize(4);
+
+    for (int i = 0; i < 6; i++) {
+        auto row = table.staging();
+        row[0] = i;
+        row[1] = -i;
+        row[2] = i == 5 ? NAN : 10 * i;
+        table.append(100 + i);
+    }
+
+    REQUIRE(table.size() == 4);
+
+    std::vector<ColumnStatistics> stats;
+
+    SECTION("Whole table") {
+        table.query(0, "test", stats);
+        REQUIRE(stats.size() == 3);
+
+        REQUIRE(stats[0].name == "test.a[0]");
+        REQUIRE(stats[0].count == 4);
+        REQUIRE(stats[0].min == 2);
+        REQUIRE(stats[0].max == 5);
+        REQUIRE_THAT(stats[0].mean, WithinAbs(3.5, 1e-5));
+
+        REQUIRE(stats[1].min == -5);
+        REQUIRE(stats[1].max == -2);
+
+        // NaN is skipped
+        REQUIRE(stats[2].count == 3);
+        REQUIRE(stats[2].min == 20);
+        REQUIRE(stats[2].max == 40);
+        REQUIRE_THAT(stats[2].mean, WithinAbs(30, 1e-5));
+    }
+
+    SECTION("Window") {
+        table.query(104, "test.a[0]", stats);
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats[0].count == 2);
+        REQUIRE(stats[0].min == 4);
+        REQUIRE(stats[0].max == 5);
+    }
+
+    SECTION("Column without index") {
+        table.query(0, "test.a", stats);
+        REQUIRE(stats.size() == 2);
+        REQUIRE(stats[1].name == "test.a[1]");
+    }
+
+    SECTION("No match") {
+        table.query(0, "test.a[", stats);
+        table.query(0, "tes", stats);
+        table.query(0, "other.a", stats);
+        REQUIRE(stats.empty());
+    }
+
+    SECTION("Empty window") {
+        table.query(200, "test.b", stats);
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats[0].count == 0);
+        REQUIRE(std::isnan(stats[0].mean));
+    }
+}
+
+TEST_CASE("Telemetry history query", "[TelemetryHistory]") {
+    MTM1M3TS_mixingValveC valve;
+    for (int i = 0; i < 5; i++) {
+        valve.rawValvePosition = i;
+        valve.valvePosition = 20 * i;
+        TelemetryHistory::instance().record(valve);
+    }
+
+    auto stats = TelemetryHistory::instance().query(60, "mixingValve.valvePosition");
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].count == 5);
+    REQUIRE(stats[0].min == 0);
+    REQUIRE(stats[0].max == 80);
+    REQUIRE_THAT(stats[0].mean, WithinAbs(40, 1e-5));
+
+    REQUIRE(TelemetryHistory::instance().query(60, "thermalData.fanRPM").size() == 96);
+
+    REQUIRE(HistoryServer::process("60 mixingValve.rawValvePosition\n") ==
+            "mixingValve.rawValvePosition 5 0.0000 4.0000 2.0000\n");
+    REQUIRE(HistoryServer::process("abc mixingValve\n").compare(0, 6, "ERROR ") == 0);
+    REQUIRE(HistoryServer::process("60 unknown\n") == "ERROR no column matches unknown\n");
+}
+
+TEST_CASE("Thermal summary history", "[TelemetryHistory]") {
+    ThermalSummary summary;
+    summary.window = 10;
+    for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+        for (int q = 0; q < ThermalSummary::QUANTITIES; q++) {
+            for (int s = 0; s < ThermalSummary::STATISTICS; s++) {
+                summary.values[q][s][i] = 100 * q + 10 * s + i * 0.01;
+            }
+        }
+    }
+    TelemetryHistory::instance().record(summary);
+
+    auto stats = TelemetryHistory::instance().query(60, "thermalDataSummary10s.fanRPM.mean[3]");
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].count == 1);
+    REQUIRE_THAT(stats[0].mean, WithinAbs(220.03, 1e-4));
+
+    REQUIRE(TelemetryHistory::instance().query(60, "thermalDataSummary10s.absoluteTemperature.stddev").size() ==
+            96);
+}
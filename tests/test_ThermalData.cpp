@@ -0,0 +1,65 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests FCU thermal data telemetry.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+#include <Telemetry/ThermalData.h>
+
+using namespace LSST::M1M3::TS;
+using namespace LSST::M1M3::TS::Telemetry;
+
+TEST_CASE("Thermal data update", "[ThermalData]") {
+    auto &thermal_data = ThermalData::instance();
+    thermal_data.reset();
+
+    REQUIRE(std::isnan(thermal_data.get_absoluteTemperature()[4]));
+    REQUIRE(thermal_data.is_heater_disabled(4));
+
+    auto before = std::chrono::steady_clock::now();
+
+    thermal_data.update(5, 0x00, 1.5, 80, 12.25);
+    REQUIRE(thermal_data.get_absoluteTemperature()[4] == 12.25);
+    REQUIRE(thermal_data.is_heater_disabled(4) == false);
+    REQUIRE(thermal_data.get_received(4) >= before);
+
+    thermal_data.update(5, 0x02, 1.5, 80, 12.5);
+    REQUIRE(thermal_data.get_absoluteTemperature()[4] == 12.5);
+    REQUIRE(thermal_data.is_heater_disabled(4));
+
+    thermal_data.reset();
+    REQUIRE(std::isnan(thermal_data.get_absoluteTemperature()[4]));
+    REQUIRE(thermal_data.get_received(4) >= before);
+}
+
+TEST_CASE("Thermal data benchmark", "[.][benchmark]") {
+    auto &thermal_data = ThermalData::instance();
+
+    BENCHMARK("ThermalData::update - all FCUs") {
+        for (int i = 0; i < LSST::cRIO::NUM_TS_ILC; i++) {
+            thermal_data.update(i + 1, 0x00, 1.5 + i * 0.01, 80, 12 + i * 0.01);
+        }
+        return thermal_data.get_absoluteTemperature()[95];
+    };
+}
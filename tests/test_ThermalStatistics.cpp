@@ -0,0 +1,98 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests windowed thermal statistics.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+#include <PublishQueue.h>
+#include <Settings/ThermalStatistics.h>
+#include <Telemetry/ThermalStatistics.h>
+
+using namespace LSST::M1M3::TS;
+using namespace LSST::M1M3::TS::Telemetry;
+using namespace std::chrono_literals;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Welford accumulator", "[ThermalStatistics]") {
+    Welford acc;
+    acc.reset();
+
+    REQUIRE(acc.count == 0);
+    REQUIRE(std::isnan(acc.stddev()));
+
+    for (float v : {2.0f, 4.0f, 4.0f, 4.0f, NAN, 5.0f, 5.0f, 7.0f, 9.0f}) {
+        acc.add(v);
+    }
+
+    REQUIRE(acc.count == 8);
+    REQUIRE(acc.min == 2);
+    REQUIRE(acc.max == 9);
+    REQUIRE_THAT(acc.mean, WithinAbs(5, 1e-9));
+    REQUIRE_THAT(acc.stddev(), WithinAbs(2.13809, 1e-5));
+}
+
+TEST_CASE("Windowed summaries", "[ThermalStatistics]") {
+    Settings::ThermalStatistics::instance().windows = {1, 3};
+
+    auto &stats = ThermalStatistics::instance();
+    auto start = std::chrono::steady_clock::now();
+
+    // first tick configures windows
+    REQUIRE(stats.tick(start) == 0);
+
+    for (int s = 0; s < 6; s++) {
+        auto now = start + s * 500ms;
+        stats.update(0, 20 + s, 0.1 * s, 1000);
+        stats.update(95, NAN, NAN, 500);
+        int closed = stats.tick(now + 1ms);
+        if (s == 2 || s == 4) {
+            REQUIRE(closed == 1);
+        } else {
+            REQUIRE(closed == 0);
+        }
+    }
+
+    auto &summary = stats.last(0);
+    REQUIRE(summary.window == 1);
+    REQUIRE(summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::MIN][0] == 23);
+    REQUIRE(summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::MAX][0] == 24);
+    REQUIRE_THAT(summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::MEAN][0],
+                 WithinAbs(23.5, 1e-5));
+    REQUIRE_THAT(summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::STDDEV][0],
+                 WithinAbs(0.70711, 1e-5));
+    REQUIRE(summary.values[ThermalSummary::FAN_RPM][ThermalSummary::MEAN][95] == 500);
+    REQUIRE(std::isnan(summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::MEAN][95]));
+    REQUIRE(std::isnan(summary.values[ThermalSummary::FAN_RPM][ThermalSummary::MEAN][50]));
+
+    REQUIRE(stats.tick(start + 3s + 1ms) == 2);
+    auto &long_summary = stats.last(1);
+    REQUIRE(long_summary.window == 3);
+    REQUIRE(long_summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::MIN][0] == 20);
+    REQUIRE(long_summary.values[ThermalSummary::ABSOLUTE_TEMPERATURE][ThermalSummary::MAX][0] == 25);
+    REQUIRE_THAT(long_summary.values[ThermalSummary::DIFFERENTIAL_TEMPERATURE][ThermalSummary::MEAN][0],
+                 WithinAbs(0.25, 1e-5));
+
+    // summaries are queued for publishing
+    REQUIRE(PublishQueue::instance().depth() == 4);
+}
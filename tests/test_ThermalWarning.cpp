@@ -0,0 +1,84 @@
+/*
+ * This file is part of M1M3 TS test suite. Tests thermal warning flag masks.
+ *
+ * Developed for the Vera C. Rubin Observatory Telescope & Site Software
+ * Systems. This product includes software developed by the Vera C.Rubin
+ * Observatory Project (https://www.lsst.org). See the COPYRIGHT file at the
+ * top-level directory of this distribution for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cRIO/ThermalILC.h>
+
+#include "Events/ThermalWarning.h"
+#include "TSPublisher.h"
+
+using namespace LSST::M1M3::TS::Events;
+
+TEST_CASE("Flag mask", "[ThermalWarning]") {
+    FlagMask mask;
+
+    REQUIRE(mask.any() == false);
+    REQUIRE(mask.count() == 0);
+
+    REQUIRE(mask.set(0, true) == true);
+    REQUIRE(mask.set(0, true) == false);
+    REQUIRE(mask.set(95, true) == true);
+    REQUIRE(mask.set(64, true) == true);
+
+    REQUIRE(mask.any() == true);
+    REQUIRE(mask.count() == 3);
+    REQUIRE(mask.test(0));
+    REQUIRE(mask.test(64));
+    REQUIRE(mask.test(95));
+    REQUIRE_FALSE(mask.test(1));
+    REQUIRE(mask.changes == 3);
+
+    REQUIRE(mask.set(64, false) == true);
+    REQUIRE(mask.set(64, false) == false);
+    REQUIRE(mask.count() == 2);
+    REQUIRE(mask.changes == 4);
+
+    mask.set(0, false);
+    mask.set(95, false);
+    REQUIRE(mask.any() == false);
+    REQUIRE(mask.changes == 6);
+}
+
+TEST_CASE("Thermal warning benchmark", "[.][benchmark]") {
+    std::shared_ptr<SAL_MTM1M3TS> m1m3TSSAL = std::make_shared<SAL_MTM1M3TS>();
+    LSST::M1M3::TS::TSPublisher::instance().setSAL(m1m3TSSAL);
+
+    auto &warning = ThermalWarning::instance();
+
+    BENCHMARK("Update all FCUs, no change") {
+        for (int address = 1; address <= LSST::cRIO::NUM_TS_ILC; address++) {
+            warning.update(address, 2, 0, 0);
+        }
+        warning.send();
+    };
+
+    int cycle = 0;
+    BENCHMARK("Update all FCUs, one FCU toggles fault and sends") {
+        cycle++;
+        for (int address = 1; address <= LSST::cRIO::NUM_TS_ILC; address++) {
+            warning.update(address, 2, address == 5 && (cycle & 1) ? ILC::Status::MinorFault : 0, 0);
+        }
+        warning.send();
+    };
+}